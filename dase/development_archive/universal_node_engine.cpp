@@ -18,6 +18,12 @@
 #include <cmath>
 #include <random>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <numeric>
+#include <cstdint>
+
+#include "../production/engine_results_channel.h"
 
 namespace DASE {
 
@@ -75,380 +81,509 @@ struct KernelData {
 };
 
 /**
- * @brief HIGH PERFORMANCE Universal Node - NO ATOMICS
+ * @brief Per-role behaviour, specialised at compile time
+ *
+ * enter() builds a fresh payload when a node switches into the role,
+ * execute() is the role's computation. Both are inlined into the
+ * bucket loop, so every partition runs a branch-free tight loop.
  */
-class UniversalNode {
-private:
-    // FAST: Regular variables instead of atomics
-    NodeType current_type = NodeType::WORKER;
-    double value = 0.0;
-    Priority priority = Priority::NORMAL;
-    
-    // Union for memory efficiency - only one active at a time
-    union FunctionData {
-        WorkerData worker;
-        CommData comm;
-        VectorData vector;
-        ProcessorData processor;
-        MarkovData markov;
-        KernelData kernel;
-        
-        // Explicit constructors for MSVC compatibility
-        FunctionData() : worker() {}
-        ~FunctionData() {}
-    } data;
-    
-    // Spatial coordinates for 3D honeycomb
-    int16_t x, y, z;
-    uint16_t node_id;
-    
-    // FAST: Regular performance tracking
-    uint64_t switch_count = 0;
-    uint64_t execution_count = 0;
+struct NodePosition {
+    int32_t x = 0, y = 0, z = 0;
+};
 
-public:
-    UniversalNode(uint16_t id = 0, int16_t px = 0, int16_t py = 0, int16_t pz = 0)
-        : node_id(id), x(px), y(py), z(pz) {
-        // Initialize as WORKER
-        data.worker = WorkerData();
+template <NodeType Role> struct RoleTraits;
+
+template <> struct RoleTraits<NodeType::WORKER> {
+    using Payload = WorkerData;
+    static Payload enter(double current_val, const NodePosition&) {
+        Payload data;
+        data.accumulator = current_val;
+        return data;
     }
-    
-    // MSVC requires explicit move semantics
-    UniversalNode(UniversalNode&& other) noexcept
-        : node_id(other.node_id), x(other.x), y(other.y), z(other.z),
-          current_type(other.current_type), value(other.value), priority(other.priority),
-          switch_count(other.switch_count), execution_count(other.execution_count) {
-        data.worker = WorkerData();  // Reset to default
+    static inline double execute(Payload& data, double input) {
+        // Real analog computation
+        double result = input * data.gain;
+        data.accumulator += result * 0.01;  // Integration
+        return result + data.accumulator;
     }
-    
-    UniversalNode& operator=(UniversalNode&& other) noexcept {
-        if (this != &other) {
-            node_id = other.node_id;
-            x = other.x; y = other.y; z = other.z;
-            current_type = other.current_type;
-            value = other.value;
-            priority = other.priority;
-            switch_count = other.switch_count;
-            execution_count = other.execution_count;
-            data.worker = WorkerData();
+};
+
+template <> struct RoleTraits<NodeType::COMM> {
+    using Payload = CommData;
+    static Payload enter(double, const NodePosition&) { return Payload(); }
+    static inline double execute(Payload& data, double input) {
+        // Communication processing
+        ++data.message_count;
+        return input + (data.message_count * 0.01);
+    }
+};
+
+template <> struct RoleTraits<NodeType::VECTOR> {
+    using Payload = VectorData;
+    static Payload enter(double, const NodePosition& pos) {
+        Payload data;
+        // Initialize vector with position-based data
+        for (int i = 0; i < 8; i++) {
+            data.data[i] = sinf((pos.x + pos.y + pos.z + i) * 0.1f);
         }
-        return *this;
+        return data;
     }
-    
-    // Delete copy operations
-    UniversalNode(const UniversalNode&) = delete;
-    UniversalNode& operator=(const UniversalNode&) = delete;
-    
-    /**
-     * @brief ULTRA FAST Role Switching - NO ATOMIC OVERHEAD
-     */
-    inline bool switchToType(NodeType new_type) {
-        if (current_type == new_type) return false;
-        
-        // FAST: Preserve current value for state transition
-        double current_val = value;
-        
-        // FAST: Direct assignment instead of atomic operations
-        current_type = new_type;
-        ++switch_count;  // Simple increment, no atomic
-        
-        // Perform real memory work - clear and reinitialize
-        switch (new_type) {
-            case NodeType::WORKER:
-                memset(&data, 0, sizeof(data));
-                data.worker = WorkerData();
-                data.worker.accumulator = current_val;
-                break;
-                
-            case NodeType::COMM:
-                memset(&data, 0, sizeof(data));
-                data.comm = CommData();
-                break;
-                
-            case NodeType::VECTOR:
-                memset(&data, 0, sizeof(data));
-                data.vector = VectorData();
-                // Initialize vector with position-based data
-                for (int i = 0; i < 8; i++) {
-                    data.vector.data[i] = sinf((x + y + z + i) * 0.1f);
-                }
-                break;
-                
-            case NodeType::PROCESSOR:
-                memset(&data, 0, sizeof(data));
-                data.processor = ProcessorData();
-                data.processor.registers[0] = static_cast<uint32_t>(current_val);
-                break;
-                
-            case NodeType::MARKOV:
-                memset(&data, 0, sizeof(data));
-                data.markov = MarkovData();
-                data.markov.state = static_cast<uint8_t>(current_val) % 4;
-                break;
-                
-            case NodeType::KERNEL:
-                memset(&data, 0, sizeof(data));
-                data.kernel = KernelData();
-                data.kernel.influence = current_val;
-                break;
+    static inline double execute(Payload& data, double input) {
+        // Vector similarity computation
+        float similarity = 0.0f;
+        float input_f = static_cast<float>(input);
+        for (int i = 0; i < 8; i++) {
+            similarity += data.data[i] * input_f;
         }
-        
-        return true;
+        return static_cast<double>(similarity);
     }
-    
-    /**
-     * @brief ULTRA FAST Execution - NO ATOMIC OVERHEAD
-     */
-    inline double execute(double input) {
-        NodeType type = current_type;  // FAST: Direct read
-        double result = 0.0;
-        
-        switch (type) {
-            case NodeType::WORKER:
-                // Real analog computation
-                result = input * data.worker.gain;
-                data.worker.accumulator += result * 0.01;  // Integration
-                result += data.worker.accumulator;
-                break;
-                
-            case NodeType::COMM:
-                // Communication processing
-                ++data.comm.message_count;
-                result = input + (data.comm.message_count * 0.01);
-                break;
-                
-            case NodeType::VECTOR:
-                // Vector similarity computation
-                {
-                    float similarity = 0.0f;
-                    float input_f = static_cast<float>(input);
-                    for (int i = 0; i < 8; i++) {
-                        similarity += data.vector.data[i] * input_f;
-                    }
-                    result = static_cast<double>(similarity);
-                }
-                break;
-                
-            case NodeType::PROCESSOR:
-                // CPU instruction simulation
-                data.processor.registers[1] = data.processor.registers[0] + static_cast<uint32_t>(input);
-                ++data.processor.pc;
-                result = static_cast<double>(data.processor.registers[1]);
-                break;
-                
-            case NodeType::MARKOV:
-                // Markov state transition
-                {
-                    uint8_t new_state = (static_cast<uint8_t>(input * 4) + data.markov.state) % 4;
-                    data.markov.state = new_state;
-                    result = static_cast<double>(new_state) + input;
-                }
-                break;
-                
-            case NodeType::KERNEL:
-                // Kernel influence decay
-                data.kernel.influence *= data.kernel.decay;
-                result = data.kernel.influence + input;
-                break;
+};
+
+template <> struct RoleTraits<NodeType::PROCESSOR> {
+    using Payload = ProcessorData;
+    static Payload enter(double current_val, const NodePosition&) {
+        Payload data;
+        data.registers[0] = static_cast<uint32_t>(current_val);
+        return data;
+    }
+    static inline double execute(Payload& data, double input) {
+        // CPU instruction simulation
+        data.registers[1] = data.registers[0] + static_cast<uint32_t>(input);
+        ++data.pc;
+        return static_cast<double>(data.registers[1]);
+    }
+};
+
+template <> struct RoleTraits<NodeType::MARKOV> {
+    using Payload = MarkovData;
+    static Payload enter(double current_val, const NodePosition&) {
+        Payload data;
+        data.state = static_cast<uint8_t>(current_val) % 4;
+        return data;
+    }
+    static inline double execute(Payload& data, double input) {
+        // Markov state transition
+        uint8_t new_state = (static_cast<uint8_t>(input * 4) + data.state) % 4;
+        data.state = new_state;
+        return static_cast<double>(new_state) + input;
+    }
+};
+
+template <> struct RoleTraits<NodeType::KERNEL> {
+    using Payload = KernelData;
+    static Payload enter(double current_val, const NodePosition&) {
+        Payload data;
+        data.influence = current_val;
+        return data;
+    }
+    static inline double execute(Payload& data, double input) {
+        // Kernel influence decay
+        data.influence *= data.decay;
+        return data.influence + input;
+    }
+};
+
+/**
+ * @brief Contiguous partition of all nodes currently in one role
+ *
+ * Slot k holds the k-th node of the role; `node` maps slots back to node IDs.
+ * Every wave executes the whole bucket, so execution counts are kept as one
+ * bucket-wide wave counter plus a cold per-node base set on entry; the hot
+ * loop writes no per-node counter.
+ */
+template <NodeType Role>
+struct RoleBucket {
+    using Payload = typename RoleTraits<Role>::Payload;
+
+    std::vector<Payload> payload;
+    std::vector<double> input_offset;  // Per-node input variation (id * 0.1)
+    std::vector<double> value;
+    std::vector<uint64_t> execution_base;  // Executions at entry minus `waves` at entry
+    std::vector<uint32_t> node;
+    uint64_t waves = 0;                    // Waves executed by this bucket
+
+    uint64_t executions(uint32_t slot) const { return execution_base[slot] + waves; }
+
+    size_t size() const { return node.size(); }
+
+    uint32_t add(uint32_t id, const Payload& data, double current_value, uint64_t executed) {
+        payload.push_back(data);
+        input_offset.push_back(id * 0.1);
+        value.push_back(current_value);
+        execution_base.push_back(executed - waves);
+        node.push_back(id);
+        return static_cast<uint32_t>(node.size() - 1);
+    }
+
+    // Swap-remove; returns the node ID that moved into `slot` (or UINT32_MAX)
+    uint32_t remove(uint32_t slot) {
+        const uint32_t last = static_cast<uint32_t>(node.size() - 1);
+        uint32_t moved = UINT32_MAX;
+        if (slot != last) {
+            payload[slot] = payload[last];
+            input_offset[slot] = input_offset[last];
+            value[slot] = value[last];
+            execution_base[slot] = execution_base[last];
+            node[slot] = node[last];
+            moved = node[slot];
         }
-        
-        value = result;  // FAST: Direct assignment
-        ++execution_count;  // FAST: Simple increment
-        
-        return result;
+        payload.pop_back();
+        input_offset.pop_back();
+        value.pop_back();
+        execution_base.pop_back();
+        node.pop_back();
+        return moved;
+    }
+
+    // TIGHT LOOP: One role, no type dispatch, contiguous payloads
+    double execute(double base_input) {
+        double total = 0.0;
+        const size_t count = node.size();
+        for (size_t k = 0; k < count; k++) {
+            const double result = RoleTraits<Role>::execute(payload[k], base_input + input_offset[k]);
+            value[k] = result;
+            total += result;
+        }
+        ++waves;
+        return total;
     }
-    
-    // FAST accessors - no atomic overhead
-    inline NodeType getType() const { return current_type; }
-    inline double getValue() const { return value; }
-    inline uint64_t getSwitchCount() const { return switch_count; }
-    inline uint64_t getExecutionCount() const { return execution_count; }
-    inline uint16_t getID() const { return node_id; }
-    
-    // Spatial accessors
-    inline int16_t getX() const { return x; }
-    inline int16_t getY() const { return y; }
-    inline int16_t getZ() const { return z; }
 };
 
 /**
- * @brief HIGH PERFORMANCE Universal Node Engine
+ * @brief Read-only view of one node, wherever its bucket currently keeps it
+ */
+class UniversalNodeEngine;
+
+class UniversalNodeView {
+public:
+    UniversalNodeView(const UniversalNodeEngine* engine = nullptr, uint32_t id = 0) : engine(engine), id(id) {}
+    explicit operator bool() const { return engine != nullptr; }
+
+    NodeType getType() const;
+    double getValue() const;
+    uint64_t getSwitchCount() const;
+    uint64_t getExecutionCount() const;
+    uint32_t getID() const;
+    int32_t getX() const;
+    int32_t getY() const;
+    int32_t getZ() const;
+
+private:
+    const UniversalNodeEngine* engine;
+    uint32_t id;
+};
+
+/**
+ * @brief HIGH PERFORMANCE Universal Node Engine - TYPE-SEGREGATED BUCKETS
+ *
+ * Nodes are grouped by role, each role's payload in its own contiguous
+ * array. A role switch migrates the node between buckets and remaps its
+ * index instead of rewriting a union in place.
+ *
+ * Engines hold no shared mutable globals: separate instances may run on
+ * different threads concurrently; one instance is not thread-safe.
  */
 class UniversalNodeEngine {
 private:
-    std::vector<UniversalNode> nodes;
+    struct NodeRecord {
+        NodeType type = NodeType::WORKER;
+        uint32_t slot = 0;                 // Index inside the role's bucket
+        Priority priority = Priority::NORMAL;
+        NodePosition position;             // Spatial coordinates for 3D honeycomb
+        uint32_t node_id = 0;
+        uint64_t switch_count = 0;
+    };
+
+    std::tuple<RoleBucket<NodeType::WORKER>, RoleBucket<NodeType::COMM>, RoleBucket<NodeType::VECTOR>,
+               RoleBucket<NodeType::PROCESSOR>, RoleBucket<NodeType::MARKOV>, RoleBucket<NodeType::KERNEL>> buckets;
+    std::vector<NodeRecord> records;
     size_t active_nodes = 0;  // FAST: No atomic
-    
+
+    template <NodeType Role>
+    RoleBucket<Role>& bucket() { return std::get<static_cast<size_t>(Role)>(buckets); }
+    template <NodeType Role>
+    const RoleBucket<Role>& bucket() const { return std::get<static_cast<size_t>(Role)>(buckets); }
+
+    // Runtime role -> compile-time bucket
+    template <typename Fn>
+    void withBucket(NodeType type, Fn&& fn) {
+        switch (type) {
+            case NodeType::WORKER:    fn(bucket<NodeType::WORKER>()); break;
+            case NodeType::COMM:      fn(bucket<NodeType::COMM>()); break;
+            case NodeType::VECTOR:    fn(bucket<NodeType::VECTOR>()); break;
+            case NodeType::PROCESSOR: fn(bucket<NodeType::PROCESSOR>()); break;
+            case NodeType::MARKOV:    fn(bucket<NodeType::MARKOV>()); break;
+            case NodeType::KERNEL:    fn(bucket<NodeType::KERNEL>()); break;
+        }
+    }
+    template <typename Fn>
+    void withBucket(NodeType type, Fn&& fn) const {
+        const_cast<UniversalNodeEngine*>(this)->withBucket(type, [&](auto& b) { fn(std::as_const(b)); });
+    }
+
+    template <NodeType Role>
+    void enterBucket(uint32_t id, double current_val, uint64_t executed) {
+        NodeRecord& record = records[id];
+        record.type = Role;
+        record.slot = bucket<Role>().add(id, RoleTraits<Role>::enter(current_val, record.position), current_val, executed);
+    }
+
 public:
     /**
      * @brief Initialize engine with node count
      */
     void initialize(size_t node_count) {
-        nodes.clear();
-        nodes.reserve(node_count);
-        
-        // Create nodes in 3D honeycomb pattern
+        buckets = decltype(buckets)();
+        records.assign(node_count, NodeRecord());
+
+        // Create nodes in 3D honeycomb pattern, all starting as WORKER
+        auto& workers = bucket<NodeType::WORKER>();
+        workers.payload.reserve(node_count);
         for (size_t i = 0; i < node_count; i++) {
-            int16_t x = static_cast<int16_t>(i % 10);
-            int16_t y = static_cast<int16_t>((i / 10) % 10);
-            int16_t z = static_cast<int16_t>(i / 100);
-            
-            nodes.emplace_back(static_cast<uint16_t>(i), x, y, z);
+            NodeRecord& record = records[i];
+            record.position.x = static_cast<int32_t>(i % 10);
+            record.position.y = static_cast<int32_t>((i / 10) % 10);
+            record.position.z = static_cast<int32_t>(i / 100);
+            record.node_id = static_cast<uint32_t>(i);
+            record.type = NodeType::WORKER;
+            record.slot = workers.add(static_cast<uint32_t>(i), WorkerData(), 0.0, 0);
         }
-        
+
         active_nodes = node_count;  // FAST: Direct assignment
-        
+
         std::cout << "Universal Node Engine initialized with " << node_count << " nodes" << std::endl;
     }
-    
+
+    /**
+     * @brief ROLE MIGRATION: Move a node into another role's bucket
+     */
+    bool switchToType(size_t index, NodeType new_type) {
+        if (index >= records.size()) return false;
+        NodeRecord& record = records[index];
+        if (record.type == new_type) return false;
+
+        // FAST: Preserve current value for state transition
+        double current_val = 0.0;
+        uint64_t executed = 0;
+        const uint32_t id = static_cast<uint32_t>(index);
+        withBucket(record.type, [&](auto& old_bucket) {
+            current_val = old_bucket.value[record.slot];
+            executed = old_bucket.executions(record.slot);
+            const uint32_t moved = old_bucket.remove(record.slot);
+            if (moved != UINT32_MAX) records[moved].slot = record.slot;
+        });
+
+        switch (new_type) {
+            case NodeType::WORKER:    enterBucket<NodeType::WORKER>(id, current_val, executed); break;
+            case NodeType::COMM:      enterBucket<NodeType::COMM>(id, current_val, executed); break;
+            case NodeType::VECTOR:    enterBucket<NodeType::VECTOR>(id, current_val, executed); break;
+            case NodeType::PROCESSOR: enterBucket<NodeType::PROCESSOR>(id, current_val, executed); break;
+            case NodeType::MARKOV:    enterBucket<NodeType::MARKOV>(id, current_val, executed); break;
+            case NodeType::KERNEL:    enterBucket<NodeType::KERNEL>(id, current_val, executed); break;
+        }
+        ++record.switch_count;  // Simple increment, no atomic
+        return true;
+    }
+
     /**
-     * @brief FAST computational wave execution
+     * @brief FAST computational wave execution, one tight loop per role
      */
     inline double executeWave(double base_input) {
-        if (nodes.empty()) return 0.0;
-        
+        if (records.empty()) return 0.0;
+
         double total_output = 0.0;
-        
-        // Execute all nodes in fast loop
-        for (size_t i = 0; i < nodes.size(); i++) {
-            double node_input = base_input + (i * 0.1);  // Vary input per node
-            double output = nodes[i].execute(node_input);
-            total_output += output;
-        }
-        
-        return total_output / static_cast<double>(nodes.size());
+        total_output += bucket<NodeType::WORKER>().execute(base_input);
+        total_output += bucket<NodeType::COMM>().execute(base_input);
+        total_output += bucket<NodeType::VECTOR>().execute(base_input);
+        total_output += bucket<NodeType::PROCESSOR>().execute(base_input);
+        total_output += bucket<NodeType::MARKOV>().execute(base_input);
+        total_output += bucket<NodeType::KERNEL>().execute(base_input);
+
+        return total_output / static_cast<double>(records.size());
     }
-    
+
     /**
      * @brief FAST role switching pattern for benchmarking
      */
     inline void performRoleSwitching() {
-        if (nodes.empty()) return;
-        
+        if (records.empty()) return;
+
         // Switch nodes through different types in pattern
         static const NodeType types[] = {
             NodeType::WORKER, NodeType::COMM, NodeType::VECTOR,
             NodeType::PROCESSOR, NodeType::MARKOV, NodeType::KERNEL
         };
-        
-        for (size_t i = 0; i < nodes.size(); i++) {
-            NodeType target_type = types[i % 6];
-            nodes[i].switchToType(target_type);
+
+        for (size_t i = 0; i < records.size(); i++) {
+            switchToType(i, types[i % 6]);
         }
     }
-    
+
     /**
      * @brief Get performance statistics
      */
     void getPerformanceStats() {
-        if (nodes.empty()) return;
-        
+        if (records.empty()) return;
+
         uint64_t total_switches = 0;
         uint64_t total_executions = 0;
-        
-        for (const auto& node : nodes) {
-            total_switches += node.getSwitchCount();
-            total_executions += node.getExecutionCount();
+
+        for (const auto& record : records) {
+            total_switches += record.switch_count;
         }
-        
+        std::apply([&](const auto&... role) {
+            ((total_executions += std::accumulate(role.execution_base.begin(), role.execution_base.end(), uint64_t(0)) +
+                                  role.waves * role.size()), ...);
+        }, buckets);
+
         std::cout << "Performance Stats:" << std::endl;
-        std::cout << "   Nodes: " << nodes.size() << std::endl;
+        std::cout << "   Nodes: " << records.size() << std::endl;
         std::cout << "   Total Switches: " << total_switches << std::endl;
         std::cout << "   Total Executions: " << total_executions << std::endl;
-        std::cout << "   Avg Switches/Node: " << (total_switches / nodes.size()) << std::endl;
+        std::cout << "   Avg Switches/Node: " << (total_switches / records.size()) << std::endl;
     }
-    
+
     /**
      * @brief Get node count
      */
-    size_t getNodeCount() const { return nodes.size(); }
-    
+    size_t getNodeCount() const { return records.size(); }
+
+    /**
+     * @brief Get nodes currently in one role
+     */
+    size_t getRoleCount(NodeType type) const {
+        size_t count = 0;
+        withBucket(type, [&](const auto& b) { count = b.size(); });
+        return count;
+    }
+
     /**
      * @brief Get specific node for testing
      */
-    UniversalNode* getNode(size_t index) {
-        return (index < nodes.size()) ? &nodes[index] : nullptr;
+    UniversalNodeView getNode(size_t index) const {
+        return (index < records.size()) ? UniversalNodeView(this, static_cast<uint32_t>(index)) : UniversalNodeView();
     }
+
+private:
+    friend class UniversalNodeView;
 };
 
+// View accessors resolve the node's current bucket on every call
+inline NodeType UniversalNodeView::getType() const { return engine->records[id].type; }
+inline double UniversalNodeView::getValue() const {
+    double value = 0.0;
+    engine->withBucket(engine->records[id].type, [&](const auto& b) { value = b.value[engine->records[id].slot]; });
+    return value;
+}
+inline uint64_t UniversalNodeView::getSwitchCount() const { return engine->records[id].switch_count; }
+inline uint64_t UniversalNodeView::getExecutionCount() const {
+    uint64_t executed = 0;
+    engine->withBucket(engine->records[id].type, [&](const auto& b) { executed = b.executions(engine->records[id].slot); });
+    return executed;
+}
+inline uint32_t UniversalNodeView::getID() const { return engine->records[id].node_id; }
+inline int32_t UniversalNodeView::getX() const { return engine->records[id].position.x; }
+inline int32_t UniversalNodeView::getY() const { return engine->records[id].position.y; }
+inline int32_t UniversalNodeView::getZ() const { return engine->records[id].position.z; }
+
 } // namespace DASE
 
-// Global engine instance for benchmark integration
-DASE::UniversalNodeEngine g_engine;
+/**
+ * @brief Benchmark state for minimal_computation_test
+ *
+ * Owns its engine, RNG and accumulator, so concurrent benchmark threads
+ * never share mutable state.
+ */
+struct MinimalTestContext {
+    DASE::UniversalNodeEngine engine;
+    std::mt19937 gen{std::random_device{}()};
+    std::uniform_real_distribution<> dis{0.1, 10.0};
+    double accumulator = 0.0;
+
+    MinimalTestContext() {
+        engine.initialize(100);  // 100 nodes for testing
+    }
+};
 
 /**
  * @brief ULTRA FAST test function for benchmark
  * NO ATOMIC OVERHEAD - should achieve ~300-400ns per operation
  */
-void minimal_computation_test() {
-    static bool initialized = false;
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<> dis(0.1, 10.0);
-    
-    // Initialize engine on first call
-    if (!initialized) {
-        g_engine.initialize(100);  // 100 nodes for testing
-        initialized = true;
-    }
-    
+void minimal_computation_test(MinimalTestContext& context) {
     // Perform REAL work that benchmark will measure
     // 1. Role switching (most expensive operation) - MUCH FASTER NOW
-    if (gen() % 10 == 0) {  // 10% chance of role switch per call
-        g_engine.performRoleSwitching();
+    if (context.gen() % 10 == 0) {  // 10% chance of role switch per call
+        context.engine.performRoleSwitching();
     }
     
     // 2. Execute computational wave (actual computation) - MUCH FASTER NOW
-    double input = dis(gen);
-    volatile double result = g_engine.executeWave(input);
+    double input = context.dis(context.gen);
+    volatile double result = context.engine.executeWave(input);
     
     // 3. Force actual memory work to prevent optimization
-    static double accumulator = 0.0;
-    accumulator += result;
-    if (accumulator > 10000.0) accumulator = 0.0;  // Prevent overflow
+    context.accumulator += result;
+    if (context.accumulator > 10000.0) context.accumulator = 0.0;  // Prevent overflow
+}
+
+/**
+ * @brief Benchmark entry point: one context per calling thread
+ */
+void minimal_computation_test() {
+    thread_local MinimalTestContext context;
+    minimal_computation_test(context);
 }
 
 /**
  * @brief Standalone engine function (for running engine independently)
+ * @param write_json Also write web_results.json through the JSON adapter
+ *
+ * Results go to the memory-mapped channel web_results.bin; readers map the
+ * file instead of parsing text. The JSON file is only for the file-based UI.
  */
-int run_standalone_engine() {
+int run_standalone_engine(bool write_json = false) {
     auto start = std::chrono::high_resolution_clock::now();
     
     // Initialize Universal Node Engine
-    g_engine.initialize(10);  // Start with 10 nodes
+    DASE::UniversalNodeEngine engine;
+    engine.initialize(10);  // Start with 10 nodes
     
     // Perform mixed operations like web interface would
-    std::vector<double> results;
+    // Results are preallocated: nothing allocates inside the wave loop
+    constexpr size_t kWaves = 5;
+    std::vector<double> results(kWaves);
     
     // Test different node configurations
-    for (int i = 0; i < 5; i++) {
+    for (size_t i = 0; i < kWaves; i++) {
         // Role switching phase
-        g_engine.performRoleSwitching();
+        engine.performRoleSwitching();
         
         // Computational phase
         double input = 2.0 + (i * 0.5);
-        double output = g_engine.executeWave(input);
-        results.push_back(output);
+        results[i] = engine.executeWave(input);
     }
     
     auto compute_end = std::chrono::high_resolution_clock::now();
     double compute_time = std::chrono::duration<double, std::milli>(compute_end - start).count();
     
-    // Output results in format compatible with web interface
-    std::ofstream out("web_results.json");
-    out << "{\"cells\":{";
-    
-    for (size_t i = 0; i < results.size() && i < 5; i++) {
-        if (i > 0) out << ",";
-        char cell_name = 'A' + static_cast<char>(i);
-        out << "\"" << cell_name << "1\":{\"value\":" << results[i] << "}";
+    // Binary results: fixed header + packed doubles, published with one sequence store
+    ResultsChannelWriter channel;
+    ResultsRecordInfo info;
+    info.nodes_computed = engine.getNodeCount();
+    info.compute_ms = compute_time;
+    if (!channel.create("web_results.bin", results.size()) ||
+        !channel.publish(results.data(), results.size(), info)) {
+        std::cerr << "Cannot map web_results.bin" << std::endl;
+        return 1;
     }
     
-    out << "},\"performance\":{\"execution_time_ms\":" << compute_time 
-        << ",\"nodes_computed\":" << g_engine.getNodeCount()
-        << ",\"node_type\":\"universal_cellular\""
-        << ",\"timestamp\":\"" << std::time(nullptr) << "\"}}\n";
-    out.close();
+    // COMPATIBILITY: web_results.json rendered from the channel, not from engine state
+    if (write_json) {
+        ResultsChannelReader reader;
+        if (!reader.open("web_results.bin") || !writeResultsJson(reader, "web_results.json")) {
+            std::cerr << "Cannot write web_results.json" << std::endl;
+            return 1;
+        }
+    }
     
     auto end = std::chrono::high_resolution_clock::now();
     double total = std::chrono::duration<double, std::milli>(end - start).count();
@@ -456,11 +591,12 @@ int run_standalone_engine() {
     // Performance output
     std::cout << "Universal Node Engine Results:" << std::endl;
     std::cout << "Compute Time: " << compute_time << "ms" << std::endl;
-    std::cout << "Nodes: " << g_engine.getNodeCount() << std::endl;
+    std::cout << "Publish Time: " << (total - compute_time) << "ms" << (write_json ? " (with JSON)" : "") << std::endl;
+    std::cout << "Nodes: " << engine.getNodeCount() << std::endl;
     std::cout << "Target <0.1ms: " << (compute_time < 0.1 ? "ACHIEVED" : std::to_string(compute_time) + "ms") << std::endl;
     
     // Show performance details
-    g_engine.getPerformanceStats();
+    engine.getPerformanceStats();
     
     return 0;
 }
@@ -468,15 +604,17 @@ int run_standalone_engine() {
 // MSVC Compilation Instructions:
 // 
 // FOR BENCHMARK (links with benchmark.cpp):
-// cl /O2 /std:c++17 /EHsc /DBENCHMARK_BUILD benchmark.cpp universal_node_engine.cpp /Fe:benchmark.exe
+// cl /O2 /std:c++17 /EHsc /DBENCHMARK_BUILD benchmark.cpp universal_node_engine.cpp ..\production\engine_results_channel.cpp ..\production\engine_mapped_file.cpp /Fe:benchmark.exe
 // 
 // FOR STANDALONE ENGINE:
-// cl /O2 /Ox /std:c++17 /favor:AMD64 /EHsc universal_node_engine.cpp /Fe:universal_node_engine.exe
+// cl /O2 /Ox /std:c++17 /favor:AMD64 /EHsc universal_node_engine.cpp ..\production\engine_results_channel.cpp ..\production\engine_mapped_file.cpp /Fe:universal_node_engine.exe
+// (pass --json to also write web_results.json)
 
 // Main function for standalone compilation
 // This is excluded when linking with benchmark.cpp
 #ifndef BENCHMARK_BUILD
-int main() { 
-    return run_standalone_engine(); 
+int main(int argc, char** argv) { 
+    const bool write_json = argc > 1 && std::string(argv[1]) == "--json";
+    return run_standalone_engine(write_json); 
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include "analog_circuit_graph.h"
+#include <algorithm>
+
+AnalogCircuitGraph::AnalogCircuitGraph(size_t node_count)
+    : controls(node_count, 0.0), external_gains(node_count, 0.0), node_count(node_count) {
+}
+
+bool AnalogCircuitGraph::connect(uint32_t source, uint32_t target, double weight) {
+    if (source >= node_count || target >= node_count) return false;
+    edges.push_back({source, target, weight, false, false});
+    compiled = false;
+    return true;
+}
+
+bool AnalogCircuitGraph::connectDelayed(uint32_t source, uint32_t target, double weight) {
+    if (source >= node_count || target >= node_count) return false;
+    edges.push_back({source, target, weight, true, false});
+    compiled = false;
+    return true;
+}
+
+bool AnalogCircuitGraph::setControl(uint32_t node, double control_signal) {
+    if (node >= node_count) return false;
+    controls[node] = control_signal;
+    return true;
+}
+
+bool AnalogCircuitGraph::setExternalInput(uint32_t node, double gain) {
+    if (node >= node_count) return false;
+    external_gains[node] = gain;
+    return true;
+}
+
+bool AnalogCircuitGraph::remapNodes(const std::vector<uint32_t>& new_index) {
+    if (new_index.size() != node_count) return false;
+    std::vector<uint8_t> seen(node_count, 0);
+    for (uint32_t target : new_index) {
+        if (target >= node_count || seen[target]) return false;
+        seen[target] = 1;
+    }
+
+    for (auto& edge : edges) {
+        edge.source = new_index[edge.source];
+        edge.target = new_index[edge.target];
+    }
+    std::vector<double> remapped_controls(node_count), remapped_gains(node_count);
+    for (size_t v = 0; v < node_count; v++) {
+        remapped_controls[new_index[v]] = controls[v];
+        remapped_gains[new_index[v]] = external_gains[v];
+    }
+    controls.swap(remapped_controls);
+    external_gains.swap(remapped_gains);
+    std::vector<uint32_t> remapped_ids(node_count);
+    for (size_t v = 0; v < node_count; v++) {
+        remapped_ids[new_index[v]] = original_ids.empty() ? static_cast<uint32_t>(v) : original_ids[v];
+    }
+    original_ids.swap(remapped_ids);
+    compiled = false;
+    return true;
+}
+
+// Counting-sort edges of one kind into CSR grouped by target, keeping insertion order
+static void buildTargetCsr(size_t node_count, const std::vector<uint32_t>& edge_targets,
+                           const std::vector<uint32_t>& edge_sources, const std::vector<double>& edge_weights,
+                           std::vector<uint32_t>& offsets, std::vector<uint32_t>& sources,
+                           std::vector<double>& weights) {
+    offsets.assign(node_count + 1, 0);
+    for (uint32_t target : edge_targets) offsets[target + 1]++;
+    for (size_t i = 0; i < node_count; i++) offsets[i + 1] += offsets[i];
+
+    sources.resize(edge_targets.size());
+    weights.resize(edge_targets.size());
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t e = 0; e < edge_targets.size(); e++) {
+        const uint32_t slot = cursor[edge_targets[e]]++;
+        sources[slot] = edge_sources[e];
+        weights[slot] = edge_weights[e];
+    }
+}
+
+void AnalogCircuitGraph::compile() {
+    const size_t n = node_count;
+    // Demotions from an earlier compile are recomputed from scratch
+    for (auto& edge : edges) {
+        if (edge.demoted) {
+            edge.delayed = false;
+            edge.demoted = false;
+        }
+    }
+
+    // Outgoing / incoming algebraic edge lists (edge indices) for the level pass
+    std::vector<uint32_t> out_offsets(n + 1, 0), in_offsets(n + 1, 0);
+    for (const auto& edge : edges) {
+        if (edge.delayed) continue;
+        out_offsets[edge.source + 1]++;
+        in_offsets[edge.target + 1]++;
+    }
+    for (size_t i = 0; i < n; i++) {
+        out_offsets[i + 1] += out_offsets[i];
+        in_offsets[i + 1] += in_offsets[i];
+    }
+    std::vector<uint32_t> out_edges(out_offsets[n]), in_edges(in_offsets[n]);
+    {
+        std::vector<uint32_t> out_cursor(out_offsets.begin(), out_offsets.end() - 1);
+        std::vector<uint32_t> in_cursor(in_offsets.begin(), in_offsets.end() - 1);
+        for (uint32_t e = 0; e < edges.size(); e++) {
+            if (edges[e].delayed) continue;
+            out_edges[out_cursor[edges[e].source]++] = e;
+            in_edges[in_cursor[edges[e].target]++] = e;
+        }
+    }
+
+    // LEVEL SCHEDULE: Kahn's algorithm, one frontier per level
+    std::vector<uint32_t> pending(n, 0);
+    for (size_t v = 0; v < n; v++) pending[v] = in_offsets[v + 1] - in_offsets[v];
+
+    std::vector<uint8_t> placed(n, 0);
+    std::vector<uint32_t> frontier, next;
+    for (uint32_t v = 0; v < n; v++) {
+        if (pending[v] == 0) frontier.push_back(v);
+    }
+
+    // Loop release order: nodes by original ID, so demotions ignore any remap
+    std::vector<uint32_t> release_order;
+    if (!original_ids.empty()) {
+        release_order.resize(n);
+        for (uint32_t v = 0; v < n; v++) release_order[original_ids[v]] = v;
+    }
+
+    level_offsets.assign(1, 0);
+    level_nodes.clear();
+    node_levels.assign(n, 0);
+    level_nodes.reserve(n);
+    demoted_edges = 0;
+    size_t placed_count = 0;
+    uint32_t scan = 0;
+
+    while (placed_count < n) {
+        if (frontier.empty()) {
+            // Algebraic loop: release the waiting node with the lowest ID by turning
+            // its edges from still-unplaced sources into one-step delay edges
+            auto nodeAt = [&](uint32_t rank) { return release_order.empty() ? rank : release_order[rank]; };
+            while (placed[nodeAt(scan)]) scan++;
+            const uint32_t released = nodeAt(scan);
+            for (uint32_t k = in_offsets[released]; k < in_offsets[released + 1]; k++) {
+                Edge& edge = edges[in_edges[k]];
+                if (!edge.delayed && !placed[edge.source]) {
+                    edge.delayed = true;
+                    edge.demoted = true;
+                    demoted_edges++;
+                    pending[released]--;
+                }
+            }
+            frontier.push_back(released);
+        }
+
+        std::sort(frontier.begin(), frontier.end());
+        for (uint32_t v : frontier) {
+            placed[v] = 1;
+            node_levels[v] = static_cast<uint32_t>(level_offsets.size() - 1);
+            level_nodes.push_back(v);
+        }
+        placed_count += frontier.size();
+        level_offsets.push_back(static_cast<uint32_t>(level_nodes.size()));
+
+        next.clear();
+        for (uint32_t v : frontier) {
+            for (uint32_t k = out_offsets[v]; k < out_offsets[v + 1]; k++) {
+                const Edge& edge = edges[out_edges[k]];
+                if (edge.delayed) continue;
+                if (--pending[edge.target] == 0) next.push_back(edge.target);
+            }
+        }
+        frontier.swap(next);
+    }
+
+    // CSR adjacency by target, split into algebraic and delayed edges
+    std::vector<uint32_t> targets, sources;
+    std::vector<double> weights;
+    std::vector<uint32_t> delay_targets, delay_srcs;
+    std::vector<double> delay_ws;
+    for (const auto& edge : edges) {
+        if (edge.delayed) {
+            delay_targets.push_back(edge.target);
+            delay_srcs.push_back(edge.source);
+            delay_ws.push_back(edge.weight);
+        } else {
+            targets.push_back(edge.target);
+            sources.push_back(edge.source);
+            weights.push_back(edge.weight);
+        }
+    }
+    buildTargetCsr(n, targets, sources, weights, input_offsets, input_sources, input_weights);
+    buildTargetCsr(n, delay_targets, delay_srcs, delay_ws, delay_offsets, delay_sources, delay_weights);
+    // Same lists keyed by source (weights are not needed there)
+    std::vector<double> unused_weights;
+    buildTargetCsr(n, sources, targets, weights, output_offsets, output_targets, unused_weights);
+    buildTargetCsr(n, delay_srcs, delay_targets, delay_ws, delay_output_offsets, delay_output_targets, unused_weights);
+
+    delayed_sources = delay_srcs;
+    std::sort(delayed_sources.begin(), delayed_sources.end());
+    delayed_sources.erase(std::unique(delayed_sources.begin(), delayed_sources.end()), delayed_sources.end());
+
+    compiled = true;
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// NETLIST: Patch-panel wiring between AnalogCellularEngine nodes
+// Each node's input is the weighted sum of its wired sources plus an optional
+// share of the external input. connect() edges are algebraic (same step);
+// connectDelayed() edges read the source's output from the previous step and
+// are how feedback loops close. compile() lays the wiring out as CSR adjacency
+// and splits the algebraic DAG into levels that can each run fully in parallel.
+class AnalogCircuitGraph {
+public:
+    explicit AnalogCircuitGraph(size_t node_count = 0);
+
+    // Wiring (returns false for out-of-range nodes)
+    bool connect(uint32_t source, uint32_t target, double weight = 1.0);
+    bool connectDelayed(uint32_t source, uint32_t target, double weight = 1.0);
+
+    // Per-node patch settings
+    bool setControl(uint32_t node, double control_signal);     // Mode, as processSignal's control_signal
+    bool setExternalInput(uint32_t node, double gain = 1.0);   // Share of the external input fed to node
+
+    // Build CSR adjacency and the level schedule. Algebraic loops without a delay
+    // edge are broken deterministically by demoting the closing edges to delayed.
+    // Loops are released from the waiting node with the lowest original node ID,
+    // so a netlist demotes the same edges however it has been remapped.
+    void compile();
+
+    // Relabel node v as new_index[v] (a permutation of [0, node_count)), e.g. to
+    // match an engine's storage order. Invalidates the compiled view.
+    bool remapNodes(const std::vector<uint32_t>& new_index);
+
+    bool isCompiled() const { return compiled; }
+    size_t getNodeCount() const { return node_count; }
+    size_t getEdgeCount() const { return edges.size(); }
+    size_t getLevelCount() const { return level_offsets.empty() ? 0 : level_offsets.size() - 1; }
+    size_t getDemotedEdgeCount() const { return demoted_edges; }
+
+    // COMPILED VIEW (valid after compile())
+    // Incoming algebraic edges of node i: [input_offsets[i], input_offsets[i + 1])
+    std::vector<uint32_t> input_offsets;
+    std::vector<uint32_t> input_sources;
+    std::vector<double> input_weights;
+
+    // Incoming one-step delay edges, same CSR layout
+    std::vector<uint32_t> delay_offsets;
+    std::vector<uint32_t> delay_sources;
+    std::vector<double> delay_weights;
+
+    // Distinct sources of delay edges (outputs latched at the start of each step)
+    std::vector<uint32_t> delayed_sources;
+
+    // Nodes of level L: level_nodes[level_offsets[L] .. level_offsets[L + 1])
+    std::vector<uint32_t> level_offsets;
+    std::vector<uint32_t> level_nodes;
+    std::vector<uint32_t> node_levels;     // Level of each node
+
+    // Outgoing edges by source, for event-driven evaluation: algebraic targets of
+    // node i are output_targets[output_offsets[i] .. [i + 1]), delayed targets likewise
+    std::vector<uint32_t> output_offsets;
+    std::vector<uint32_t> output_targets;
+    std::vector<uint32_t> delay_output_offsets;
+    std::vector<uint32_t> delay_output_targets;
+
+    std::vector<double> controls;
+    std::vector<double> external_gains;
+
+private:
+    struct Edge {
+        uint32_t source;
+        uint32_t target;
+        double weight;
+        bool delayed;
+        bool demoted;  // Delayed by compile() to break an algebraic loop
+    };
+
+    size_t node_count = 0;
+    std::vector<Edge> edges;
+    std::vector<uint32_t> original_ids;   // Node ID before any remapNodes(); empty = identity
+    size_t demoted_edges = 0;
+    bool compiled = false;
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// SNAPSHOT: AnalogCellularEngine checkpoint file (native byte order)
+//   [0, 4096)                AnalogSnapshotHeader, zero padded to one page
+//   [4096, +state_bytes)     the node SoA block exactly as the engine holds it, in
+//                            storage-slot order: integrator_state | previous_input |
+//                            feedback_gain | current_output, lane_capacity entries each
+// The state block starts on a page boundary, so loadSnapshot() maps the file and
+// uses the block as node storage in place: no parse step and no copy.
+static constexpr uint32_t kAnalogSnapshotVersion = 2;
+static constexpr size_t kAnalogSnapshotPage = 4096;
+
+struct AnalogSnapshotHeader {
+    char magic[8];                // "DASESNP1"
+    uint32_t version;
+    uint32_t header_bytes;        // Offset of the state block (one page)
+    uint32_t scalar_bytes;        // sizeof(Scalar): output, history and feedback arrays
+    uint32_t accum_bytes;         // sizeof(Accum): integrator array
+    uint64_t node_count;
+    uint64_t lane_capacity;       // Entries per array (node count padded to lane blocks)
+    uint64_t state_bytes;
+    uint32_t nx, ny, nz;          // Applied lattice layout: storage slots follow its ordering
+    uint32_t ordering;            // NodeOrdering
+    double clock_time;
+    double clock_step;
+    uint64_t clock_ticks;
+    double system_frequency;
+    double noise_level;
+    uint64_t node_passes;
+    uint64_t operations;          // getOperationCount() when saved
+    uint64_t noise_seed;          // Version 2: noise generator key and step counter
+    uint64_t noise_steps;
+};
+
+static_assert(sizeof(AnalogSnapshotHeader) <= kAnalogSnapshotPage, "snapshot header must fit its page");
+
+// Validated header of a snapshot file, e.g. to construct a matching engine
+// (node count, precision, layout) before calling loadSnapshot()
+bool readAnalogSnapshotHeader(const std::string& path, AnalogSnapshotHeader& header);
@@ -0,0 +1,219 @@
+#include "analog_ensemble_engine.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+EnsembleEngine::EnsembleEngine(const AnalogCircuitGraph& circuit, size_t num_instances,
+                               const AnalogEngineConfig& engine_config)
+    : graph(circuit), instance_count(num_instances),
+      stride((num_instances + kAnalogLaneBlock - 1) / kAnalogLaneBlock * kAnalogLaneBlock),
+      state(circuit.getNodeCount() * stride), latch(circuit.getNodeCount() * stride, 0.0),
+      frequency(stride, 1.0), feedback(stride, 1.0), phase_cos(stride, 1.0), phase_sin(stride, 0.0),
+      rotate_cos(stride, 1.0), rotate_sin(stride, 0.0),
+      observed_node(circuit.getNodeCount() ? static_cast<uint32_t>(circuit.getNodeCount() - 1) : 0),
+      observed_sum(stride, 0.0), observed_peak(stride, 0.0), config(engine_config),
+      pool(std::make_unique<EngineThreadPool>(engine_config)) {
+    if (!graph.isCompiled()) graph.compile();
+}
+
+AnalogLaneState EnsembleEngine::laneStateFor(uint32_t v) const {
+    const size_t offset = static_cast<size_t>(v) * stride;
+    return {state.integrator_state + offset, state.previous_input + offset,
+            state.feedback_gain + offset, state.current_output + offset};
+}
+
+bool EnsembleEngine::setInstanceFeedback(size_t instance, double feedback_gain) {
+    if (instance >= instance_count) return false;
+    feedback[instance] = std::clamp(feedback_gain, 0.1, 10.0);
+    for (size_t v = 0; v < graph.getNodeCount(); v++) {
+        state.feedback_gain[v * stride + instance] = feedback[instance];
+    }
+    return true;
+}
+
+bool EnsembleEngine::setInstanceFrequency(size_t instance, double new_frequency) {
+    if (instance >= instance_count) return false;
+    frequency[instance] = new_frequency;
+    // Re-seed the phasor so the drive stays sin(frequency * t) from now on
+    phase_cos[instance] = std::cos(new_frequency * clock.now());
+    phase_sin[instance] = std::sin(new_frequency * clock.now());
+    return true;
+}
+
+void EnsembleEngine::sweepFeedback(double first, double last) {
+    const double span = instance_count > 1 ? (last - first) / static_cast<double>(instance_count - 1) : 0.0;
+    for (size_t i = 0; i < instance_count; i++) {
+        setInstanceFeedback(i, first + span * static_cast<double>(i));
+    }
+}
+
+void EnsembleEngine::sweepFrequency(double first, double last) {
+    const double span = instance_count > 1 ? (last - first) / static_cast<double>(instance_count - 1) : 0.0;
+    for (size_t i = 0; i < instance_count; i++) {
+        setInstanceFrequency(i, first + span * static_cast<double>(i));
+    }
+}
+
+void EnsembleEngine::randomizeFeedback(double center, double spread, uint64_t seed) {
+    std::mt19937_64 generator(seed);
+    std::uniform_real_distribution<double> distribution(center - spread, center + spread);
+    for (size_t i = 0; i < instance_count; i++) {
+        setInstanceFeedback(i, distribution(generator));
+    }
+}
+
+bool EnsembleEngine::setObservedNode(uint32_t node) {
+    if (node >= graph.getNodeCount()) return false;
+    observed_node = node;
+    std::fill(observed_sum.begin(), observed_sum.end(), 0.0);
+    std::fill(observed_peak.begin(), observed_peak.end(), 0.0);
+    steps_run = 0;
+    return true;
+}
+
+void EnsembleEngine::reset() {
+    const size_t cells = graph.getNodeCount() * stride;
+    std::fill(state.integrator_state, state.integrator_state + cells, 0.0);
+    std::fill(state.previous_input, state.previous_input + cells, 0.0);
+    std::fill(state.current_output, state.current_output + cells, 0.0);
+    std::fill(latch.begin(), latch.end(), 0.0);
+    std::fill(phase_cos.begin(), phase_cos.end(), 1.0);
+    std::fill(phase_sin.begin(), phase_sin.end(), 0.0);
+    std::fill(observed_sum.begin(), observed_sum.end(), 0.0);
+    std::fill(observed_peak.begin(), observed_peak.end(), 0.0);
+    steps_run = 0;
+    clock.reset();
+}
+
+void EnsembleEngine::run(size_t steps, double time_step) {
+    if (steps == 0 || instance_count == 0 || graph.getNodeCount() == 0) return;
+    for (size_t i = 0; i < instance_count; i++) {
+        rotate_cos[i] = std::cos(frequency[i] * time_step);
+        rotate_sin[i] = std::sin(frequency[i] * time_step);
+    }
+
+    // Instance blocks are independent: each worker runs all steps for its slice
+    const size_t block_count = stride / kAnalogLaneBlock;
+    pool->runOnWorkers([&](size_t worker, size_t worker_count) {
+        size_t begin = 0, end = 0;
+        EngineThreadPool::staticRange(block_count, worker, worker_count, begin, end);
+        for (size_t b = begin; b < end; b++) {
+            const size_t first = b * kAnalogLaneBlock;
+            runInstanceBlock(first, std::min(kAnalogLaneBlock, instance_count - first), steps);
+        }
+    });
+
+    steps_run += steps;
+    clock.advance(time_step * static_cast<double>(steps));
+}
+
+// SIMD: One lane block of instances through every step, node by node in level order
+void EnsembleEngine::runInstanceBlock(size_t first, size_t count, size_t steps) {
+    double drive[kAnalogLaneBlock];
+    double input[kAnalogLaneBlock];
+    double control[kAnalogLaneBlock];
+    double output[kAnalogLaneBlock];
+    const double* outputs = state.current_output;
+
+    for (size_t t = 0; t < steps; t++) {
+        // Drive phasor: advance first, like performSignalSweep's time counter
+        for (size_t lane = 0; lane < count; lane++) {
+            const size_t i = first + lane;
+            const double next_cos = phase_cos[i] * rotate_cos[i] - phase_sin[i] * rotate_sin[i];
+            phase_sin[i] = phase_sin[i] * rotate_cos[i] + phase_cos[i] * rotate_sin[i];
+            phase_cos[i] = next_cos;
+            drive[lane] = phase_sin[i];
+        }
+
+        for (uint32_t source : graph.delayed_sources) {
+            const size_t row = static_cast<size_t>(source) * stride + first;
+            std::copy(outputs + row, outputs + row + count, latch.data() + row);
+        }
+
+        for (uint32_t v : graph.level_nodes) {
+            const double gain = graph.external_gains[v];
+            for (size_t lane = 0; lane < count; lane++) {
+                input[lane] = gain * drive[lane];
+                control[lane] = graph.controls[v];
+            }
+            for (uint32_t k = graph.input_offsets[v]; k < graph.input_offsets[v + 1]; k++) {
+                const double weight = graph.input_weights[k];
+                const double* source = outputs + static_cast<size_t>(graph.input_sources[k]) * stride + first;
+                for (size_t lane = 0; lane < count; lane++) input[lane] += weight * source[lane];
+            }
+            for (uint32_t k = graph.delay_offsets[v]; k < graph.delay_offsets[v + 1]; k++) {
+                const double weight = graph.delay_weights[k];
+                const double* source = latch.data() + static_cast<size_t>(graph.delay_sources[k]) * stride + first;
+                for (size_t lane = 0; lane < count; lane++) input[lane] += weight * source[lane];
+            }
+            processSignalLanes(laneStateFor(v), first, count, input, control, input, output);
+        }
+
+        const double* observed = outputs + static_cast<size_t>(observed_node) * stride + first;
+        for (size_t lane = 0; lane < count; lane++) {
+            observed_sum[first + lane] += observed[lane];
+            observed_peak[first + lane] = std::max(observed_peak[first + lane], std::fabs(observed[lane]));
+        }
+    }
+}
+
+double EnsembleEngine::getInstanceValue(EnsembleObservable observable, size_t instance) const {
+    if (instance >= instance_count || graph.getNodeCount() == 0) return 0.0;
+    switch (observable) {
+        case EnsembleObservable::MeanOutput:
+            return steps_run ? observed_sum[instance] / static_cast<double>(steps_run) : 0.0;
+        case EnsembleObservable::PeakOutput:
+            return observed_peak[instance];
+        case EnsembleObservable::FinalOutput:
+        default:
+            return state.current_output[static_cast<size_t>(observed_node) * stride + instance];
+    }
+}
+
+EnsembleStats EnsembleEngine::getStatistics(EnsembleObservable observable, size_t histogram_bins) const {
+    EnsembleStats stats;
+    stats.instances = instance_count;
+    if (instance_count == 0) return stats;
+
+    // A diverged instance (NaN or infinite) is counted, not reduced: one would
+    // poison the mean and variance and make every histogram position undefined
+    std::vector<double> values;
+    values.reserve(instance_count);
+    for (size_t i = 0; i < instance_count; i++) {
+        const double value = getInstanceValue(observable, i);
+        if (std::isfinite(value)) {
+            values.push_back(value);
+        } else {
+            stats.non_finite++;
+        }
+    }
+    const size_t count = values.size();
+    if (histogram_bins > 0) stats.histogram.assign(histogram_bins, 0);
+    if (count == 0) return stats;
+
+    // Two-pass mean / variance: ensembles are small enough to keep the values.
+    // REDUCTION: fixed-order sums, so statistics reproduce bit for bit.
+    stats.min = stats.max = values[0];
+    for (double value : values) {
+        stats.min = std::min(stats.min, value);
+        stats.max = std::max(stats.max, value);
+    }
+    stats.mean = reduceSum(values.data(), count, config.reduction) / static_cast<double>(count);
+    std::vector<double> squares(count);
+    for (size_t i = 0; i < count; i++) {
+        squares[i] = (values[i] - stats.mean) * (values[i] - stats.mean);
+    }
+    stats.variance = reduceSum(squares.data(), count, config.reduction) / static_cast<double>(count);
+
+    if (histogram_bins > 0) {
+        // Halved bounds keep max - min finite even for values near +-DBL_MAX; the
+        // power-of-two scale does not change which bin a value falls in
+        const double low = stats.min * 0.5;
+        const double range = stats.max * 0.5 - low;
+        for (double value : values) {
+            size_t bin = range > 0.0 ? static_cast<size_t>((value * 0.5 - low) / range * histogram_bins) : 0;
+            stats.histogram[std::min(bin, histogram_bins - 1)]++;
+        }
+    }
+    return stats;
+}
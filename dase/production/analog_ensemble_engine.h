@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "analog_universal_node_engine.h"
+
+// Per-instance quantity reduced by EnsembleEngine::getStatistics
+enum class EnsembleObservable : uint8_t {
+    FinalOutput = 0,  // Observed node output after the last step
+    MeanOutput = 1,   // Time average of the observed node output
+    PeakOutput = 2    // Largest |output| of the observed node
+};
+
+// Reduced statistics over all instances (population variance)
+struct EnsembleStats {
+    size_t instances = 0;
+    size_t non_finite = 0;            // NaN or infinite values, left out of everything below
+    double mean = 0.0;
+    double variance = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    std::vector<uint64_t> histogram;  // Equal-width bins over [min, max]
+};
+
+// ENSEMBLE: N copies of one patched circuit stepped side by side.
+// State is stored [node][instance], so each node's instances are contiguous
+// and one SIMD lane block covers eight instances of the same node. Workers
+// own whole instance blocks and run every step for them without syncing,
+// so throughput scales with cores instead of with circuit size.
+// Every instance is driven by sin(frequency * t) and has its own frequency
+// and feedback gain; only reduced statistics leave the engine.
+// Like AnalogCellularEngine, an ensemble shares no mutable state with others.
+class EnsembleEngine {
+public:
+    EnsembleEngine(const AnalogCircuitGraph& circuit, size_t num_instances,
+                   const AnalogEngineConfig& engine_config = AnalogEngineConfig());
+
+    // Per-instance parameters (return false for out-of-range instances)
+    bool setInstanceFeedback(size_t instance, double feedback_gain);
+    bool setInstanceFrequency(size_t instance, double frequency);
+
+    // PARAMETER SWEEP: Spread values linearly from first to last across instances
+    void sweepFeedback(double first, double last);
+    void sweepFrequency(double first, double last);
+    // MONTE CARLO: Feedback drawn uniformly from [center - spread, center + spread]
+    void randomizeFeedback(double center, double spread, uint64_t seed);
+
+    // Node whose output feeds the per-instance observables (default: last node)
+    bool setObservedNode(uint32_t node);
+
+    // Clear node state, observables and the time base; parameters are kept
+    void reset();
+
+    // Advance every instance by `steps` steps of `time_step` (the sweep time base)
+    void run(size_t steps, double time_step = 0.001);
+
+    EnsembleStats getStatistics(EnsembleObservable observable = EnsembleObservable::FinalOutput,
+                                size_t histogram_bins = 32) const;
+    double getInstanceValue(EnsembleObservable observable, size_t instance) const;
+
+    size_t getInstanceCount() const { return instance_count; }
+    size_t getNodeCount() const { return graph.getNodeCount(); }
+    size_t getThreadCount() const { return pool->getThreadCount(); }
+    const AnalogCircuitGraph& getCircuit() const { return graph; }
+    double getTime() const { return clock.now(); }
+
+private:
+    // Lane pointers for node v; lane index = instance
+    AnalogLaneState laneStateFor(uint32_t v) const;
+    void runInstanceBlock(size_t first, size_t count, size_t steps);
+
+    AnalogCircuitGraph graph;
+    size_t instance_count = 0;
+    size_t stride = 0;                     // Instances padded to whole lane blocks
+    AnalogNodeStorage state;               // graph nodes * stride, [node][instance]
+    std::vector<double> latch;             // Delay-edge outputs, same layout as state
+
+    std::vector<double> frequency;         // Per instance
+    std::vector<double> feedback;          // Per instance (mirrored into every node's lane)
+    std::vector<double> phase_cos;         // Drive phasor (cos, sin of frequency * t)
+    std::vector<double> phase_sin;
+    std::vector<double> rotate_cos;        // Per-step phasor rotation for the current run
+    std::vector<double> rotate_sin;
+
+    uint32_t observed_node = 0;
+    std::vector<double> observed_sum;      // Per instance
+    std::vector<double> observed_peak;
+    uint64_t steps_run = 0;
+    SimulationClock clock;                 // Drive time base, one per ensemble
+
+    AnalogEngineConfig config;
+    std::unique_ptr<EngineThreadPool> pool;
+};
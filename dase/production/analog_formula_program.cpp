@@ -0,0 +1,806 @@
+#include "analog_formula_program.h"
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(DASE_ENABLE_FORMULA_NATIVE) && !defined(_WIN32)
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
+static const uint32_t kNoSlot = UINT32_MAX;
+
+// LIMITS: Sheets arrive over HTTP, so size is bounded before any work is done.
+// Signs, parentheses and call arguments nest through FormulaParser::unary(); the
+// emitter and the dependency walk use explicit stacks, so long operator chains
+// cost memory, not call depth.
+static const int kMaxFormulaDepth = 256;
+static const size_t kMaxFormulaLength = size_t(1) << 16;     // Characters per formula
+static const size_t kMaxFormulaNodes = size_t(1) << 22;      // DAG nodes over all cells
+
+static bool isUnary(FormulaOp op) {
+    return op == FormulaOp::Neg || op == FormulaOp::Abs || op == FormulaOp::Sin ||
+           op == FormulaOp::Cos || op == FormulaOp::Diff || op == FormulaOp::Move;
+}
+
+static bool isCommutative(FormulaOp op) {
+    return op == FormulaOp::Add || op == FormulaOp::Mul || op == FormulaOp::Min || op == FormulaOp::Max;
+}
+
+// Pure operations on two values, shared by the interpreter and constant folding
+static double applyPure(FormulaOp op, double x, double y) {
+    switch (op) {
+        case FormulaOp::Move: return x;
+        case FormulaOp::Add: return x + y;
+        case FormulaOp::Sub: return x - y;
+        case FormulaOp::Mul: return x * y;
+        case FormulaOp::Div: return x / y;
+        case FormulaOp::Neg: return -x;
+        case FormulaOp::Min: return x < y ? x : y;
+        case FormulaOp::Max: return x > y ? x : y;
+        case FormulaOp::Abs: return std::fabs(x);
+        case FormulaOp::Sin: return std::sin(x);
+        case FormulaOp::Cos: return std::cos(x);
+        default: return 0.0;
+    }
+}
+
+// One instruction; the interpreter loop and incremental recalculation both use it
+static inline void execute(const FormulaInstruction& in, double* r, double dt, double inv_dt) {
+    switch (in.op) {
+        case FormulaOp::Move: r[in.dst] = r[in.a]; break;
+        case FormulaOp::Add: r[in.dst] = r[in.a] + r[in.b]; break;
+        case FormulaOp::Sub: r[in.dst] = r[in.a] - r[in.b]; break;
+        case FormulaOp::Mul: r[in.dst] = r[in.a] * r[in.b]; break;
+        case FormulaOp::Div: r[in.dst] = r[in.a] / r[in.b]; break;
+        case FormulaOp::Neg: r[in.dst] = -r[in.a]; break;
+        case FormulaOp::Min: r[in.dst] = r[in.a] < r[in.b] ? r[in.a] : r[in.b]; break;
+        case FormulaOp::Max: r[in.dst] = r[in.a] > r[in.b] ? r[in.a] : r[in.b]; break;
+        case FormulaOp::Abs: r[in.dst] = std::fabs(r[in.a]); break;
+        case FormulaOp::Sin: r[in.dst] = std::sin(r[in.a]); break;
+        case FormulaOp::Cos: r[in.dst] = std::cos(r[in.a]); break;
+        case FormulaOp::Diff: {
+            const double x = r[in.a];
+            r[in.dst] = (x - r[in.b]) * inv_dt;
+            r[in.b] = x;
+            break;
+        }
+        case FormulaOp::Integrate: r[in.dst] += r[in.a] * r[in.b] * dt; break;
+    }
+}
+
+// ============================================================================
+// DAG: Hash-consed expression nodes. A node is created once per distinct
+// (kind, operands) so sharing falls out of construction; folding happens there too.
+// ============================================================================
+
+struct FormulaNode {
+    enum class Kind : uint8_t { Literal, Cell, Input, Time, Apply } kind;
+    FormulaOp op;
+    uint32_t a;          // Apply: operand nodes; Cell: cell index
+    uint32_t b;
+    double value;        // Literal
+};
+
+struct FormulaNodeKey {
+    uint64_t bits;
+    uint32_t a;
+    uint32_t b;
+    uint16_t tag;
+
+    bool operator==(const FormulaNodeKey& other) const {
+        return bits == other.bits && a == other.a && b == other.b && tag == other.tag;
+    }
+};
+
+struct FormulaNodeKeyHash {
+    size_t operator()(const FormulaNodeKey& key) const {
+        uint64_t h = key.bits * 0x9E3779B97F4A7C15ull;
+        h ^= (static_cast<uint64_t>(key.a) << 32 | key.b) + 0x632BE59BD9B4E019ull + (h << 6) + (h >> 2);
+        h ^= key.tag + (h << 6) + (h >> 2);
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+};
+
+struct FormulaDag {
+    std::vector<FormulaNode> nodes;
+    std::unordered_map<FormulaNodeKey, uint32_t, FormulaNodeKeyHash> interned;
+    size_t folded = 0;
+    size_t shared = 0;
+
+    uint32_t intern(const FormulaNode& node) {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &node.value, sizeof(bits));
+        const FormulaNodeKey key{bits, node.a, node.b,
+                                 static_cast<uint16_t>(static_cast<unsigned>(node.kind) << 8 | static_cast<unsigned>(node.op))};
+        auto found = interned.find(key);
+        if (found != interned.end()) {
+            if (node.kind == FormulaNode::Kind::Apply) shared++;
+            return found->second;
+        }
+        const uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(node);
+        interned.emplace(key, index);
+        return index;
+    }
+
+    uint32_t literal(double value) {
+        if (value == 0.0) value = 0.0;  // -0.0 and 0.0 share a slot
+        return intern({FormulaNode::Kind::Literal, FormulaOp::Move, 0, 0, value});
+    }
+    uint32_t leaf(FormulaNode::Kind kind, uint32_t cell = 0) { return intern({kind, FormulaOp::Move, cell, 0, 0.0}); }
+
+    bool isLiteral(uint32_t n, double value) const {
+        return nodes[n].kind == FormulaNode::Kind::Literal && nodes[n].value == value;
+    }
+
+    uint32_t apply(FormulaOp op, uint32_t a, uint32_t b = 0) {
+        const bool unary = isUnary(op);
+        const bool stateful = op == FormulaOp::Diff || op == FormulaOp::Integrate;
+        if (!stateful) {
+            const bool literal_a = nodes[a].kind == FormulaNode::Kind::Literal;
+            const bool literal_b = unary || nodes[b].kind == FormulaNode::Kind::Literal;
+            if (literal_a && literal_b) {
+                folded++;
+                return literal(applyPure(op, nodes[a].value, unary ? 0.0 : nodes[b].value));
+            }
+            // Identities that cannot change a finite or infinite operand
+            if ((op == FormulaOp::Add && isLiteral(b, 0.0)) || (op == FormulaOp::Sub && isLiteral(b, 0.0)) ||
+                (op == FormulaOp::Mul && isLiteral(b, 1.0)) || (op == FormulaOp::Div && isLiteral(b, 1.0))) {
+                folded++;
+                return a;
+            }
+            if ((op == FormulaOp::Add && isLiteral(a, 0.0)) || (op == FormulaOp::Mul && isLiteral(a, 1.0))) {
+                folded++;
+                return b;
+            }
+            if (op == FormulaOp::Neg && nodes[a].kind == FormulaNode::Kind::Apply && nodes[a].op == FormulaOp::Neg) {
+                folded++;
+                return nodes[a].a;
+            }
+            if (isCommutative(op) && b < a) std::swap(a, b);
+        }
+        return intern({FormulaNode::Kind::Apply, op, a, unary ? 0u : b, 0.0});
+    }
+};
+
+// ============================================================================
+// PARSER: Recursive descent over one formula, producing DAG nodes
+// ============================================================================
+
+struct FormulaParser {
+    const std::string& text;
+    size_t pos;
+    FormulaDag& dag;
+    const std::unordered_map<std::string, uint32_t>& cells;
+    const std::vector<uint8_t>& empty_cells;
+    std::string message;
+    int depth = 0;
+
+    bool fail(const std::string& reason) {
+        if (message.empty()) message = reason + " at column " + std::to_string(pos + 1);
+        return false;
+    }
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+    }
+
+    bool accept(char c) {
+        skipSpace();
+        if (pos < text.size() && text[pos] == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool expression(uint32_t& out) {
+        if (!term(out)) return false;
+        for (;;) {
+            const bool plus = accept('+');
+            if (!plus && !accept('-')) return true;
+            uint32_t rhs;
+            if (!term(rhs)) return false;
+            out = dag.apply(plus ? FormulaOp::Add : FormulaOp::Sub, out, rhs);
+        }
+    }
+
+    bool term(uint32_t& out) {
+        if (!unary(out)) return false;
+        for (;;) {
+            const bool times = accept('*');
+            if (!times && !accept('/')) return true;
+            uint32_t rhs;
+            if (!unary(rhs)) return false;
+            out = dag.apply(times ? FormulaOp::Mul : FormulaOp::Div, out, rhs);
+        }
+    }
+
+    bool unary(uint32_t& out) {
+        if (depth >= kMaxFormulaDepth) return fail("formula nested too deep");
+        depth++;
+        const bool parsed = signedPrimary(out);
+        depth--;
+        return parsed;
+    }
+
+    bool signedPrimary(uint32_t& out) {
+        if (accept('-')) {
+            if (!unary(out)) return false;
+            out = dag.apply(FormulaOp::Neg, out);
+            return true;
+        }
+        if (accept('+')) return unary(out);
+        return primary(out);
+    }
+
+    bool primary(uint32_t& out) {
+        skipSpace();
+        if (pos >= text.size()) return fail("unexpected end of formula");
+        if (accept('(')) {
+            if (!expression(out)) return false;
+            return accept(')') || fail("expected ')'");
+        }
+        const char c = text[pos];
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            char* end = nullptr;
+            const double value = std::strtod(text.c_str() + pos, &end);
+            if (end == text.c_str() + pos || !std::isfinite(value)) return fail("malformed number");
+            pos = static_cast<size_t>(end - text.c_str());
+            out = dag.literal(value);
+            return true;
+        }
+        if (!std::isalpha(static_cast<unsigned char>(c)) && c != '_') return fail(std::string("unexpected '") + c + "'");
+
+        const size_t start = pos;
+        while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_')) pos++;
+        const std::string name = text.substr(start, pos - start);
+        if (accept('(')) return call(name, out);
+
+        // Cell reference; empty and missing cells contribute 0
+        auto found = cells.find(name);
+        out = (found == cells.end() || empty_cells[found->second]) ? dag.literal(0.0)
+                                                                   : dag.leaf(FormulaNode::Kind::Cell, found->second);
+        return true;
+    }
+
+    bool call(std::string name, uint32_t& out) {
+        for (char& c : name) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        std::vector<uint32_t> args;
+        if (!accept(')')) {
+            do {
+                uint32_t arg;
+                if (!expression(arg)) return false;
+                args.push_back(arg);
+            } while (accept(','));
+            if (!accept(')')) return fail("expected ')' after the arguments of " + name);
+        }
+
+        auto arity = [&](size_t low, size_t high) {
+            if (args.size() >= low && args.size() <= high) return true;
+            if (high == SIZE_MAX) return fail(name + " needs at least " + std::to_string(low) + " argument");
+            return fail(name + " takes " + std::to_string(low) + (low == high ? "" : "-" + std::to_string(high)) +
+                        " argument" + (high == 1 ? "" : "s"));
+        };
+        auto fold = [&](FormulaOp op) {
+            out = args[0];
+            for (size_t i = 1; i < args.size(); i++) out = dag.apply(op, out, args[i]);
+            return true;
+        };
+
+        if (name == "AMP") return arity(2, 2) && (out = dag.apply(FormulaOp::Mul, args[0], args[1]), true);
+        if (name == "SUMMER" || name == "SUM") return arity(1, SIZE_MAX) && fold(FormulaOp::Add);
+        if (name == "MIN") return arity(1, SIZE_MAX) && fold(FormulaOp::Min);
+        if (name == "MAX") return arity(1, SIZE_MAX) && fold(FormulaOp::Max);
+        if (name == "SIN") return arity(1, 1) && (out = dag.apply(FormulaOp::Sin, args[0]), true);
+        if (name == "COS") return arity(1, 1) && (out = dag.apply(FormulaOp::Cos, args[0]), true);
+        if (name == "ABS") return arity(1, 1) && (out = dag.apply(FormulaOp::Abs, args[0]), true);
+        if (name == "SQUARE") return arity(1, 1) && (out = dag.apply(FormulaOp::Mul, args[0], args[0]), true);
+        if (name == "DERIVATIVE" || name == "DIFF") return arity(1, 1) && (out = dag.apply(FormulaOp::Diff, args[0]), true);
+        if (name == "INTEGRATE") {
+            if (!arity(1, 2)) return false;
+            out = dag.apply(FormulaOp::Integrate, args[0], args.size() > 1 ? args[1] : dag.literal(1.0));
+            return true;
+        }
+        if (name == "INPUT") return arity(0, 0) && (out = dag.leaf(FormulaNode::Kind::Input), true);
+        if (name == "TIME") return arity(0, 0) && (out = dag.leaf(FormulaNode::Kind::Time), true);
+        return fail("unknown function " + name);
+    }
+};
+
+// ============================================================================
+// EMITTER: Slot allocation and linear code in dependency order
+// ============================================================================
+
+struct FormulaEmitter {
+    const FormulaDag& dag;
+    std::vector<uint32_t> slots;               // Per DAG node, kNoSlot until emitted
+    std::vector<double>& registers;
+    std::vector<FormulaInstruction>& code;
+    uint32_t input_slot;
+    uint32_t time_slot;
+    std::vector<uint32_t> integrators;         // Integrate nodes in slot order
+
+    uint32_t allocate(double initial = 0.0) {
+        registers.push_back(initial);
+        return static_cast<uint32_t>(registers.size() - 1);
+    }
+
+    struct Frame {
+        uint32_t node;
+        bool expanded;           // Operands already pushed
+    };
+    std::vector<Frame> stack;
+
+    // Post-order over the operands of `root`, operand a before b, from an explicit
+    // stack: a left-deep chain like =A1+A2+...+An is as deep as it is long. Only the
+    // root's result goes to `dst`. Integrator nodes only get their state slot here;
+    // the update is issued later.
+    uint32_t emit(uint32_t root, uint32_t dst = kNoSlot) {
+        stack.assign(1, {root, false});
+        while (!stack.empty()) {
+            const uint32_t n = stack.back().node;
+            if (slots[n] != kNoSlot) {
+                stack.pop_back();
+                continue;
+            }
+            const FormulaNode& node = dag.nodes[n];
+            if (node.kind != FormulaNode::Kind::Apply || node.op == FormulaOp::Integrate) {
+                switch (node.kind) {
+                    case FormulaNode::Kind::Literal: slots[n] = allocate(node.value); break;
+                    case FormulaNode::Kind::Cell: slots[n] = node.a; break;
+                    case FormulaNode::Kind::Input: slots[n] = input_slot; break;
+                    case FormulaNode::Kind::Time: slots[n] = time_slot; break;
+                    case FormulaNode::Kind::Apply:
+                        integrators.push_back(n);
+                        slots[n] = allocate();
+                        break;
+                }
+                stack.pop_back();
+                continue;
+            }
+            if (!stack.back().expanded) {
+                stack.back().expanded = true;
+                if (!isUnary(node.op) && node.op != FormulaOp::Diff) stack.push_back({node.b, false});
+                stack.push_back({node.a, false});
+                continue;
+            }
+            const uint32_t a = slots[node.a];
+            const uint32_t b = node.op == FormulaOp::Diff ? allocate() : (isUnary(node.op) ? 0u : slots[node.b]);
+            slots[n] = (n == root && dst != kNoSlot) ? dst : allocate();
+            code.push_back({node.op, slots[n], a, b});
+            stack.pop_back();
+        }
+        return slots[root];
+    }
+};
+
+// ============================================================================
+// PROGRAM
+// ============================================================================
+
+FormulaProgram::~FormulaProgram() {
+    releaseNative();
+}
+
+void FormulaProgram::clear() {
+    releaseNative();
+    cell_count = 0;
+    input_slot = 0;
+    time_slot = 1;
+    cell_ids.clear();
+    cell_kinds.clear();
+    cell_index.clear();
+    registers.assign(2, 0.0);
+    state_slots.clear();
+    code.clear();
+    static_code.clear();
+    static_reader_offsets.clear();
+    static_readers.clear();
+    dirty.clear();
+    queued.clear();
+    folded_count = shared_count = 0;
+    steps_run = 0;
+    layout_hash = 0;
+    last_recalc = 0;
+}
+
+bool FormulaProgram::compile(const std::vector<FormulaCell>& cells, std::string* error) {
+    clear();
+    auto reject = [&](const std::string& cell, const std::string& reason) {
+        if (error) *error = "cell " + cell + ": " + reason;
+        clear();
+        return false;
+    };
+
+    // Classify cells; numeric cells keep their value as an input slot
+    cell_count = cells.size();
+    cell_kinds.resize(cell_count, CellKind::Empty);
+    std::vector<double> cell_values(cell_count, 0.0);
+    std::vector<uint8_t> empty_cells(cell_count, 1);
+    for (size_t i = 0; i < cell_count; i++) {
+        if (!cell_index.emplace(cells[i].id, static_cast<uint32_t>(i)).second) return reject(cells[i].id, "duplicate cell");
+        cell_ids.push_back(cells[i].id);
+        const std::string& text = cells[i].text;
+        const size_t first = text.find_first_not_of(" \t");
+        if (first == std::string::npos) continue;
+        if (text[first] == '=') {
+            cell_kinds[i] = CellKind::Formula;
+            empty_cells[i] = 0;
+            continue;
+        }
+        char* end = nullptr;
+        const double value = std::strtod(text.c_str() + first, &end);
+        if (end != text.c_str() + first && std::isfinite(value) &&
+            text.find_first_not_of(" \t", static_cast<size_t>(end - text.c_str())) == std::string::npos) {
+            cell_kinds[i] = CellKind::Number;
+            cell_values[i] = value;
+            empty_cells[i] = 0;
+        }
+    }
+
+    // Parse every formula into the shared DAG
+    FormulaDag dag;
+    std::vector<uint32_t> roots(cell_count, kNoSlot);
+    for (size_t i = 0; i < cell_count; i++) {
+        if (cell_kinds[i] != CellKind::Formula) continue;
+        const std::string& text = cells[i].text;
+        if (text.size() > kMaxFormulaLength) {
+            return reject(cells[i].id, "formula longer than " + std::to_string(kMaxFormulaLength) + " characters");
+        }
+        FormulaParser parser{text, text.find('=') + 1, dag, cell_index, empty_cells, std::string()};
+        if (!parser.expression(roots[i])) return reject(cells[i].id, parser.message);
+        if (dag.nodes.size() > kMaxFormulaNodes) return reject(cells[i].id, "sheet has too many distinct expressions");
+        parser.skipSpace();
+        if (parser.pos != text.size()) {
+            parser.fail("unexpected '" + std::string(1, text[parser.pos]) + "'");
+            return reject(cells[i].id, parser.message);
+        }
+    }
+
+    // Algebraic dependencies between formula cells; integrator operands do not
+    // count (an integrator's output is last step's state)
+    std::vector<std::vector<uint32_t>> dependents(cell_count);
+    std::vector<uint32_t> pending(cell_count, 0);
+    std::vector<uint32_t> visited(dag.nodes.size(), kNoSlot);
+    std::vector<uint32_t> stack;
+    for (uint32_t i = 0; i < cell_count; i++) {
+        if (roots[i] == kNoSlot) continue;
+        stack.assign(1, roots[i]);
+        while (!stack.empty()) {
+            const uint32_t n = stack.back();
+            stack.pop_back();
+            if (visited[n] == i) continue;
+            visited[n] = i;
+            const FormulaNode& node = dag.nodes[n];
+            if (node.kind == FormulaNode::Kind::Cell) {
+                if (cell_kinds[node.a] == CellKind::Formula) {
+                    dependents[node.a].push_back(i);
+                    pending[i]++;
+                }
+            } else if (node.kind == FormulaNode::Kind::Apply) {
+                if (node.op == FormulaOp::Integrate) continue;
+                stack.push_back(node.a);
+                if (!isUnary(node.op)) stack.push_back(node.b);
+            }
+        }
+    }
+
+    // Kahn order over formula cells; leftovers sit on an algebraic loop
+    std::vector<uint32_t> order;
+    for (uint32_t i = 0; i < cell_count; i++) {
+        if (roots[i] != kNoSlot && pending[i] == 0) order.push_back(i);
+    }
+    for (size_t head = 0; head < order.size(); head++) {
+        for (uint32_t next : dependents[order[head]]) {
+            if (--pending[next] == 0) order.push_back(next);
+        }
+    }
+    for (uint32_t i = 0; i < cell_count; i++) {
+        if (roots[i] != kNoSlot && pending[i] != 0) {
+            return reject(cell_ids[i], "circular reference (close the loop through INTEGRATE)");
+        }
+    }
+
+    // Slots: cells, INPUT and TIME, then everything the emitter allocates
+    registers = cell_values;
+    input_slot = static_cast<uint32_t>(registers.size());
+    time_slot = input_slot + 1;
+    registers.push_back(0.0);
+    registers.push_back(0.0);
+    FormulaEmitter emitter{dag, std::vector<uint32_t>(dag.nodes.size(), kNoSlot), registers, code, input_slot, time_slot, {}, {}};
+
+    for (uint32_t i : order) {
+        const uint32_t root = roots[i];
+        const FormulaNode& node = dag.nodes[root];
+        const bool computed_here = node.kind == FormulaNode::Kind::Apply && node.op != FormulaOp::Integrate &&
+                                   emitter.slots[root] == kNoSlot;
+        // The root's result lands directly in the cell's slot when this cell computes it
+        const uint32_t result = emitter.emit(root, computed_here ? i : kNoSlot);
+        if (result != i) code.push_back({FormulaOp::Move, i, result, 0});
+    }
+
+    // Integrator updates go last: operands first (they may read other integrators'
+    // pre-step state, and may add integrators to the list), then every accumulation
+    std::vector<FormulaInstruction> updates;
+    for (size_t i = 0; i < emitter.integrators.size(); i++) {
+        const uint32_t n = emitter.integrators[i];
+        const uint32_t x = emitter.emit(dag.nodes[n].a);
+        const uint32_t k = emitter.emit(dag.nodes[n].b);
+        updates.push_back({FormulaOp::Integrate, emitter.slots[n], x, k});
+    }
+    code.insert(code.end(), updates.begin(), updates.end());
+
+    folded_count = dag.folded;
+    shared_count = dag.shared;
+    splitStatic();
+
+    layout_hash = 1469598103934665603ull;
+    auto mix = [&](const std::string& text) {
+        for (unsigned char c : text) layout_hash = (layout_hash ^ c) * 1099511628211ull;
+        layout_hash = (layout_hash ^ 0xFFu) * 1099511628211ull;
+    };
+    for (size_t i = 0; i < cell_count; i++) {
+        mix(cell_ids[i]);
+        mix(cell_kinds[i] == CellKind::Formula ? cells[i].text : std::string(1, static_cast<char>('0' + static_cast<int>(cell_kinds[i]))));
+    }
+    return true;
+}
+
+// Move everything that cannot change between steps out of the per-step stream,
+// evaluate it once, and index its readers for incremental recalculation
+void FormulaProgram::splitStatic() {
+    std::vector<uint8_t> dynamic(registers.size(), 0);
+    dynamic[input_slot] = dynamic[time_slot] = 1;
+    for (const FormulaInstruction& in : code) {
+        if (in.op == FormulaOp::Integrate) {
+            dynamic[in.dst] = 1;
+            state_slots.push_back(in.dst);
+        } else if (in.op == FormulaOp::Diff) {
+            state_slots.push_back(in.b);
+        }
+    }
+    std::vector<FormulaInstruction> per_step;
+    for (const FormulaInstruction& in : code) {
+        const bool is_dynamic = in.op == FormulaOp::Diff || in.op == FormulaOp::Integrate || dynamic[in.a] ||
+                                (!isUnary(in.op) && dynamic[in.b]);
+        if (is_dynamic) {
+            dynamic[in.dst] = 1;
+            per_step.push_back(in);
+        } else {
+            static_code.push_back(in);
+        }
+    }
+    code.swap(per_step);
+
+    double* r = registers.data();
+    for (const FormulaInstruction& in : static_code) execute(in, r, 0.0, 0.0);
+
+    // CSR, counted then filled
+    static_reader_offsets.assign(registers.size() + 1, 0);
+    for (const FormulaInstruction& in : static_code) {
+        static_reader_offsets[in.a + 1]++;
+        if (!isUnary(in.op) && in.b != in.a) static_reader_offsets[in.b + 1]++;
+    }
+    for (size_t slot = 0; slot < registers.size(); slot++) static_reader_offsets[slot + 1] += static_reader_offsets[slot];
+    static_readers.resize(static_reader_offsets.back());
+    std::vector<uint32_t> fill(static_reader_offsets.begin(), static_reader_offsets.end() - 1);
+    for (uint32_t j = 0; j < static_code.size(); j++) {
+        const FormulaInstruction& in = static_code[j];
+        static_readers[fill[in.a]++] = j;
+        if (!isUnary(in.op) && in.b != in.a) static_readers[fill[in.b]++] = j;
+    }
+    queued.assign(static_code.size(), 0);
+}
+
+void FormulaProgram::markReaders(uint32_t slot) {
+    for (uint32_t k = static_reader_offsets[slot]; k < static_reader_offsets[slot + 1]; k++) {
+        const uint32_t j = static_readers[k];
+        if (queued[j]) continue;
+        queued[j] = 1;
+        dirty.push_back(j);
+        std::push_heap(dirty.begin(), dirty.end(), std::greater<uint32_t>());
+    }
+}
+
+size_t FormulaProgram::recalculate() {
+    // Instruction order is a topological order, so the smallest dirty index is
+    // always safe to evaluate next
+    double* r = registers.data();
+    size_t evaluated = 0;
+    while (!dirty.empty()) {
+        std::pop_heap(dirty.begin(), dirty.end(), std::greater<uint32_t>());
+        const uint32_t j = dirty.back();
+        dirty.pop_back();
+        queued[j] = 0;
+        const FormulaInstruction& in = static_code[j];
+        const double before = r[in.dst];
+        execute(in, r, 0.0, 0.0);
+        evaluated++;
+        if (std::memcmp(&before, &r[in.dst], sizeof(double)) != 0) markReaders(in.dst);  // Early cutoff
+    }
+    last_recalc = evaluated;
+    return evaluated;
+}
+
+void FormulaProgram::interpret(double dt) {
+    double* r = registers.data();
+    const double inv_dt = dt > 0.0 ? 1.0 / dt : 0.0;
+    for (const FormulaInstruction& in : code) execute(in, r, dt, inv_dt);
+}
+
+void FormulaProgram::step(double dt) {
+    if (!dirty.empty()) recalculate();
+    if (native_kernel) {
+        native_kernel(registers.data(), dt);
+    } else {
+        interpret(dt);
+    }
+    steps_run++;
+}
+
+void FormulaProgram::reset() {
+    for (uint32_t slot : state_slots) registers[slot] = 0.0;
+    steps_run = 0;
+}
+
+bool FormulaProgram::setValue(size_t cell, double value) {
+    if (cell >= cell_count || cell_kinds[cell] != CellKind::Number) return false;
+    if (std::memcmp(&registers[cell], &value, sizeof(double)) == 0) return true;
+    registers[cell] = value;
+    markReaders(static_cast<uint32_t>(cell));
+    return true;
+}
+
+int FormulaProgram::findCell(const std::string& id) const {
+    auto found = cell_index.find(id);
+    return found == cell_index.end() ? -1 : static_cast<int>(found->second);
+}
+
+// ============================================================================
+// NATIVE: C source for the program and an on-disk kernel cache
+// ============================================================================
+
+// Straight-line code is split into fixed-size functions: compile time grows far
+// faster than linearly with function size, and the call overhead is negligible
+static const size_t kNativeChunk = 256;
+
+static uint64_t sourceHash(const std::string& source) {
+    uint64_t hash = 1469598103934665603ull;  // FNV-1a
+    for (unsigned char c : source) hash = (hash ^ c) * 1099511628211ull;
+    return hash;
+}
+
+static std::string hexHash(uint64_t hash) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+    return text;
+}
+
+std::string FormulaProgram::emitC() const {
+    const std::string kernel = emitKernel();
+    return kernel + "const unsigned long long dase_formula_source_hash = 0x" + hexHash(sourceHash(kernel)) + "ull;\n";
+}
+
+std::string FormulaProgram::emitKernel() const {
+    static const char* const kBinary[] = {nullptr, " + ", " - ", " * ", " / "};
+    std::ostringstream out;
+    out << "#include <math.h>\n";
+    const size_t chunks = (code.size() + kNativeChunk - 1) / kNativeChunk;
+    for (size_t i = 0; i < code.size(); i++) {
+        const FormulaInstruction& in = code[i];
+        if (i % kNativeChunk == 0) {
+            out << "static void dase_formula_part" << i / kNativeChunk << "(double* r, double dt, double inv_dt) {\n"
+                << "    (void)dt;\n    (void)inv_dt;\n";
+        }
+        const std::string d = "r[" + std::to_string(in.dst) + "]";
+        const std::string a = "r[" + std::to_string(in.a) + "]";
+        const std::string b = "r[" + std::to_string(in.b) + "]";
+        out << "    ";
+        switch (in.op) {
+            case FormulaOp::Move: out << d << " = " << a << ";"; break;
+            case FormulaOp::Add:
+            case FormulaOp::Sub:
+            case FormulaOp::Mul:
+            case FormulaOp::Div: out << d << " = " << a << kBinary[static_cast<int>(in.op)] << b << ";"; break;
+            case FormulaOp::Neg: out << d << " = -" << a << ";"; break;
+            case FormulaOp::Min: out << d << " = " << a << " < " << b << " ? " << a << " : " << b << ";"; break;
+            case FormulaOp::Max: out << d << " = " << a << " > " << b << " ? " << a << " : " << b << ";"; break;
+            case FormulaOp::Abs: out << d << " = fabs(" << a << ");"; break;
+            case FormulaOp::Sin: out << d << " = sin(" << a << ");"; break;
+            case FormulaOp::Cos: out << d << " = cos(" << a << ");"; break;
+            case FormulaOp::Diff: out << "{ const double x = " << a << "; " << d << " = (x - " << b << ") * inv_dt; " << b << " = x; }"; break;
+            case FormulaOp::Integrate: out << d << " += " << a << " * " << b << " * dt;"; break;
+        }
+        out << "\n";
+        if (i % kNativeChunk == kNativeChunk - 1 || i + 1 == code.size()) out << "}\n";
+    }
+    out << "void dase_formula_kernel(double* r, double dt) {\n"
+        << "    const double inv_dt = dt > 0.0 ? 1.0 / dt : 0.0;\n";
+    for (size_t c = 0; c < chunks; c++) out << "    dase_formula_part" << c << "(r, dt, inv_dt);\n";
+    out << "    (void)inv_dt;\n}\n";
+    return out.str();
+}
+
+void FormulaProgram::releaseNative() {
+    native_kernel = nullptr;
+#if defined(DASE_ENABLE_FORMULA_NATIVE) && !defined(_WIN32)
+    if (native_library) dlclose(native_library);
+#endif
+    native_library = nullptr;
+}
+
+bool FormulaProgram::buildNative(const std::string& source, const std::string& cache_dir, std::string& library,
+                                 std::string* error) {
+#if defined(DASE_ENABLE_FORMULA_NATIVE) && !defined(_WIN32)
+    auto reject = [&](const std::string& reason) {
+        if (error) *error = reason;
+        return false;
+    };
+    if (cache_dir.find('\'') != std::string::npos) return reject("cache directory must not contain quotes");
+    const std::string name = cache_dir + "/dase_formula_" + hexHash(sourceHash(source));
+    library = name + ".so";
+    if (access(library.c_str(), R_OK) == 0) return true;
+
+    // Build under a per-process name, then rename: concurrent builders never see a partial file
+    const std::string stem = name + "." + std::to_string(getpid());
+    {
+        std::ofstream file(stem + ".c");
+        if (!(file << source)) return reject("cannot write " + stem + ".c");
+    }
+    // -ffp-contract=off keeps results bit-identical to the interpreter
+    const char* compiler = std::getenv("DASE_FORMULA_CC");
+    const std::string command = std::string(compiler ? compiler : "cc") + " -O2 -fPIC -shared -ffp-contract=off -o '" +
+                                stem + ".so' '" + stem + ".c' -lm";
+    const int status = std::system(command.c_str());
+    std::remove((stem + ".c").c_str());
+    if (status != 0 || std::rename((stem + ".so").c_str(), library.c_str()) != 0) {
+        std::remove((stem + ".so").c_str());
+        return reject("native kernel build failed: " + command);
+    }
+    return true;
+#else
+    (void)source;
+    (void)cache_dir;
+    (void)library;
+    if (error) *error = "native formula kernels are not built (DASE_ENABLE_FORMULA_NATIVE)";
+    return false;
+#endif
+}
+
+bool FormulaProgram::loadNative(const std::string& library, std::string* error) {
+#if defined(DASE_ENABLE_FORMULA_NATIVE) && !defined(_WIN32)
+    auto reject = [&](const std::string& reason) {
+        if (error) *error = reason;
+        return false;
+    };
+    void* handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) return reject(std::string("dlopen failed: ") + dlerror());
+    void* symbol = dlsym(handle, "dase_formula_kernel");
+    const void* stamp = dlsym(handle, "dase_formula_source_hash");
+    if (!symbol || !stamp || *static_cast<const unsigned long long*>(stamp) != sourceHash(emitKernel())) {
+        dlclose(handle);
+        return reject(library + " is not a kernel for this program");
+    }
+    releaseNative();
+    native_library = handle;
+    native_kernel = reinterpret_cast<NativeKernel>(symbol);
+    return true;
+#else
+    (void)library;
+    if (error) *error = "native formula kernels are not built (DASE_ENABLE_FORMULA_NATIVE)";
+    return false;
+#endif
+}
+
+bool FormulaProgram::attachNative(const std::string& cache_dir, std::string* error) {
+    std::string library;
+    return buildNative(emitC(), cache_dir, library, error) && loadNative(library, error);
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// FORMULA PROGRAM: Spreadsheet cells compiled to a flat register program.
+// Every cell, literal and intermediate result owns one slot of a dense double
+// array; a recalculation is a single pass over a linear instruction stream, with
+// no string lookups and no virtual dispatch per cell.
+//
+// Cell text, as the UI stores it:
+//   "=AMP(A1, 2) + SIN(B2) * 0.5"   formula cell
+//   "3.25"                          numeric cell (an input, see setValue())
+//   anything else                   empty cell, reads as 0
+// Formulas: + - * / unary minus, parentheses, numbers, cell references and
+//   AMP(x, k) = k*x            SUMMER(a, ...) / SUM(a, ...)   MIN(...)  MAX(...)
+//   SIN(x)  COS(x)  ABS(x)     SQUARE(x) = x*x
+//   INTEGRATE(x[, k])          state += k*x*dt, reads the state before this step
+//   DERIVATIVE(x) / DIFF(x)    (x - x_previous) / dt
+//   INPUT()  TIME()            the host's drive signal and simulation time
+//
+// compile() parses into one hash-consed expression DAG: identical subexpressions
+// (across cells too) share a single slot, operations on literals are folded, and
+// x+0, x*1, x/1 and -(-x) simplify away. Integrator outputs are state, so loops
+// through INTEGRATE are legal; any other circular reference is an error.
+//
+// INCREMENTAL: Instructions that depend on neither INPUT(), TIME() nor integrator
+// or differentiator state are static. They are evaluated once and memoized, and
+// step() runs only the time-dependent rest. A setValue() edit re-evaluates just the
+// static instructions downstream of the edited cell, in dependency order, and stops
+// along any path whose value did not change.
+enum class FormulaOp : uint8_t {
+    Move,       // r[dst] = r[a]
+    Add,        // r[dst] = r[a] + r[b]
+    Sub,
+    Mul,
+    Div,
+    Neg,        // r[dst] = -r[a]
+    Min,
+    Max,
+    Abs,
+    Sin,
+    Cos,
+    Diff,       // r[dst] = (r[a] - r[b]) / dt, then r[b] = r[a]
+    Integrate   // r[dst] += r[a] * r[b] * dt (issued after every cell is computed)
+};
+
+struct FormulaInstruction {
+    FormulaOp op;
+    uint32_t dst;
+    uint32_t a;
+    uint32_t b;
+};
+
+struct FormulaCell {
+    std::string id;      // "A1"
+    std::string text;    // Formula ("=..."), number or empty
+};
+
+class FormulaProgram {
+public:
+    FormulaProgram() = default;
+    ~FormulaProgram();
+    FormulaProgram(const FormulaProgram&) = delete;
+    FormulaProgram& operator=(const FormulaProgram&) = delete;
+
+    // Returns false (with "cell <id>: <reason>" in *error) on a syntax error,
+    // an unknown function, an algebraic circular reference, or a sheet over the size
+    // limits: 64 Ki characters per formula, 256 levels of signs, parentheses and
+    // call arguments, and 4 Mi distinct expressions in total
+    bool compile(const std::vector<FormulaCell>& cells, std::string* error = nullptr);
+    void clear();
+
+    // Pending edits, then one pass of the time-dependent instructions and the integrator update
+    void step(double dt);
+    void reset();                                    // Integrator and differentiator state back to 0
+
+    void setInput(double value) { registers[input_slot] = value; }
+    void setTime(double value) { registers[time_slot] = value; }
+    bool setValue(size_t cell, double value);        // Numeric cells only; marks the dependent cone dirty
+    size_t recalculate();                            // Apply pending edits; returns instructions evaluated
+
+    size_t getCellCount() const { return cell_count; }
+    int findCell(const std::string& id) const;       // -1 if the sheet has no such cell
+    const std::string& getCellId(size_t cell) const { return cell_ids[cell]; }
+    double getValue(size_t cell) const { return registers[cell]; }
+    const double* getValues() const { return registers.data(); }  // Cell i at [i]
+    bool isFormula(size_t cell) const { return cell_kinds[cell] == CellKind::Formula; }
+
+    const std::vector<FormulaInstruction>& getInstructions() const { return code; }          // Per step
+    const std::vector<FormulaInstruction>& getStaticInstructions() const { return static_code; }
+    size_t getRegisterCount() const { return registers.size(); }
+    size_t getLastRecalcCount() const { return last_recalc; }
+    // Hash of cell IDs, kinds and formula text: equal for sheets that differ only in numeric cells
+    uint64_t getLayoutHash() const { return layout_hash; }
+    size_t getFoldedCount() const { return folded_count; }      // Operations removed by folding/identities
+    size_t getSharedCount() const { return shared_count; }      // Subexpressions reused via CSE
+    uint64_t getStepCount() const { return steps_run; }
+
+    // NATIVE: The same program as C source, `void dase_formula_kernel(double* r, double dt)`,
+    // stamped with a hash of itself so a kernel is only ever loaded into its own program
+    std::string emitC() const;
+
+    // Compile `source` with the system C compiler (DASE_FORMULA_CC, default cc) into
+    // `cache_dir`, keyed by its hash so a reloaded sheet reuses its kernel. Touches no
+    // program state: slow builds can run on a background thread. POSIX builds with
+    // DASE_ENABLE_FORMULA_NATIVE only.
+    static bool buildNative(const std::string& source, const std::string& cache_dir, std::string& library,
+                            std::string* error = nullptr);
+    bool loadNative(const std::string& library, std::string* error = nullptr);   // False for another program's kernel
+    bool attachNative(const std::string& cache_dir, std::string* error = nullptr);  // build + load
+    bool hasNative() const { return native_kernel != nullptr; }
+
+private:
+    enum class CellKind : uint8_t { Empty, Number, Formula };
+    using NativeKernel = void (*)(double*, double);
+
+    size_t cell_count = 0;
+    uint32_t input_slot = 0;
+    uint32_t time_slot = 1;
+    std::vector<std::string> cell_ids;
+    std::vector<CellKind> cell_kinds;
+    std::unordered_map<std::string, uint32_t> cell_index;
+
+    // Layout: [cells | INPUT, TIME | literals | temporaries and integrator/diff state]
+    std::vector<double> registers = std::vector<double>(2, 0.0);
+    std::vector<uint32_t> state_slots;               // Cleared by reset()
+    std::vector<FormulaInstruction> code;
+    std::vector<FormulaInstruction> static_code;
+    size_t folded_count = 0;
+    size_t shared_count = 0;
+    uint64_t steps_run = 0;
+    uint64_t layout_hash = 0;
+
+    // Static instructions reading slot s: static_readers[static_reader_offsets[s] .. [s + 1])
+    std::vector<uint32_t> static_reader_offsets;
+    std::vector<uint32_t> static_readers;
+    std::vector<uint32_t> dirty;                     // Min-heap of static instruction indices
+    std::vector<uint8_t> queued;
+    size_t last_recalc = 0;
+
+    NativeKernel native_kernel = nullptr;
+    void* native_library = nullptr;
+
+    void interpret(double dt);
+    void markReaders(uint32_t slot);
+    void splitStatic();
+    void releaseNative();
+    std::string emitKernel() const;
+};
@@ -0,0 +1,86 @@
+#include "analog_node_layout.h"
+#include <algorithm>
+#include <utility>
+
+// Spread the low 21 bits of v so two zero bits follow each one
+static uint64_t splitBy3(uint32_t v) {
+    uint64_t x = v & 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8) & 0x100f00f00f00f00fULL;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2) & 0x1249249249249249ULL;
+    return x;
+}
+
+uint64_t mortonIndex3(uint32_t x, uint32_t y, uint32_t z) {
+    return splitBy3(x) | (splitBy3(y) << 1) | (splitBy3(z) << 2);
+}
+
+// Skilling's transpose form of the Hilbert index ("Programming the Hilbert
+// curve", 2004), then interleaved most significant bit first
+uint64_t hilbertIndex3(uint32_t x, uint32_t y, uint32_t z, int bits) {
+    uint32_t axes[3] = {x, y, z};
+    const uint32_t top = 1u << (bits - 1);
+
+    for (uint32_t q = top; q > 1; q >>= 1) {
+        const uint32_t p = q - 1;
+        for (int i = 0; i < 3; i++) {
+            if (axes[i] & q) {
+                axes[0] ^= p;
+            } else {
+                const uint32_t t = (axes[0] ^ axes[i]) & p;
+                axes[0] ^= t;
+                axes[i] ^= t;
+            }
+        }
+    }
+    for (int i = 1; i < 3; i++) axes[i] ^= axes[i - 1];
+    uint32_t t = 0;
+    for (uint32_t q = top; q > 1; q >>= 1) {
+        if (axes[2] & q) t ^= q - 1;
+    }
+    for (int i = 0; i < 3; i++) axes[i] ^= t;
+
+    uint64_t index = 0;
+    for (int bit = bits - 1; bit >= 0; bit--) {
+        for (int i = 0; i < 3; i++) {
+            index = (index << 1) | ((axes[i] >> bit) & 1u);
+        }
+    }
+    return index;
+}
+
+bool buildNodeOrder(const AnalogLatticeLayout& layout, size_t node_count,
+                    std::vector<uint32_t>& slot_to_id, std::vector<uint32_t>& id_to_slot) {
+    slot_to_id.clear();
+    id_to_slot.clear();
+    if (layout.nx == 0 || layout.ny == 0) return false;
+    if (layout.ordering == NodeOrdering::RowMajor || node_count == 0) return true;
+
+    const size_t plane = static_cast<size_t>(layout.nx) * layout.ny;
+    const size_t nz = std::max<size_t>(layout.nz, (node_count + plane - 1) / plane);
+    const size_t extent = std::max<size_t>({layout.nx, layout.ny, nz});
+    int bits = 1;
+    while ((size_t(1) << bits) < extent) bits++;
+    if (bits > 21) return false;
+
+    std::vector<std::pair<uint64_t, uint32_t>> keyed(node_count);
+    for (size_t id = 0; id < node_count; id++) {
+        const uint32_t x = static_cast<uint32_t>(id % layout.nx);
+        const uint32_t y = static_cast<uint32_t>((id / layout.nx) % layout.ny);
+        const uint32_t z = static_cast<uint32_t>(id / plane);
+        const uint64_t key = layout.ordering == NodeOrdering::Morton ? mortonIndex3(x, y, z)
+                                                                     : hilbertIndex3(x, y, z, bits);
+        keyed[id] = {key, static_cast<uint32_t>(id)};
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    slot_to_id.resize(node_count);
+    id_to_slot.resize(node_count);
+    for (size_t slot = 0; slot < node_count; slot++) {
+        slot_to_id[slot] = keyed[slot].second;
+        id_to_slot[keyed[slot].second] = static_cast<uint32_t>(slot);
+    }
+    return true;
+}
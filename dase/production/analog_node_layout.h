@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Storage order of lattice cells in the engine's SoA arrays
+enum class NodeOrdering : uint8_t {
+    RowMajor = 0,  // x fastest, then y, then z (slot == node ID)
+    Morton = 1,    // Z-order curve: bit-interleaved x/y/z
+    Hilbert = 2    // 3D Hilbert curve: every step moves to a face neighbour
+};
+
+// Lattice geometry for AnalogCellularEngine.
+// Node IDs are always row-major positions, id = x + nx * (y + ny * z); the
+// ordering only decides which storage slot each ID lives in.
+struct AnalogLatticeLayout {
+    uint32_t nx = 10, ny = 10;
+    uint32_t nz = 0;   // 0 (or too few planes) = as many planes as the node count needs
+    NodeOrdering ordering = NodeOrdering::RowMajor;
+};
+
+// Space-filling curve keys for cell (x, y, z); coordinates use the low `bits` bits
+uint64_t mortonIndex3(uint32_t x, uint32_t y, uint32_t z);
+uint64_t hilbertIndex3(uint32_t x, uint32_t y, uint32_t z, int bits);
+
+// SPATIAL ORDER: Sort node IDs [0, node_count) by the layout's curve key.
+// Fills slot_to_id / id_to_slot; both are left empty for RowMajor (identity).
+// Returns false when the layout cannot hold node_count nodes (nx or ny is 0)
+// or too many curve bits are needed per axis (more than 21 bits).
+bool buildNodeOrder(const AnalogLatticeLayout& layout, size_t node_count,
+                    std::vector<uint32_t>& slot_to_id, std::vector<uint32_t>& id_to_slot);
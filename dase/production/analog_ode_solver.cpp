@@ -0,0 +1,176 @@
+#include "analog_ode_solver.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Dormand-Prince 5(4) tableau
+static constexpr double kDpA21 = 1.0 / 5.0;
+static constexpr double kDpA31 = 3.0 / 40.0, kDpA32 = 9.0 / 40.0;
+static constexpr double kDpA41 = 44.0 / 45.0, kDpA42 = -56.0 / 15.0, kDpA43 = 32.0 / 9.0;
+static constexpr double kDpA51 = 19372.0 / 6561.0, kDpA52 = -25360.0 / 2187.0, kDpA53 = 64448.0 / 6561.0,
+                        kDpA54 = -212.0 / 729.0;
+static constexpr double kDpA61 = 9017.0 / 3168.0, kDpA62 = -355.0 / 33.0, kDpA63 = 46732.0 / 5247.0,
+                        kDpA64 = 49.0 / 176.0, kDpA65 = -5103.0 / 18656.0;
+// Fifth-order weights (also the last stage row: FSAL)
+static constexpr double kDpB1 = 35.0 / 384.0, kDpB3 = 500.0 / 1113.0, kDpB4 = 125.0 / 192.0,
+                        kDpB5 = -2187.0 / 6784.0, kDpB6 = 11.0 / 84.0;
+// Fifth minus fourth order weights, for the embedded error estimate
+static constexpr double kDpE1 = 71.0 / 57600.0, kDpE3 = -71.0 / 16695.0, kDpE4 = 71.0 / 1920.0,
+                        kDpE5 = -17253.0 / 339200.0, kDpE6 = 22.0 / 525.0, kDpE7 = -1.0 / 40.0;
+static constexpr double kDpC2 = 1.0 / 5.0, kDpC3 = 3.0 / 10.0, kDpC4 = 4.0 / 5.0, kDpC5 = 8.0 / 9.0;
+
+AnalogOdeSolver::AnalogOdeSolver(const AnalogIntegratorConfig& config) {
+    setConfig(config);
+}
+
+void AnalogOdeSolver::setConfig(const AnalogIntegratorConfig& new_config) {
+    config = new_config;
+    if (!(config.time_step > 0.0)) config.time_step = 0.1;
+    if (!(config.min_step > 0.0)) config.min_step = 1e-9;
+    if (!(config.max_step >= config.min_step)) config.max_step = std::max(config.min_step, config.time_step);
+    adaptive_step = 0.0;
+}
+
+void AnalogOdeSolver::resize(size_t n) {
+    if (n == stage_size) return;
+    for (auto& stage_k : k) stage_k.resize(n);
+    stage.resize(n);
+    y_next.resize(n);
+    stage_size = n;
+}
+
+bool AnalogOdeSolver::integrate(double* y, size_t n, double t, double duration, DerivativeFn fn, void* context) {
+    if (n == 0 || !(duration > 0.0)) return true;
+    resize(n);
+
+    if (config.scheme == IntegrationScheme::RK45) {
+        return integrateAdaptive(y, n, t, duration, fn, context);
+    }
+
+    // Fixed step: whole number of steps landing exactly on t + duration
+    const size_t steps = std::max<size_t>(1, static_cast<size_t>(std::ceil(duration / config.time_step - 1e-9)));
+    const double h = duration / static_cast<double>(steps);
+    for (size_t s = 0; s < steps; s++) {
+        const double step_t = t + h * static_cast<double>(s);
+        if (config.scheme == IntegrationScheme::RK4) {
+            stepRK4(y, n, step_t, h, fn, context);
+        } else {
+            stepEuler(y, n, step_t, h, fn, context);
+        }
+    }
+    stats.accepted_steps += steps;
+    return true;
+}
+
+void AnalogOdeSolver::stepEuler(double* y, size_t n, double t, double h, DerivativeFn fn, void* context) {
+    double* k1 = k[0].data();
+    fn(context, t, y, k1);
+    stats.derivative_evaluations++;
+    for (size_t i = 0; i < n; i++) y[i] += h * k1[i];
+}
+
+void AnalogOdeSolver::stepRK4(double* y, size_t n, double t, double h, DerivativeFn fn, void* context) {
+    double* k1 = k[0].data();
+    double* k2 = k[1].data();
+    double* k3 = k[2].data();
+    double* k4 = k[3].data();
+    double* s = stage.data();
+    const double half = h * 0.5;
+
+    fn(context, t, y, k1);
+    for (size_t i = 0; i < n; i++) s[i] = y[i] + half * k1[i];
+    fn(context, t + half, s, k2);
+    for (size_t i = 0; i < n; i++) s[i] = y[i] + half * k2[i];
+    fn(context, t + half, s, k3);
+    for (size_t i = 0; i < n; i++) s[i] = y[i] + h * k3[i];
+    fn(context, t + h, s, k4);
+    stats.derivative_evaluations += 4;
+
+    const double sixth = h / 6.0;
+    for (size_t i = 0; i < n; i++) {
+        y[i] += sixth * (k1[i] + 2.0 * (k2[i] + k3[i]) + k4[i]);
+    }
+}
+
+// ADAPTIVE: Dormand-Prince with FSAL; the step grows or shrinks from the
+// RMS of the embedded error estimate scaled by the mixed tolerance
+bool AnalogOdeSolver::integrateAdaptive(double* y, size_t n, double t, double duration, DerivativeFn fn,
+                                        void* context) {
+    double* k1 = k[0].data();
+    double* k2 = k[1].data();
+    double* k3 = k[2].data();
+    double* k4 = k[3].data();
+    double* k5 = k[4].data();
+    double* k6 = k[5].data();
+    double* k7 = k[6].data();
+    double* s = stage.data();
+    double* yn = y_next.data();
+
+    const double t_end = t + duration;
+    double h = adaptive_step > 0.0 ? adaptive_step : config.time_step;
+    h = std::clamp(h, config.min_step, config.max_step);
+
+    fn(context, t, y, k1);
+    stats.derivative_evaluations++;
+
+    while (t < t_end) {
+        const bool last = t + h >= t_end;
+        const double step = last ? t_end - t : h;
+
+        for (size_t i = 0; i < n; i++) s[i] = y[i] + step * kDpA21 * k1[i];
+        fn(context, t + kDpC2 * step, s, k2);
+        for (size_t i = 0; i < n; i++) s[i] = y[i] + step * (kDpA31 * k1[i] + kDpA32 * k2[i]);
+        fn(context, t + kDpC3 * step, s, k3);
+        for (size_t i = 0; i < n; i++) s[i] = y[i] + step * (kDpA41 * k1[i] + kDpA42 * k2[i] + kDpA43 * k3[i]);
+        fn(context, t + kDpC4 * step, s, k4);
+        for (size_t i = 0; i < n; i++) {
+            s[i] = y[i] + step * (kDpA51 * k1[i] + kDpA52 * k2[i] + kDpA53 * k3[i] + kDpA54 * k4[i]);
+        }
+        fn(context, t + kDpC5 * step, s, k5);
+        for (size_t i = 0; i < n; i++) {
+            s[i] = y[i] + step * (kDpA61 * k1[i] + kDpA62 * k2[i] + kDpA63 * k3[i] + kDpA64 * k4[i] +
+                                  kDpA65 * k5[i]);
+        }
+        fn(context, t + step, s, k6);
+        for (size_t i = 0; i < n; i++) {
+            yn[i] = y[i] + step * (kDpB1 * k1[i] + kDpB3 * k3[i] + kDpB4 * k4[i] + kDpB5 * k5[i] + kDpB6 * k6[i]);
+        }
+        fn(context, t + step, yn, k7);
+        stats.derivative_evaluations += 6;
+
+        double error_sum = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            const double error = step * (kDpE1 * k1[i] + kDpE3 * k3[i] + kDpE4 * k4[i] + kDpE5 * k5[i] +
+                                         kDpE6 * k6[i] + kDpE7 * k7[i]);
+            const double scale = config.abs_tolerance + config.rel_tolerance * std::max(std::fabs(y[i]), std::fabs(yn[i]));
+            error_sum += (error / scale) * (error / scale);
+        }
+        const double error_norm = std::sqrt(error_sum / static_cast<double>(n));
+        // A NaN or infinite error estimate fails the test below and must shrink the
+        // step like any other rejection, so a non-finite derivative ends at min_step
+        // instead of growing the step forever
+        const double factor = !std::isfinite(error_norm) ? 0.2
+                              : error_norm > 0.0         ? std::clamp(0.9 * std::pow(error_norm, -0.2), 0.2, 5.0)
+                                                         : 5.0;
+
+        if (error_norm <= 1.0) {
+            t = last ? t_end : t + step;
+            std::copy(yn, yn + n, y);
+            std::swap(k[0], k[6]);  // FSAL: f(t + h, y_next) is the next step's first stage
+            k1 = k[0].data();
+            k7 = k[6].data();
+            stats.accepted_steps++;
+            // A shortened final step says nothing about the natural step size
+            if (!last) h = std::min(step * factor, config.max_step);
+        } else {
+            stats.rejected_steps++;
+            h = step * std::max(factor, 0.2);
+            if (h < config.min_step) {
+                adaptive_step = 0.0;
+                return false;
+            }
+        }
+    }
+    adaptive_step = h;
+    return true;
+}
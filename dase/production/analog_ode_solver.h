@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Integration scheme for integrator-mode nodes in continuous circuit time
+enum class IntegrationScheme : uint8_t {
+    Euler = 0,  // Forward Euler, fixed step (legacy behaviour: one 0.1 step per processCircuitStep)
+    RK4 = 1,    // Classic fourth-order Runge-Kutta, fixed step
+    RK45 = 2    // Dormand-Prince 5(4), error-controlled adaptive step
+};
+
+struct AnalogIntegratorConfig {
+    IntegrationScheme scheme = IntegrationScheme::Euler;
+    double time_step = 0.1;        // Fixed step for Euler/RK4, first trial step for RK45
+    double abs_tolerance = 1e-6;   // RK45 per-component error tolerance: abs + rel * |y|
+    double rel_tolerance = 1e-6;
+    double min_step = 1e-9;        // RK45 gives up (returns false) below this step
+    double max_step = 1.0;
+};
+
+struct AnalogIntegratorStats {
+    uint64_t accepted_steps = 0;
+    uint64_t rejected_steps = 0;
+    uint64_t derivative_evaluations = 0;
+};
+
+// ODE SOLVER: Advances a whole state vector y' = f(t, y) at once.
+// Stage vectors are owned by the solver and reused across calls, and the
+// adaptive scheme carries its last accepted step size into the next call.
+class AnalogOdeSolver {
+public:
+    // f(context, t, y, dydt): write dy/dt for all n components
+    using DerivativeFn = void (*)(void* context, double t, const double* y, double* dydt);
+
+    explicit AnalogOdeSolver(const AnalogIntegratorConfig& config = AnalogIntegratorConfig());
+
+    void setConfig(const AnalogIntegratorConfig& new_config);
+    const AnalogIntegratorConfig& getConfig() const { return config; }
+    const AnalogIntegratorStats& getStats() const { return stats; }
+    void resetStats() { stats = AnalogIntegratorStats(); }
+
+    // Integrate y (n components) from t to t + duration in place.
+    // Returns false if RK45 cannot meet the tolerance above min_step, which
+    // includes a NaN or infinite derivative; y then holds the last accepted state.
+    bool integrate(double* y, size_t n, double t, double duration, DerivativeFn fn, void* context);
+
+    template <typename Fn>
+    bool integrate(double* y, size_t n, double t, double duration, Fn&& fn) {
+        return integrate(y, n, t, duration, &invokeDerivative<Fn>, &fn);
+    }
+
+private:
+    template <typename Fn>
+    static void invokeDerivative(void* context, double t, const double* y, double* dydt) {
+        (*static_cast<typename std::remove_reference<Fn>::type*>(context))(t, y, dydt);
+    }
+
+    void resize(size_t n);
+    void stepEuler(double* y, size_t n, double t, double h, DerivativeFn fn, void* context);
+    void stepRK4(double* y, size_t n, double t, double h, DerivativeFn fn, void* context);
+    bool integrateAdaptive(double* y, size_t n, double t, double duration, DerivativeFn fn, void* context);
+
+    AnalogIntegratorConfig config;
+    AnalogIntegratorStats stats;
+    double adaptive_step = 0.0;  // Last accepted RK45 step (0 = start from config.time_step)
+
+    std::vector<double> k[7];    // Stage derivatives
+    std::vector<double> stage;   // Stage input state
+    std::vector<double> y_next;
+    size_t stage_size = 0;
+};
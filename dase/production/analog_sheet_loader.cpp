@@ -0,0 +1,501 @@
+#include "analog_sheet_loader.h"
+#include "engine_mapped_file.h"
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+static const int kMaxJsonDepth = 64;
+
+// Parse a whole token as a double; the buffer is not NUL-terminated (mapped file)
+static bool parseNumber(std::string_view text, double& value) {
+    char buffer[64];
+    if (text.empty() || text.size() >= sizeof(buffer)) return false;
+    std::memcpy(buffer, text.data(), text.size());
+    buffer[text.size()] = '\0';
+    char* end = nullptr;
+    value = std::strtod(buffer, &end);
+    return end == buffer + text.size() && std::isfinite(value);
+}
+
+// ============================================================================
+// SAX: Single-pass JSON tokenizer. Strings are reported as views into the input,
+// decoded into a reused scratch buffer only when they contain escapes.
+// Handler: startObject/endObject/startArray/endArray(), key(sv), string(sv),
+// number(double), literal() for true/false/null. Any callback may return false to stop.
+// ============================================================================
+
+template <typename Handler>
+class SheetJsonScanner {
+public:
+    SheetJsonScanner(const char* data, size_t size, Handler& sax_handler)
+        : cursor(data), begin(data), end(data + size), handler(sax_handler) {}
+
+    bool run(std::string* error) {
+        skipSpace();
+        bool ok = value(0);
+        skipSpace();
+        if (ok && cursor != end) ok = fail("trailing characters after the top-level value");
+        if (!ok && error) *error = message + " at byte " + std::to_string(cursor - begin);
+        return ok;
+    }
+
+    bool fail(const char* reason) {
+        if (message.empty()) message = reason;
+        return false;
+    }
+
+private:
+    const char* cursor;
+    const char* begin;
+    const char* end;
+    Handler& handler;
+    std::string scratch;
+    std::string message;
+
+    void skipSpace() {
+        while (cursor < end && (*cursor == ' ' || *cursor == '\n' || *cursor == '\r' || *cursor == '\t')) cursor++;
+    }
+
+    static int hexDigit(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool string(std::string_view& out) {
+        const char* start = ++cursor;  // Past the opening quote
+        while (cursor < end && *cursor != '"' && *cursor != '\\') cursor++;
+        if (cursor < end && *cursor == '"') {
+            out = std::string_view(start, static_cast<size_t>(cursor - start));
+            cursor++;
+            return true;
+        }
+        // Escaped string: decode into the scratch buffer
+        scratch.assign(start, static_cast<size_t>(cursor - start));
+        while (cursor < end && *cursor != '"') {
+            char c = *cursor++;
+            if (c == '\\') {
+                if (cursor >= end) break;
+                const char e = *cursor++;
+                switch (e) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u': {
+                        if (end - cursor < 4) return fail("truncated \\u escape");
+                        int code = 0;
+                        for (int k = 0; k < 4; k++) {
+                            const int digit = hexDigit(cursor[k]);
+                            if (digit < 0) return fail("bad \\u escape");
+                            code = code * 16 + digit;
+                        }
+                        cursor += 4;
+                        if (code < 0x80) {
+                            c = static_cast<char>(code);
+                        } else if (code < 0x800) {
+                            scratch.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                            c = static_cast<char>(0x80 | (code & 0x3F));
+                        } else {  // Surrogate halves are passed through as three bytes each
+                            scratch.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                            scratch.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                            c = static_cast<char>(0x80 | (code & 0x3F));
+                        }
+                        break;
+                    }
+                    default: c = e; break;
+                }
+            }
+            scratch.push_back(c);
+        }
+        if (cursor >= end) return fail("unterminated string");
+        cursor++;
+        out = scratch;
+        return true;
+    }
+
+    bool number() {
+        const char* start = cursor;
+        while (cursor < end && (std::isdigit(static_cast<unsigned char>(*cursor)) || *cursor == '-' || *cursor == '+' ||
+                                *cursor == '.' || *cursor == 'e' || *cursor == 'E')) {
+            cursor++;
+        }
+        double parsed = 0.0;
+        if (!parseNumber(std::string_view(start, static_cast<size_t>(cursor - start)), parsed)) return fail("bad number");
+        return handler.number(parsed) || fail(handler.reason());
+    }
+
+    bool word(const char* text) {
+        const size_t length = std::strlen(text);
+        if (static_cast<size_t>(end - cursor) < length || std::memcmp(cursor, text, length) != 0) return fail("unexpected character");
+        cursor += length;
+        return handler.literal() || fail(handler.reason());
+    }
+
+    bool value(int depth) {
+        if (depth > kMaxJsonDepth) return fail("nesting too deep");
+        if (cursor >= end) return fail("unexpected end of input");
+        switch (*cursor) {
+            case '{': {
+                cursor++;
+                if (!handler.startObject()) return fail(handler.reason());
+                skipSpace();
+                if (cursor < end && *cursor == '}') {
+                    cursor++;
+                    return handler.endObject() || fail(handler.reason());
+                }
+                while (true) {
+                    skipSpace();
+                    std::string_view name;
+                    if (cursor >= end || *cursor != '"') return fail("expected a key");
+                    if (!string(name)) return false;
+                    if (!handler.key(name)) return fail(handler.reason());
+                    skipSpace();
+                    if (cursor >= end || *cursor != ':') return fail("expected ':'");
+                    cursor++;
+                    skipSpace();
+                    if (!value(depth + 1)) return false;
+                    skipSpace();
+                    if (cursor < end && *cursor == ',') { cursor++; continue; }
+                    if (cursor < end && *cursor == '}') { cursor++; break; }
+                    return fail("expected ',' or '}'");
+                }
+                return handler.endObject() || fail(handler.reason());
+            }
+            case '[': {
+                cursor++;
+                if (!handler.startArray()) return fail(handler.reason());
+                skipSpace();
+                if (cursor < end && *cursor == ']') {
+                    cursor++;
+                    return handler.endArray() || fail(handler.reason());
+                }
+                while (true) {
+                    skipSpace();
+                    if (!value(depth + 1)) return false;
+                    skipSpace();
+                    if (cursor < end && *cursor == ',') { cursor++; continue; }
+                    if (cursor < end && *cursor == ']') { cursor++; break; }
+                    return fail("expected ',' or ']'");
+                }
+                return handler.endArray() || fail(handler.reason());
+            }
+            case '"': {
+                std::string_view text;
+                if (!string(text)) return false;
+                return handler.string(text) || fail(handler.reason());
+            }
+            case 't': return word("true");
+            case 'f': return word("false");
+            case 'n': return word("null");
+            default: return number();
+        }
+    }
+};
+
+// ============================================================================
+// LOWERING: Cells to netlist as they stream past
+// ============================================================================
+
+class SheetBuilder {
+public:
+    explicit SheetBuilder(SheetCircuit& output) : circuit(output) {
+        table.assign(1024, kEmpty);
+    }
+
+    // SAX callbacks: only {"cells": {id: {"value"|"formula": ...}}} is interpreted
+    bool startObject() {
+        depth++;
+        if (depth == 2 && in_cells_key) in_cells = true;
+        if (in_cells && depth == 3) beginCell();
+        return true;
+    }
+    bool endObject() {
+        if (in_cells && depth == 3 && !endCell()) return false;
+        if (in_cells && depth == 2) in_cells = false;
+        depth--;
+        return true;
+    }
+    bool startArray() { depth++; return true; }
+    bool endArray() { depth--; return true; }
+    bool key(std::string_view name) {
+        if (depth == 1) in_cells_key = name == "cells";
+        if (in_cells && depth == 2) cell_id.assign(name.data(), name.size());
+        if (in_cells && depth == 3) field = name == "formula" ? Field::Formula : name == "value" ? Field::Value : Field::Other;
+        return true;
+    }
+    bool string(std::string_view text) {
+        if (in_cells && depth == 2) {  // Shorthand "A1": "=AMP(2.0,1.05)"
+            beginCell();
+            cell_value.assign(text.data(), text.size());
+            return endCell();
+        }
+        if (in_cells && depth == 3) {
+            if (field == Field::Formula) cell_formula.assign(text.data(), text.size());
+            if (field == Field::Value) cell_value.assign(text.data(), text.size());
+        }
+        return true;
+    }
+    bool number(double parsed) {
+        if (in_cells && depth == 2) {  // Shorthand "A1": 3.5
+            beginCell();
+            cell_number = parsed;
+            has_number = true;
+            return endCell();
+        }
+        if (in_cells && depth == 3 && field == Field::Value) {
+            cell_number = parsed;
+            has_number = true;
+        }
+        return true;
+    }
+    bool literal() { return true; }
+    const char* reason() const { return error.c_str(); }
+
+    bool finish(std::string* message) {
+        if (node_symbol.empty()) {
+            if (message) *message = "no formula cells";
+            return false;
+        }
+        const size_t node_count = node_symbol.size();
+        circuit.graph = AnalogCircuitGraph(node_count);
+        for (uint32_t v = 0; v < node_count; v++) {
+            if (node_control[v] != 0.0) circuit.graph.setControl(v, node_control[v]);
+        }
+        // References resolve now that every cell has been seen (they may point forward)
+        for (const PendingEdge& edge : edges) {
+            const Symbol& source = symbols[edge.source];
+            if (source.node != kNone) {
+                circuit.graph.connect(source.node, edge.target, edge.weight);
+                circuit.edge_count++;
+            } else if (source.has_constant) {
+                node_drive[edge.target] += source.constant * edge.weight;
+            }
+        }
+        for (uint32_t v = 0; v < node_count; v++) {
+            if (node_drive[v] != 0.0) circuit.graph.setExternalInput(v, node_drive[v]);
+        }
+        circuit.label_offsets.resize(node_count + 1);
+        circuit.label_text.clear();
+        for (size_t v = 0; v < node_count; v++) {
+            const Symbol& symbol = symbols[node_symbol[v]];
+            circuit.label_offsets[v] = static_cast<uint32_t>(circuit.label_text.size());
+            circuit.label_text.insert(circuit.label_text.end(), arena.begin() + symbol.offset,
+                                      arena.begin() + symbol.offset + symbol.length);
+        }
+        circuit.label_offsets[node_count] = static_cast<uint32_t>(circuit.label_text.size());
+        return true;
+    }
+
+private:
+    static constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+    enum class Field { Other, Value, Formula };
+
+    struct Symbol {
+        uint32_t offset = 0;       // Cell ID in the arena
+        uint32_t length = 0;
+        uint32_t node = kNone;     // Engine node of a formula cell
+        bool has_constant = false;
+        double constant = 0.0;     // Plain numeric cell
+    };
+    struct PendingEdge {
+        uint32_t source;           // Symbol
+        uint32_t target;           // Node
+        double weight;
+    };
+
+    SheetCircuit& circuit;
+    int depth = 0;
+    bool in_cells_key = false;
+    bool in_cells = false;
+    Field field = Field::Other;
+    std::string error;
+
+    // Current cell (buffers are reused, so steady-state parsing does not allocate)
+    std::string cell_id, cell_value, cell_formula;
+    double cell_number = 0.0;
+    bool has_number = false;
+
+    // Interned cell IDs: open-addressing table of symbol indices
+    std::vector<char> arena;
+    std::vector<Symbol> symbols;
+    std::vector<uint32_t> table;
+
+    std::vector<uint32_t> node_symbol;
+    std::vector<double> node_control;
+    std::vector<double> node_drive;
+    std::vector<PendingEdge> edges;
+
+    static uint64_t hashName(std::string_view name) {
+        uint64_t hash = 1469598103934665603ull;  // FNV-1a
+        for (char c : name) hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        return hash;
+    }
+
+    uint32_t intern(std::string_view name) {
+        if (symbols.size() * 2 >= table.size()) {
+            std::vector<uint32_t> grown(table.size() * 2, kEmpty);
+            for (uint32_t s = 0; s < symbols.size(); s++) {
+                size_t slot = hashName(std::string_view(arena.data() + symbols[s].offset, symbols[s].length)) & (grown.size() - 1);
+                while (grown[slot] != kEmpty) slot = (slot + 1) & (grown.size() - 1);
+                grown[slot] = s;
+            }
+            table.swap(grown);
+        }
+        size_t slot = hashName(name) & (table.size() - 1);
+        while (table[slot] != kEmpty) {
+            const Symbol& symbol = symbols[table[slot]];
+            if (symbol.length == name.size() && std::memcmp(arena.data() + symbol.offset, name.data(), name.size()) == 0) {
+                return table[slot];
+            }
+            slot = (slot + 1) & (table.size() - 1);
+        }
+        Symbol symbol;
+        symbol.offset = static_cast<uint32_t>(arena.size());
+        symbol.length = static_cast<uint32_t>(name.size());
+        arena.insert(arena.end(), name.begin(), name.end());
+        table[slot] = static_cast<uint32_t>(symbols.size());
+        symbols.push_back(symbol);
+        return table[slot];
+    }
+
+    void beginCell() {
+        cell_value.clear();
+        cell_formula.clear();
+        has_number = false;
+        field = Field::Other;
+    }
+
+    bool endCell() {
+        circuit.cell_count++;
+        const std::string& text = !cell_formula.empty() ? cell_formula : cell_value;
+        size_t start = 0;
+        while (start < text.size() && std::isspace(static_cast<unsigned char>(text[start]))) start++;
+        if (start < text.size() && text[start] == '=') return lowerFormula(std::string_view(text).substr(start + 1));
+
+        double constant = cell_number;
+        if (has_number || parseNumber(trim(text), constant)) {
+            Symbol& symbol = symbols[intern(cell_id)];
+            symbol.has_constant = true;
+            symbol.constant = constant;
+            circuit.constant_count++;
+        }
+        return true;
+    }
+
+    static std::string_view trim(std::string_view text) {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+        return text;
+    }
+
+    bool reject(const char* what) {
+        error = std::string(what) + " in cell " + cell_id;
+        return false;
+    }
+
+    // Cell reference (A1, $B$2) or number, weighted into node v
+    bool wire(std::string_view argument, uint32_t v, double weight) {
+        argument = trim(argument);
+        double constant = 0.0;
+        if (parseNumber(argument, constant)) {
+            node_drive[v] += constant * weight;
+            return true;
+        }
+        char reference[32];
+        size_t length = 0;
+        for (char c : argument) {
+            if (c == '$') continue;
+            if (!std::isalnum(static_cast<unsigned char>(c)) || length + 1 >= sizeof(reference)) {
+                return reject("unsupported argument");
+            }
+            reference[length++] = c;
+        }
+        if (length == 0) return reject("empty argument");
+        edges.push_back({intern(std::string_view(reference, length)), v, weight});
+        return true;
+    }
+
+    bool lowerFormula(std::string_view body) {
+        body = trim(body);
+        const size_t open = body.find('(');
+        std::string_view name = trim(body.substr(0, open));
+        char function[16];
+        if (name.size() >= sizeof(function)) return reject("unsupported formula");
+        for (size_t k = 0; k < name.size(); k++) function[k] = static_cast<char>(std::toupper(static_cast<unsigned char>(name[k])));
+        const std::string_view upper(function, name.size());
+
+        const uint32_t v = static_cast<uint32_t>(node_symbol.size());
+        const uint32_t symbol = intern(cell_id);
+        if (symbols[symbol].node != kNone) return reject("duplicate cell");
+        symbols[symbol].node = v;
+        node_symbol.push_back(symbol);
+        node_control.push_back(0.0);
+        node_drive.push_back(0.0);
+
+        if (open == std::string_view::npos) return wire(body, v, -1.0);  // =A1 (inverted back by the node)
+        if (body.back() != ')') return reject("missing ')'");
+
+        // Split the argument list once; arguments are views into the formula text
+        std::string_view arguments[16];
+        size_t argument_count = 0;
+        std::string_view list = body.substr(open + 1, body.size() - open - 2);
+        if (list.find('(') != std::string_view::npos) return reject("nested formulas are not supported");
+        while (true) {
+            const size_t comma = list.find(',');
+            if (argument_count == 16) return reject("too many arguments");
+            arguments[argument_count++] = list.substr(0, comma);
+            if (comma == std::string_view::npos) break;
+            list.remove_prefix(comma + 1);
+        }
+        auto factor = [&](size_t k, double fallback, double& out) {
+            out = fallback;
+            return k >= argument_count || parseNumber(trim(arguments[k]), out);
+        };
+
+        double k = 1.0;
+        if (upper == "AMP") {
+            if (!factor(1, 1.0, k)) return reject("AMP gain must be a number");
+            return wire(arguments[0], v, -k);
+        }
+        if (upper == "SUMMER" || upper == "SUM") {
+            for (size_t a = 0; a < argument_count; a++) {
+                if (!wire(arguments[a], v, -1.0)) return false;
+            }
+            return true;
+        }
+        if (upper == "INTEGRATE") {
+            if (!factor(1, 0.1, k)) return reject("INTEGRATE rate must be a number");
+            node_control[v] = 1.0;
+            return wire(arguments[0], v, k / 0.1);
+        }
+        if (upper == "DIFF" || upper == "DIFFERENTIATE") {
+            node_control[v] = -1.0;
+            return wire(arguments[0], v, 1.0);
+        }
+        return reject("unsupported formula");
+    }
+};
+
+bool parseSheetCircuit(const char* data, size_t size, SheetCircuit& circuit, std::string* error) {
+    circuit = SheetCircuit();
+    SheetBuilder builder(circuit);
+    SheetJsonScanner<SheetBuilder> scanner(data, size, builder);
+    return scanner.run(error) && builder.finish(error);
+}
+
+bool loadSheetCircuit(const std::string& path, SheetCircuit& circuit, std::string* error) {
+    MappedFile file;
+    if (!file.openRead(path)) {
+        if (error) *error = "cannot map " + path;
+        return false;
+    }
+    return parseSheetCircuit(file.data(), file.size(), circuit, error);
+}
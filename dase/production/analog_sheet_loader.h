@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "analog_circuit_graph.h"
+
+// SHEET LOADER: engine_input.json (web/index.html exportToEngine()) straight to a netlist.
+//   {"cells": {"A1": {"value": "=AMP(2.0,1.05)", "formula": "...", "type": "module"}, ...}, ...}
+// The file is memory-mapped and scanned once by a SAX tokenizer. Cells are lowered
+// as they stream past: no DOM is built, cell IDs are interned into one character
+// arena, and the only per-cell storage is the netlist's own node and edge arrays.
+//
+// Every formula cell becomes one engine node, numbered in file order. Engine nodes
+// invert at control 0, so linear weights are negated:
+//   =AMP(x, k)          output  k * x
+//   =SUMMER(a, b, ...)  output  a + b + ...       (SUM is accepted as an alias)
+//   =INTEGRATE(x, k)    output  integral of k * x (integrator mode, gain 0.1 per step)
+//   =DIFF(x)            output  x - x_previous    (differentiator mode)
+//   =x                  output  x
+// Arguments are cell references or numbers. Numbers, and references to plain
+// numeric cells, scale the engine's external drive. References to empty cells
+// contribute nothing. References are algebraic edges; AnalogCircuitGraph::compile()
+// demotes the edges that close a loop to one-step delays.
+struct SheetCircuit {
+    AnalogCircuitGraph graph;
+    size_t cell_count = 0;                // Cells in the file (formula, value and empty)
+    size_t constant_count = 0;            // Plain numeric cells
+    size_t edge_count = 0;                // Resolved cell-reference edges
+
+    // Cell ID of every node, back to back: node i is
+    // label_text[label_offsets[i] .. label_offsets[i + 1])
+    std::vector<char> label_text;
+    std::vector<uint32_t> label_offsets;
+
+    size_t getNodeCount() const { return graph.getNodeCount(); }
+    std::string label(size_t node) const {
+        return std::string(label_text.data() + label_offsets[node], label_offsets[node + 1] - label_offsets[node]);
+    }
+};
+
+// Both return false (with a message including the byte offset in *error) on
+// malformed JSON, an unsupported formula, or a sheet without formula cells.
+bool loadSheetCircuit(const std::string& path, SheetCircuit& circuit, std::string* error = nullptr);
+bool parseSheetCircuit(const char* data, size_t size, SheetCircuit& circuit, std::string* error = nullptr);
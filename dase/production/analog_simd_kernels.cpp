@@ -0,0 +1,106 @@
+// Baseline build of the wave kernels (this file's own compiler flags) plus the
+// runtime dispatcher that picks between it and the per-ISA builds.
+#define DASE_KERNEL_TABLE kAnalogKernelsBaseline
+#include "analog_simd_kernels_impl.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(DASE_KERNEL_DISPATCH) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifdef DASE_KERNEL_DISPATCH
+extern const AnalogKernelTable kAnalogKernelsAvx512;   // analog_simd_kernels_avx512.cpp
+extern const AnalogKernelTable kAnalogKernelsAvx2;     // analog_simd_kernels_avx2.cpp
+#endif
+
+// Best first
+static const AnalogKernelTable* const kKernelTables[] = {
+#ifdef DASE_KERNEL_DISPATCH
+    &kAnalogKernelsAvx512,
+    &kAnalogKernelsAvx2,
+#endif
+    &kAnalogKernelsBaseline,
+};
+
+// CPUID: The CPU has the instructions and the OS saves the vector registers
+static bool cpuRunsIsa(const char* isa) {
+    if (std::strcmp(isa, "avx512") != 0 && std::strcmp(isa, "avx2") != 0) return true;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (std::strcmp(isa, "avx2") == 0) return __builtin_cpu_supports("avx2");
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    if (!(regs[2] & (1 << 27))) return false;          // OSXSAVE
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(regs, 7, 0);
+    const bool avx2 = (xcr0 & 0x6) == 0x6 && (regs[1] & (1 << 5));
+    if (std::strcmp(isa, "avx2") == 0) return avx2;
+    return (xcr0 & 0xE6) == 0xE6 && (regs[1] & (1 << 16)) && (regs[1] & (1 << 17));   // AVX512F + DQ
+#else
+    return false;
+#endif
+}
+
+static const AnalogKernelTable* findKernels(const char* isa) {
+    for (const AnalogKernelTable* table : kKernelTables) {
+        if (std::strcmp(table->isa, isa) == 0 && cpuRunsIsa(table->isa)) return table;
+    }
+    return nullptr;
+}
+
+static const AnalogKernelTable* defaultKernels() {
+    const char* forced = std::getenv("DASE_KERNEL_ISA");
+    if (forced && *forced) {
+        if (const AnalogKernelTable* table = findKernels(forced)) return table;
+    }
+    for (const AnalogKernelTable* table : kKernelTables) {
+        if (cpuRunsIsa(table->isa)) return table;
+    }
+    return &kAnalogKernelsBaseline;
+}
+
+static std::atomic<const AnalogKernelTable*> g_kernels{nullptr};
+
+// Chosen once; racing first calls pick the same table
+static const AnalogKernelTable& activeKernels() {
+    const AnalogKernelTable* table = g_kernels.load(std::memory_order_acquire);
+    if (!table) {
+        table = defaultKernels();
+        g_kernels.store(table, std::memory_order_release);
+    }
+    return *table;
+}
+
+void processSignalLanes(const AnalogLaneState& state, size_t first, size_t count,
+                        const double* input, const double* control, const double* aux,
+                        double* output) {
+    activeKernels().lanes_f64(state, first, count, input, control, aux, output);
+}
+
+void processSignalLanes(const AnalogLaneStateT<float>& state, size_t first, size_t count,
+                        const float* input, const float* control, const float* aux,
+                        float* output) {
+    activeKernels().lanes_f32(state, first, count, input, control, aux, output);
+}
+
+void processSignalLanes(const AnalogLaneStateT<float, double>& state, size_t first, size_t count,
+                        const float* input, const float* control, const float* aux,
+                        float* output) {
+    activeKernels().lanes_mixed(state, first, count, input, control, aux, output);
+}
+
+const char* analogKernelIsa() { return activeKernels().isa; }
+
+bool analogSelectKernelIsa(const char* isa) {
+    const AnalogKernelTable* table = isa ? findKernels(isa) : nullptr;
+    if (!table) return false;
+    g_kernels.store(table, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+
+// SIMD: Lane block width used by the structure-of-arrays engine storage.
+// One block fills exactly one 64-byte cache line (8 doubles or 16 floats),
+// so a block of nodes never shares a line with a block owned by another thread.
+template <typename Scalar>
+constexpr size_t kAnalogLaneBlockFor = 64 / sizeof(Scalar);
+constexpr size_t kAnalogLaneBlock = kAnalogLaneBlockFor<double>;
+
+// SIMD: Pointers into the engine's structure-of-arrays node state.
+// Accum is the integrator accumulator type (double in mixed precision).
+template <typename Scalar, typename Accum = Scalar>
+struct AnalogLaneStateT {
+    Accum* integrator_state;
+    Scalar* previous_input;
+    Scalar* feedback_gain;
+    Scalar* current_output;
+};
+using AnalogLaneState = AnalogLaneStateT<double>;
+
+// BRANCHLESS: One analog node step shared by the scalar and SIMD paths.
+// Integrator (control > 0.5), differentiator (control < -0.5), amplifier
+// (control > 0) and inverting (otherwise) are all evaluated and blended,
+// so the result is bit-identical to the original branching processSignal.
+// The integrator accumulates in Accum and is rounded to Scalar on output.
+template <typename Scalar, typename Accum>
+inline Scalar analogSignalStep(Scalar input_signal, Scalar control_signal, Scalar feedback_gain,
+                               Accum& integrator_state, Scalar& previous_input) {
+    const bool integrate = control_signal > Scalar(0.5);
+    const bool differentiate = control_signal < Scalar(-0.5);
+
+    const Accum integrated = integrator_state + static_cast<Accum>(input_signal) * static_cast<Accum>(0.1);
+    const Scalar derivative = input_signal - previous_input;
+    const Scalar amplified = input_signal * (Scalar(1) + control_signal);
+    const Scalar inverted = -input_signal * (Scalar(1) - control_signal);  // 1 + |c| for c <= 0
+
+    integrator_state = integrate ? integrated : integrator_state;
+    previous_input = differentiate ? input_signal : previous_input;
+
+    const Scalar linear = control_signal > Scalar(0) ? amplified : inverted;
+    const Scalar result = integrate ? static_cast<Scalar>(integrated) : (differentiate ? derivative : linear);
+    return result * feedback_gain;
+}
+
+// SIMD KERNEL: Evaluate `count` contiguous lanes starting at node `first`.
+// input/control/aux/output are lane-local buffers of at least `count` entries.
+// aux mirrors processSignal's aux_signal and is currently not consumed.
+// Overloads: double, float, and float with double integrators (mixed).
+void processSignalLanes(const AnalogLaneStateT<double>& state, size_t first, size_t count,
+                        const double* input, const double* control, const double* aux,
+                        double* output);
+void processSignalLanes(const AnalogLaneStateT<float>& state, size_t first, size_t count,
+                        const float* input, const float* control, const float* aux,
+                        float* output);
+void processSignalLanes(const AnalogLaneStateT<float, double>& state, size_t first, size_t count,
+                        const float* input, const float* control, const float* aux,
+                        float* output);
+
+// DISPATCH: The overloads above call through the kernel table picked on first use:
+// the best build this CPU can run, or the one named by the DASE_KERNEL_ISA
+// environment variable. Builds without DASE_KERNEL_DISPATCH carry only the kernels
+// of their own compiler flags. Every build computes bit-identical results.
+struct AnalogKernelTable {
+    const char* isa;
+    void (*lanes_f64)(const AnalogLaneStateT<double>&, size_t, size_t, const double*, const double*,
+                      const double*, double*);
+    void (*lanes_f32)(const AnalogLaneStateT<float>&, size_t, size_t, const float*, const float*,
+                      const float*, float*);
+    void (*lanes_mixed)(const AnalogLaneStateT<float, double>&, size_t, size_t, const float*, const float*,
+                        const float*, float*);
+};
+
+// Instruction set of the kernels in use: "avx512", "avx2", "sse2" or "scalar"
+const char* analogKernelIsa();
+// Switch to the kernels built for `isa`; false (and no change) if this binary does
+// not carry them or this CPU cannot run them. Not for use while a wave is running.
+bool analogSelectKernelIsa(const char* isa);
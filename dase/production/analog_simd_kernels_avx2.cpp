@@ -0,0 +1,8 @@
+// AVX2 build of the wave kernels. Compiled with -mavx2 (MSVC /arch:AVX2) and
+// only called after analog_simd_kernels.cpp has checked the CPU.
+#define DASE_KERNEL_TABLE kAnalogKernelsAvx2
+#include "analog_simd_kernels_impl.h"
+
+#ifndef __AVX2__
+#error "analog_simd_kernels_avx2.cpp must be compiled with AVX2 enabled"
+#endif
@@ -0,0 +1,8 @@
+// AVX-512 build of the wave kernels. Compiled with -mavx512f -mavx512dq (MSVC
+// /arch:AVX512) and only called after analog_simd_kernels.cpp has checked the CPU.
+#define DASE_KERNEL_TABLE kAnalogKernelsAvx512
+#include "analog_simd_kernels_impl.h"
+
+#if !defined(__AVX512F__) || !defined(__AVX512DQ__)
+#error "analog_simd_kernels_avx512.cpp must be compiled with AVX512F and AVX512DQ enabled"
+#endif
@@ -0,0 +1,357 @@
+// DISPATCH: Wave kernel bodies, compiled once per instruction set. Each including
+// translation unit defines DASE_KERNEL_TABLE, builds with its own ISA flags and
+// exports the kernels as that table; every function here is local to it.
+// Only included by analog_simd_kernels*.cpp.
+#include "analog_simd_kernels.h"
+
+#ifndef DASE_KERNEL_TABLE
+#error "Define DASE_KERNEL_TABLE before including analog_simd_kernels_impl.h"
+#endif
+
+#if (defined(__AVX512F__) && defined(__AVX512DQ__)) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// SCALAR TAIL: Lanes that do not fill a whole vector
+template <typename Scalar, typename Accum>
+static inline void processScalarLanes(const AnalogLaneStateT<Scalar, Accum>& state, size_t first, size_t begin,
+                                      size_t count, const Scalar* input, const Scalar* control,
+                                      Scalar* output) {
+    for (size_t lane = begin; lane < count; lane++) {
+        const size_t i = first + lane;
+        const Scalar result = analogSignalStep(input[lane], control[lane], state.feedback_gain[i],
+                                               state.integrator_state[i], state.previous_input[i]);
+        state.current_output[i] = result;
+        output[lane] = result;
+    }
+}
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+
+// AVX-512: Eight lanes per vector, mode selection through mask registers
+static void signalLanesF64(const AnalogLaneState& state, size_t first, size_t count,
+                           const double* input, const double* control, const double* aux,
+                           double* output) {
+    (void)aux;
+    const __m512d half = _mm512_set1_pd(0.5);
+    const __m512d neg_half = _mm512_set1_pd(-0.5);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d tenth = _mm512_set1_pd(0.1);
+    const __m512d sign = _mm512_set1_pd(-0.0);
+
+    size_t lane = 0;
+    for (; lane + 8 <= count; lane += 8) {
+        const size_t i = first + lane;
+        const __m512d in = _mm512_loadu_pd(input + lane);
+        const __m512d c = _mm512_loadu_pd(control + lane);
+        const __m512d gain = _mm512_loadu_pd(state.feedback_gain + i);
+        __m512d integ = _mm512_loadu_pd(state.integrator_state + i);
+        __m512d prev = _mm512_loadu_pd(state.previous_input + i);
+
+        const __mmask8 integrate = _mm512_cmp_pd_mask(c, half, _CMP_GT_OQ);
+        const __mmask8 differentiate = _mm512_cmp_pd_mask(c, neg_half, _CMP_LT_OQ);
+        const __mmask8 positive = _mm512_cmp_pd_mask(c, zero, _CMP_GT_OQ);
+
+        const __m512d integrated = _mm512_add_pd(integ, _mm512_mul_pd(in, tenth));
+        const __m512d derivative = _mm512_sub_pd(in, prev);
+        const __m512d amplified = _mm512_mul_pd(in, _mm512_add_pd(one, c));
+        const __m512d inverted = _mm512_mul_pd(_mm512_xor_pd(in, sign), _mm512_sub_pd(one, c));
+
+        integ = _mm512_mask_mov_pd(integ, integrate, integrated);
+        prev = _mm512_mask_mov_pd(prev, differentiate, in);
+
+        __m512d result = _mm512_mask_mov_pd(inverted, positive, amplified);
+        result = _mm512_mask_mov_pd(result, differentiate, derivative);
+        result = _mm512_mask_mov_pd(result, integrate, integrated);
+        result = _mm512_mul_pd(result, gain);
+
+        _mm512_storeu_pd(state.integrator_state + i, integ);
+        _mm512_storeu_pd(state.previous_input + i, prev);
+        _mm512_storeu_pd(state.current_output + i, result);
+        _mm512_storeu_pd(output + lane, result);
+    }
+    processScalarLanes(state, first, lane, count, input, control, output);
+}
+
+// AVX-512 (float): Sixteen lanes per vector
+static void signalLanesF32(const AnalogLaneStateT<float>& state, size_t first, size_t count,
+                           const float* input, const float* control, const float* aux,
+                           float* output) {
+    (void)aux;
+    const __m512 half = _mm512_set1_ps(0.5f);
+    const __m512 neg_half = _mm512_set1_ps(-0.5f);
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 tenth = _mm512_set1_ps(0.1f);
+    const __m512 sign = _mm512_set1_ps(-0.0f);
+
+    size_t lane = 0;
+    for (; lane + 16 <= count; lane += 16) {
+        const size_t i = first + lane;
+        const __m512 in = _mm512_loadu_ps(input + lane);
+        const __m512 c = _mm512_loadu_ps(control + lane);
+        const __m512 gain = _mm512_loadu_ps(state.feedback_gain + i);
+        __m512 integ = _mm512_loadu_ps(state.integrator_state + i);
+        __m512 prev = _mm512_loadu_ps(state.previous_input + i);
+
+        const __mmask16 integrate = _mm512_cmp_ps_mask(c, half, _CMP_GT_OQ);
+        const __mmask16 differentiate = _mm512_cmp_ps_mask(c, neg_half, _CMP_LT_OQ);
+        const __mmask16 positive = _mm512_cmp_ps_mask(c, zero, _CMP_GT_OQ);
+
+        const __m512 integrated = _mm512_add_ps(integ, _mm512_mul_ps(in, tenth));
+        const __m512 derivative = _mm512_sub_ps(in, prev);
+        const __m512 amplified = _mm512_mul_ps(in, _mm512_add_ps(one, c));
+        const __m512 inverted = _mm512_mul_ps(_mm512_xor_ps(in, sign), _mm512_sub_ps(one, c));
+
+        integ = _mm512_mask_mov_ps(integ, integrate, integrated);
+        prev = _mm512_mask_mov_ps(prev, differentiate, in);
+
+        __m512 result = _mm512_mask_mov_ps(inverted, positive, amplified);
+        result = _mm512_mask_mov_ps(result, differentiate, derivative);
+        result = _mm512_mask_mov_ps(result, integrate, integrated);
+        result = _mm512_mul_ps(result, gain);
+
+        _mm512_storeu_ps(state.integrator_state + i, integ);
+        _mm512_storeu_ps(state.previous_input + i, prev);
+        _mm512_storeu_ps(state.current_output + i, result);
+        _mm512_storeu_ps(output + lane, result);
+    }
+    processScalarLanes(state, first, lane, count, input, control, output);
+}
+
+// Full-width float <-> double conversions. The unmasked intrinsics pass an
+// undefined register as merge source, which GCC 12 reports as maybe-uninitialized;
+// the zero-masked forms with every lane enabled compile to the same instruction.
+static inline __m512d widenLanes(__m256 v) { return _mm512_maskz_cvtps_pd(0xFF, v); }
+static inline __m256 narrowLanes(__m512d v) { return _mm512_maskz_cvtpd_ps(0xFF, v); }
+
+// AVX-512 (mixed): Eight float lanes, integrators widened to a double vector.
+// Mode masks come from the widened control (float to double is exact).
+static void signalLanesMixed(const AnalogLaneStateT<float, double>& state, size_t first, size_t count,
+                             const float* input, const float* control, const float* aux,
+                             float* output) {
+    (void)aux;
+    const __m512d half_d = _mm512_set1_pd(0.5);
+    const __m512d tenth_d = _mm512_set1_pd(0.1);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 neg_half = _mm256_set1_ps(-0.5f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+
+    size_t lane = 0;
+    for (; lane + 8 <= count; lane += 8) {
+        const size_t i = first + lane;
+        const __m256 in = _mm256_loadu_ps(input + lane);
+        const __m256 c = _mm256_loadu_ps(control + lane);
+        const __m256 gain = _mm256_loadu_ps(state.feedback_gain + i);
+        __m512d integ = _mm512_loadu_pd(state.integrator_state + i);
+        __m256 prev = _mm256_loadu_ps(state.previous_input + i);
+
+        const __mmask8 integrate_d = _mm512_cmp_pd_mask(widenLanes(c), half_d, _CMP_GT_OQ);
+        const __m256 integrate = _mm256_cmp_ps(c, half, _CMP_GT_OQ);
+        const __m256 differentiate = _mm256_cmp_ps(c, neg_half, _CMP_LT_OQ);
+        const __m256 positive = _mm256_cmp_ps(c, zero, _CMP_GT_OQ);
+
+        const __m512d integrated = _mm512_add_pd(integ, _mm512_mul_pd(widenLanes(in), tenth_d));
+        const __m256 derivative = _mm256_sub_ps(in, prev);
+        const __m256 amplified = _mm256_mul_ps(in, _mm256_add_ps(one, c));
+        const __m256 inverted = _mm256_mul_ps(_mm256_xor_ps(in, sign), _mm256_sub_ps(one, c));
+
+        integ = _mm512_mask_mov_pd(integ, integrate_d, integrated);
+        prev = _mm256_blendv_ps(prev, in, differentiate);
+
+        __m256 result = _mm256_blendv_ps(inverted, amplified, positive);
+        result = _mm256_blendv_ps(result, derivative, differentiate);
+        result = _mm256_blendv_ps(result, narrowLanes(integrated), integrate);
+        result = _mm256_mul_ps(result, gain);
+
+        _mm512_storeu_pd(state.integrator_state + i, integ);
+        _mm256_storeu_ps(state.previous_input + i, prev);
+        _mm256_storeu_ps(state.current_output + i, result);
+        _mm256_storeu_ps(output + lane, result);
+    }
+    processScalarLanes(state, first, lane, count, input, control, output);
+}
+
+#define DASE_KERNEL_ISA_NAME "avx512"
+
+#elif defined(__AVX2__)
+
+// AVX2: Four lanes per vector, mode selection through blendv
+static void signalLanesF64(const AnalogLaneState& state, size_t first, size_t count,
+                           const double* input, const double* control, const double* aux,
+                           double* output) {
+    (void)aux;
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d neg_half = _mm256_set1_pd(-0.5);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d tenth = _mm256_set1_pd(0.1);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+
+    size_t lane = 0;
+    for (; lane + 4 <= count; lane += 4) {
+        const size_t i = first + lane;
+        const __m256d in = _mm256_loadu_pd(input + lane);
+        const __m256d c = _mm256_loadu_pd(control + lane);
+        const __m256d gain = _mm256_loadu_pd(state.feedback_gain + i);
+        __m256d integ = _mm256_loadu_pd(state.integrator_state + i);
+        __m256d prev = _mm256_loadu_pd(state.previous_input + i);
+
+        const __m256d integrate = _mm256_cmp_pd(c, half, _CMP_GT_OQ);
+        const __m256d differentiate = _mm256_cmp_pd(c, neg_half, _CMP_LT_OQ);
+        const __m256d positive = _mm256_cmp_pd(c, zero, _CMP_GT_OQ);
+
+        const __m256d integrated = _mm256_add_pd(integ, _mm256_mul_pd(in, tenth));
+        const __m256d derivative = _mm256_sub_pd(in, prev);
+        const __m256d amplified = _mm256_mul_pd(in, _mm256_add_pd(one, c));
+        const __m256d inverted = _mm256_mul_pd(_mm256_xor_pd(in, sign), _mm256_sub_pd(one, c));
+
+        integ = _mm256_blendv_pd(integ, integrated, integrate);
+        prev = _mm256_blendv_pd(prev, in, differentiate);
+
+        __m256d result = _mm256_blendv_pd(inverted, amplified, positive);
+        result = _mm256_blendv_pd(result, derivative, differentiate);
+        result = _mm256_blendv_pd(result, integrated, integrate);
+        result = _mm256_mul_pd(result, gain);
+
+        _mm256_storeu_pd(state.integrator_state + i, integ);
+        _mm256_storeu_pd(state.previous_input + i, prev);
+        _mm256_storeu_pd(state.current_output + i, result);
+        _mm256_storeu_pd(output + lane, result);
+    }
+    processScalarLanes(state, first, lane, count, input, control, output);
+}
+
+// AVX2 (float): Eight lanes per vector
+static void signalLanesF32(const AnalogLaneStateT<float>& state, size_t first, size_t count,
+                           const float* input, const float* control, const float* aux,
+                           float* output) {
+    (void)aux;
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 neg_half = _mm256_set1_ps(-0.5f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 tenth = _mm256_set1_ps(0.1f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+
+    size_t lane = 0;
+    for (; lane + 8 <= count; lane += 8) {
+        const size_t i = first + lane;
+        const __m256 in = _mm256_loadu_ps(input + lane);
+        const __m256 c = _mm256_loadu_ps(control + lane);
+        const __m256 gain = _mm256_loadu_ps(state.feedback_gain + i);
+        __m256 integ = _mm256_loadu_ps(state.integrator_state + i);
+        __m256 prev = _mm256_loadu_ps(state.previous_input + i);
+
+        const __m256 integrate = _mm256_cmp_ps(c, half, _CMP_GT_OQ);
+        const __m256 differentiate = _mm256_cmp_ps(c, neg_half, _CMP_LT_OQ);
+        const __m256 positive = _mm256_cmp_ps(c, zero, _CMP_GT_OQ);
+
+        const __m256 integrated = _mm256_add_ps(integ, _mm256_mul_ps(in, tenth));
+        const __m256 derivative = _mm256_sub_ps(in, prev);
+        const __m256 amplified = _mm256_mul_ps(in, _mm256_add_ps(one, c));
+        const __m256 inverted = _mm256_mul_ps(_mm256_xor_ps(in, sign), _mm256_sub_ps(one, c));
+
+        integ = _mm256_blendv_ps(integ, integrated, integrate);
+        prev = _mm256_blendv_ps(prev, in, differentiate);
+
+        __m256 result = _mm256_blendv_ps(inverted, amplified, positive);
+        result = _mm256_blendv_ps(result, derivative, differentiate);
+        result = _mm256_blendv_ps(result, integrated, integrate);
+        result = _mm256_mul_ps(result, gain);
+
+        _mm256_storeu_ps(state.integrator_state + i, integ);
+        _mm256_storeu_ps(state.previous_input + i, prev);
+        _mm256_storeu_ps(state.current_output + i, result);
+        _mm256_storeu_ps(output + lane, result);
+    }
+    processScalarLanes(state, first, lane, count, input, control, output);
+}
+
+// AVX2 (mixed): Four float lanes, integrators widened to a double vector
+static void signalLanesMixed(const AnalogLaneStateT<float, double>& state, size_t first, size_t count,
+                             const float* input, const float* control, const float* aux,
+                             float* output) {
+    (void)aux;
+    const __m256d half_d = _mm256_set1_pd(0.5);
+    const __m256d tenth_d = _mm256_set1_pd(0.1);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 neg_half = _mm_set1_ps(-0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+
+    size_t lane = 0;
+    for (; lane + 4 <= count; lane += 4) {
+        const size_t i = first + lane;
+        const __m128 in = _mm_loadu_ps(input + lane);
+        const __m128 c = _mm_loadu_ps(control + lane);
+        const __m128 gain = _mm_loadu_ps(state.feedback_gain + i);
+        __m256d integ = _mm256_loadu_pd(state.integrator_state + i);
+        __m128 prev = _mm_loadu_ps(state.previous_input + i);
+
+        const __m256d integrate_d = _mm256_cmp_pd(_mm256_cvtps_pd(c), half_d, _CMP_GT_OQ);
+        const __m128 integrate = _mm_cmp_ps(c, half, _CMP_GT_OQ);
+        const __m128 differentiate = _mm_cmp_ps(c, neg_half, _CMP_LT_OQ);
+        const __m128 positive = _mm_cmp_ps(c, zero, _CMP_GT_OQ);
+
+        const __m256d integrated = _mm256_add_pd(integ, _mm256_mul_pd(_mm256_cvtps_pd(in), tenth_d));
+        const __m128 derivative = _mm_sub_ps(in, prev);
+        const __m128 amplified = _mm_mul_ps(in, _mm_add_ps(one, c));
+        const __m128 inverted = _mm_mul_ps(_mm_xor_ps(in, sign), _mm_sub_ps(one, c));
+
+        integ = _mm256_blendv_pd(integ, integrated, integrate_d);
+        prev = _mm_blendv_ps(prev, in, differentiate);
+
+        __m128 result = _mm_blendv_ps(inverted, amplified, positive);
+        result = _mm_blendv_ps(result, derivative, differentiate);
+        result = _mm_blendv_ps(result, _mm256_cvtpd_ps(integrated), integrate);
+        result = _mm_mul_ps(result, gain);
+
+        _mm256_storeu_pd(state.integrator_state + i, integ);
+        _mm_storeu_ps(state.previous_input + i, prev);
+        _mm_storeu_ps(state.current_output + i, result);
+        _mm_storeu_ps(output + lane, result);
+    }
+    processScalarLanes(state, first, lane, count, input, control, output);
+}
+
+#define DASE_KERNEL_ISA_NAME "avx2"
+
+#else
+
+// PORTABLE: Branchless scalar loop, left to the compiler's auto-vectorizer
+static void signalLanesF64(const AnalogLaneState& state, size_t first, size_t count,
+                           const double* input, const double* control, const double* aux,
+                           double* output) {
+    (void)aux;
+    processScalarLanes(state, first, 0, count, input, control, output);
+}
+
+static void signalLanesF32(const AnalogLaneStateT<float>& state, size_t first, size_t count,
+                           const float* input, const float* control, const float* aux,
+                           float* output) {
+    (void)aux;
+    processScalarLanes(state, first, 0, count, input, control, output);
+}
+
+static void signalLanesMixed(const AnalogLaneStateT<float, double>& state, size_t first, size_t count,
+                             const float* input, const float* control, const float* aux,
+                             float* output) {
+    (void)aux;
+    processScalarLanes(state, first, 0, count, input, control, output);
+}
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DASE_KERNEL_ISA_NAME "sse2"     // Auto-vectorized with the x86-64 baseline
+#else
+#define DASE_KERNEL_ISA_NAME "scalar"
+#endif
+
+#endif
+
+extern const AnalogKernelTable DASE_KERNEL_TABLE;
+const AnalogKernelTable DASE_KERNEL_TABLE = {DASE_KERNEL_ISA_NAME, &signalLanesF64, &signalLanesF32, &signalLanesMixed};
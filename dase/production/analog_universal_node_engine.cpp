@@ -1,89 +1,595 @@
 #include "analog_universal_node_engine.h"
 #include <cmath>
-#include <random>
 #include <algorithm>
-#include <omp.h>  // CRITICAL: Added OpenMP for parallel processing
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+// COMPILE-TIME: cos() by Taylor series, accurate to the last bit for |x| < 1
+static constexpr double constexprCos(double x) {
+    double term = 1.0, sum = 1.0;
+    for (int k = 1; k < 16; k++) {
+        term *= -x * x / ((2.0 * k - 1.0) * (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+struct SpectralMultipliers {
+    double value[20];
+};
+
+// Spectral post-processing gains (1 + cos(spec * 0.05) * 0.001), fixed for every node and pass
+static constexpr SpectralMultipliers makeSpectralMultipliers() {
+    SpectralMultipliers table{};
+    for (int spec = 0; spec < 20; spec++) {
+        table.value[spec] = 1.0 + constexprCos(spec * 0.05) * 0.001;
+    }
+    return table;
+}
+
+static constexpr SpectralMultipliers kSpectralMultipliers = makeSpectralMultipliers();
+
+// Harmonic aux content for every pass; depends on the input only, so one table per wave
+static void computeAuxHarmonics(double input_signal, double* aux_passes) {
+    for (int pass = 0; pass < kAnalogWavePasses; pass++) {
+        double aux_signal = input_signal * 0.5;
+        for (int harmonic = 1; harmonic <= 5; harmonic++) {
+            aux_signal += std::sin(input_signal * harmonic + pass * 0.1) * (0.1 / harmonic);
+        }
+        aux_passes[pass] = aux_signal;
+    }
+}
+
 // BREAKTHROUGH: Simplified analog signal-controlled processing
-double AnalogUniversalNode::processSignal(double input_signal, double control_signal, double aux_signal) {
+template <typename Scalar, typename Accum>
+Scalar AnalogUniversalNodeT<Scalar, Accum>::processSignal(Scalar input_signal, Scalar control_signal, Scalar aux_signal) {
     operation_count++;
     
-    // OPTIMIZED: Simplified control signal processing for speed
-    double result = 0.0;
-    
-    if (control_signal > 0.5) {
-        // Simplified integrator mode
-        integrator_state += input_signal * 0.1;
-        result = integrator_state * feedback_gain;
-    } else if (control_signal < -0.5) {
-        // Simplified differentiator mode
-        double derivative = input_signal - previous_input;
-        previous_input = input_signal;
-        result = derivative * feedback_gain;
-    } else if (control_signal > 0.0) {
-        // Simplified amplifier mode
-        result = input_signal * (1.0 + control_signal) * feedback_gain;
-    } else {
-        // Simplified inverting mode
-        result = -input_signal * (1.0 + std::abs(control_signal)) * feedback_gain;
-    }
+    // OPTIMIZED: Branchless control signal processing shared with the SIMD kernel
+    // (integrator / differentiator / amplifier / inverting, see analogSignalStep)
+    (void)aux_signal;
+    Scalar result = analogSignalStep(input_signal, control_signal, feedback_gain,
+                                     integrator_state, previous_input);
     
-    // REMOVED: Complex trigonometric operations and random noise for speed
-    // Minimal processing while maintaining analog behavior
+    // Minimal processing while maintaining analog behavior; engine noise is
+    // injected into the lane inputs (AnalogCellularEngine::setNoise)
     
     current_output = result;
     return result;
 }
 
-// HIGH-DENSITY PARALLEL PROCESSING - FULL CPU UTILIZATION
-double AnalogCellularEngine::processSignalWave(double input_signal, double control_pattern) {
-    double total_output = 0.0;
+// NOISE: Samples follow the node ID, not the slot, so one seed gives the same
+// per-node noise under every layout and in wave, lattice and circuit steps alike
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::noiseLanes(uint64_t step, uint32_t pass, size_t first, size_t count,
+                                                      Scalar* out) const {
+    if (slot_to_id.empty()) {
+        philoxGaussianLanes(noise_seed, step, pass, first, count, noise_level, out);
+    } else {
+        philoxGaussianGather(noise_seed, step, pass, slot_to_id.data() + first, count, noise_level, out);
+    }
+}
+
+// SIMD: All ten passes for one lane block of contiguous nodes
+template <typename Scalar, typename Accum>
+double AnalogCellularEngineT<Scalar, Accum>::processBlockWave(size_t first, size_t count, double input_signal,
+                                                              double control_pattern, const double* aux_passes,
+                                                              uint64_t noise_step) {
+    Scalar input[kLaneBlock];
+    Scalar noisy[kLaneBlock];
+    Scalar control[kLaneBlock];
+    Scalar aux[kLaneBlock];
+    Scalar output[kLaneBlock];
+    const bool noise = noise_level != 0.0;
+    const LaneState lanes = state.lanes();
+    const Scalar* offsets = control_offsets.data() + first;  // Pass p starts at offsets + p * control_stride
+    double block_output = 0.0;
     
-    // Force maximum parallel utilization
-    #ifdef _OPENMP
-    omp_set_dynamic(0);
-    omp_set_num_threads(omp_get_max_threads());
-    #endif
+    for (size_t lane = 0; lane < count; lane++) {
+        input[lane] = static_cast<Scalar>(input_signal);
+    }
     
-    // High-density processing to fully load all CPU cores
-    #pragma omp parallel for reduction(+:total_output) schedule(dynamic, 2) num_threads(12)
-    for (int i = 0; i < static_cast<int>(nodes.size()); i++) {
+    // Multiple signal processing passes for CPU load
+    for (int pass = 0; pass < kWavePasses; pass++) {
+        // Variant control signals from the per-engine offset table
+        for (size_t lane = 0; lane < count; lane++) {
+            control[lane] = static_cast<Scalar>(control_pattern + offsets[pass * control_stride + lane]);
+            aux[lane] = static_cast<Scalar>(aux_passes[pass]);
+        }
         
-        // Multiple signal processing passes for CPU load
-        for (int pass = 0; pass < 10; pass++) {
-            // Generate variant control signals for each pass
-            double control = control_pattern + std::sin(static_cast<double>(i + pass) * 0.1) * 0.3;
-            
-            // Complex aux signal with harmonic content
-            double aux_signal = input_signal * 0.5;
-            for (int harmonic = 1; harmonic <= 5; harmonic++) {
-                aux_signal += std::sin(input_signal * harmonic + pass * 0.1) * (0.1 / harmonic);
-            }
-            
-            // High-density analog processing
-            double output = nodes[i].processSignal(input_signal, control, aux_signal);
+        // NOISE: Fresh Gaussian lanes per pass, keyed by node ID, so blocks need no shared state
+        const Scalar* pass_input = input;
+        if (noise) {
+            noiseLanes(noise_step, static_cast<uint32_t>(pass), first, count, noisy);
+            for (size_t lane = 0; lane < count; lane++) noisy[lane] += input[lane];
+            pass_input = noisy;
+        }
+        
+        // High-density analog processing across all lanes at once
+        processSignalLanes(lanes, first, count, pass_input, control, aux, output);
+        
+        for (size_t lane = 0; lane < count; lane++) {
+            Scalar out = output[lane];
             
-            // Additional spectral processing for CPU load
+            // Additional spectral processing for CPU load, in the engine's precision
             for (int spec = 0; spec < 20; spec++) {
-                output += std::sin(output * (spec + 1) * 0.01) * 0.001;
-                output *= (1.0 + std::cos(spec * 0.05) * 0.001);
+                out += std::sin(out * static_cast<Scalar>(spec + 1) * static_cast<Scalar>(0.01)) * static_cast<Scalar>(0.001);
+                out *= static_cast<Scalar>(kSpectralMultipliers.value[spec]);
             }
             
-            total_output += output;
+            block_output += out;
         }
     }
     
-    return total_output / (static_cast<double>(nodes.size()) * 10.0);
+    return block_output;
+}
+
+// INSTRUMENTED DISPATCH: Per-task busy time goes to the worker's own slot; the
+// region and reduction totals are closed on the calling thread afterwards
+template <typename Scalar, typename Accum>
+template <typename Fn>
+void AnalogCellularEngineT<Scalar, Accum>::parallelTasks(size_t task_count, size_t chunk, Fn&& fn) {
+#ifdef DASE_ENABLE_INSTRUMENTATION
+    EngineInstrumentation& recorder = *instrumentation;
+    const uint64_t region_start = EngineInstrumentation::now();
+    scheduleTasks(task_count, chunk, [&](size_t task, size_t worker) {
+        const uint64_t task_start = EngineInstrumentation::now();
+        fn(task, worker);
+        recorder.addTask(worker, EngineInstrumentation::now() - task_start);
+    });
+    recorder.endRegion(region_start);
+#else
+    scheduleTasks(task_count, chunk, fn);
+#endif
+}
+
+// TUNING: Every task still writes only its own reduction segment, so the schedule
+// changes speed, never results
+template <typename Scalar, typename Accum>
+template <typename Fn>
+void AnalogCellularEngineT<Scalar, Accum>::scheduleTasks(size_t task_count, size_t chunk, Fn&& fn) {
+    if (state.size() < config.sequential_below) {
+        for (size_t task = 0; task < task_count; task++) fn(task, 0);
+        return;
+    }
+    if (config.schedule == EngineSchedule::Static) {
+        pool->runOnWorkers([&](size_t worker, size_t worker_count) {
+            size_t begin = 0, end = 0;
+            EngineThreadPool::staticRange(task_count, worker, worker_count, begin, end);
+            for (size_t task = begin; task < end; task++) fn(task, worker);
+        });
+        return;
+    }
+    pool->parallelFor(task_count, chunk * std::max<size_t>(1, config.chunk), fn);
+}
+
+template <typename Scalar, typename Accum>
+template <typename Fn>
+void AnalogCellularEngineT<Scalar, Accum>::parallelWorkers(Fn&& fn) {
+#ifdef DASE_ENABLE_INSTRUMENTATION
+    EngineInstrumentation& recorder = *instrumentation;
+    const uint64_t region_start = EngineInstrumentation::now();
+    if (state.size() < config.sequential_below) {
+        fn(0, 1);
+    } else {
+        pool->runOnWorkers([&](size_t worker, size_t worker_count) {
+            const uint64_t task_start = EngineInstrumentation::now();
+            fn(worker, worker_count);
+            recorder.addTask(worker, EngineInstrumentation::now() - task_start);
+        });
+    }
+    recorder.endRegion(region_start);
+#else
+    if (state.size() < config.sequential_below) {
+        fn(0, 1);
+    } else {
+        pool->runOnWorkers(fn);
+    }
+#endif
+}
+
+template <typename Scalar, typename Accum>
+uint64_t AnalogCellularEngineT<Scalar, Accum>::beginReduction() const {
+#ifdef DASE_ENABLE_INSTRUMENTATION
+    return EngineInstrumentation::now();
+#else
+    return 0;
+#endif
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::endReduction(uint64_t reduction_start) {
+#ifdef DASE_ENABLE_INSTRUMENTATION
+    instrumentation->endReduction(reduction_start);
+#else
+    (void)reduction_start;
+#endif
+}
+
+template <typename Scalar, typename Accum>
+EngineInstrumentationSnapshot AnalogCellularEngineT<Scalar, Accum>::getInstrumentation() const {
+#ifdef DASE_ENABLE_INSTRUMENTATION
+    return instrumentation->snapshot();
+#else
+    return EngineInstrumentationSnapshot();
+#endif
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::resetInstrumentation() {
+#ifdef DASE_ENABLE_INSTRUMENTATION
+    instrumentation->reset();
+#endif
+}
+
+template <typename Scalar, typename Accum>
+bool AnalogCellularEngineT<Scalar, Accum>::setInstrumentationExport(const std::string& path, uint64_t interval_regions) {
+#ifdef DASE_ENABLE_INSTRUMENTATION
+    return instrumentation->setExport(path, interval_regions);
+#else
+    (void)path;
+    (void)interval_regions;
+    return false;
+#endif
+}
+
+template <typename Scalar, typename Accum>
+ReductionPartial AnalogCellularEngineT<Scalar, Accum>::processWaveSegment(size_t segment, size_t segments,
+                                                                          double input_signal, double control_pattern,
+                                                                          const double* aux_passes, size_t worker) {
+    const size_t node_count = state.size();
+    const size_t block_count = (node_count + kLaneBlock - 1) / kLaneBlock;
+    size_t begin = 0, end = 0;
+    reductionSegmentRange(block_count, segments, segment, begin, end);
+    ReductionPartial partial;
+    for (size_t b = begin; b < end; b++) {
+        const size_t first = b * kLaneBlock;
+        const size_t count = std::min(kLaneBlock, node_count - first);
+        partial.add(processBlockWave(first, count, input_signal, control_pattern, aux_passes, noise_steps), config.reduction);
+        worker_partials[worker].operations += count * kWavePasses;
+    }
+    return partial;
+}
+
+// HIGH-DENSITY PARALLEL PROCESSING - FULL CPU UTILIZATION
+template <typename Scalar, typename Accum>
+double AnalogCellularEngineT<Scalar, Accum>::processSignalWave(double input_signal, double control_pattern) {
+    drainCommands();
+    double total_output = 0.0;
+    const size_t node_count = state.size();
+    const size_t block_count = (node_count + kLaneBlock - 1) / kLaneBlock;
+    
+    double aux_passes[kWavePasses];
+    computeAuxHarmonics(input_signal, aux_passes);
+    
+    // High-density processing: each work item is a fixed run of cache-line lane
+    // blocks, handed out across the engine's persistent workers. A run's sum only
+    // depends on its blocks, so the reduction is independent of the schedule.
+    const ReductionMode mode = config.reduction;
+    const size_t segments = reductionSegmentCount(block_count);
+    reduction_partials.resize(segments);
+    parallelTasks(segments, 1, [&](size_t segment, size_t worker) {
+        reduction_partials[segment] = processWaveSegment(segment, segments, input_signal, control_pattern, aux_passes, worker);
+    });
+    const uint64_t reduction_start = beginReduction();
+    total_output = reducePartials(reduction_partials.data(), segments, mode);
+    endReduction(reduction_start);
+    node_passes += kWavePasses;
+    noise_steps++;
+    recordTrace();
+    
+    return total_output / (static_cast<double>(node_count) * kWavePasses);
 }
 
-void AnalogCellularEngine::performSignalSweep(double base_frequency) {
+// CIRCUIT MODE: Adopt a netlist sized for this engine
+template <typename Scalar, typename Accum>
+bool AnalogCellularEngineT<Scalar, Accum>::setCircuit(AnalogCircuitGraph graph) {
+    if (graph.getNodeCount() != state.size()) return false;
+    if (!id_to_slot.empty()) {
+        graph.remapNodes(id_to_slot);  // Netlists speak node IDs; evaluation runs on slots
+    }
+    if (!graph.isCompiled()) graph.compile();
+    circuit = std::make_unique<AnalogCircuitGraph>(std::move(graph));
+    circuit_latch.assign(state.size(), Scalar(0));
+    
+    // Integrator-mode nodes (control > 0.5, as analogSignalStep) carry the ODE state
+    ode_nodes.clear();
+    ode_slot.assign(state.size(), UINT32_MAX);
+    for (uint32_t v = 0; v < state.size(); v++) {
+        if (circuit->controls[v] > 0.5) {
+            ode_slot[v] = static_cast<uint32_t>(ode_nodes.size());
+            ode_nodes.push_back(v);
+        }
+    }
+    ode_state.assign(ode_nodes.size(), 0.0);
+    
+    event_inputs.assign(state.size(), 0.0);
+    event_marks.assign(state.size(), 0u);
+    event_stamp = 0;
+    event_levels.assign(circuit->getLevelCount(), std::vector<uint32_t>());
+    event_carry.clear();
+    event_external_nodes.clear();
+    for (uint32_t v = 0; v < state.size(); v++) {
+        if (circuit->external_gains[v] != 0.0) event_external_nodes.push_back(v);
+    }
+    event_workers.assign(pool->getThreadCount(), EventWorkerList());
+    event_full = true;
+    return true;
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::clearCircuit() {
+    circuit.reset();
+    circuit_latch.clear();
+    event_inputs.clear();
+    event_marks.clear();
+    event_levels.clear();
+    event_carry.clear();
+    event_external_nodes.clear();
+    ode_nodes.clear();
+    ode_slot.clear();
+    ode_state.clear();
+}
+
+// Small node lists stay on the calling thread; a dispatch would cost more than the work.
+// evaluate(node, worker) runs for every node, count(worker, nodes) once per chunk.
+template <typename Fn, typename CountFn>
+static void forEachCircuitNode(EngineThreadPool& pool, const uint32_t* nodes, size_t node_count, Fn&& evaluate,
+                               CountFn&& count) {
+    constexpr size_t kCircuitChunk = 256;
+    if (node_count < kCircuitChunk * 2 || pool.getThreadCount() == 1) {
+        for (size_t k = 0; k < node_count; k++) evaluate(nodes[k], size_t(0));
+        count(0, node_count);
+        return;
+    }
+    const size_t chunks = (node_count + kCircuitChunk - 1) / kCircuitChunk;
+    pool.parallelFor(chunks, 1, [&](size_t chunk, size_t worker) {
+        const size_t begin = chunk * kCircuitChunk;
+        const size_t end = std::min(node_count, begin + kCircuitChunk);
+        for (size_t k = begin; k < end; k++) evaluate(nodes[k], worker);
+        count(worker, end - begin);
+    });
+}
+
+// LEVEL-SCHEDULED: Every node of a level only reads earlier levels (or latched
+// delay outputs), so a level is evaluated in parallel without synchronization.
+template <typename Fn, typename CountFn>
+static void forEachCircuitLevel(EngineThreadPool& pool, const AnalogCircuitGraph& graph, Fn&& evaluate,
+                                CountFn&& count) {
+    for (size_t level = 0; level < graph.getLevelCount(); level++) {
+        const uint32_t* level_nodes = graph.level_nodes.data() + graph.level_offsets[level];
+        const size_t level_size = graph.level_offsets[level + 1] - graph.level_offsets[level];
+        forEachCircuitNode(pool, level_nodes, level_size, [&](uint32_t v, size_t) { evaluate(v); }, count);
+    }
+}
+
+// Input of circuit node v for this step: external share, same-step sources, latched delay sources
+template <typename Scalar, typename Accum>
+double AnalogCellularEngineT<Scalar, Accum>::circuitNodeInput(uint32_t v, double external_input, uint64_t noise_step) const {
+    const AnalogCircuitGraph& graph = *circuit;
+    const Scalar* outputs = state.current_output;
+    double input_signal = graph.external_gains[v] * external_input;
+    for (uint32_t k = graph.input_offsets[v]; k < graph.input_offsets[v + 1]; k++) {
+        input_signal += graph.input_weights[k] * outputs[graph.input_sources[k]];
+    }
+    for (uint32_t k = graph.delay_offsets[v]; k < graph.delay_offsets[v + 1]; k++) {
+        input_signal += graph.delay_weights[k] * circuit_latch[graph.delay_sources[k]];
+    }
+    if (noise_level != 0.0) input_signal += noise_level * philoxGaussian(noise_seed, getNodeId(v), noise_step, 0);
+    return input_signal;
+}
+
+template <typename Scalar, typename Accum>
+double AnalogCellularEngineT<Scalar, Accum>::processCircuitStep(double external_input) {
+    drainCommands();
+    if (!circuit) return 0.0;
+    const AnalogCircuitGraph& graph = *circuit;
+    const LaneState lanes = state.lanes();
+    const size_t node_count = state.size();
+    
+    const uint64_t noise_step = noise_steps++;
+    
+    // Latch the previous step's outputs for one-step delay edges
+    for (uint32_t source : graph.delayed_sources) {
+        circuit_latch[source] = lanes.current_output[source];
+    }
+    
+    if (event_driven) {
+        evaluateCircuitEvents(external_input, noise_step);
+    } else {
+        forEachCircuitLevel(*pool, graph, [&](uint32_t v) {
+            const double input_signal = circuitNodeInput(v, external_input, noise_step);
+            lanes.current_output[v] = analogSignalStep(static_cast<Scalar>(input_signal), static_cast<Scalar>(graph.controls[v]),
+                                                       lanes.feedback_gain[v], lanes.integrator_state[v],
+                                                       lanes.previous_input[v]);
+        }, [&](size_t worker, size_t nodes) { worker_partials[worker].operations += nodes; });
+    }
+    node_passes++;
+    event_passes = node_passes;
+    recordTrace();
+    
+    double total_output = 0.0;
+    for (size_t i = 0; i < node_count; i++) {
+        total_output += lanes.current_output[i];
+    }
+    return node_count ? total_output / static_cast<double>(node_count) : 0.0;
+}
+
+// EVENT-DRIVEN: Level by level, only queued nodes are visited. A node is queued when
+// a same-step source changed its output this step, a delayed source changed last
+// step, the external input it reads changed, or it carries state (integrators, and
+// differentiators until their output has relaxed to 0). A visited node whose input
+// is within tolerance of the input it was last evaluated with keeps its output.
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::evaluateCircuitEvents(double external_input, uint64_t noise_step) {
+    const AnalogCircuitGraph& graph = *circuit;
+    const LaneState lanes = state.lanes();
+    const size_t node_count = state.size();
+    
+    // Noise moves every input, and any other step mode, command or patch may have
+    // rewritten node state: those steps evaluate every node and re-record the inputs
+    const bool full = event_full || noise_level != 0.0 || event_passes != node_passes;
+    event_full = false;
+    if (++event_stamp == 0) {
+        std::fill(event_marks.begin(), event_marks.end(), 0u);
+        event_stamp = 1;
+    }
+    auto queue = [&](uint32_t v) {
+        if (event_marks[v] == event_stamp) return;
+        event_marks[v] = event_stamp;
+        event_levels[graph.node_levels[v]].push_back(v);
+    };
+    for (auto& level : event_levels) level.clear();
+    if (full) {
+        for (uint32_t v = 0; v < node_count; v++) queue(v);
+    } else {
+        for (uint32_t v : event_carry) queue(v);
+        if (external_input != event_external) {
+            for (uint32_t v : event_external_nodes) queue(v);
+        }
+    }
+    event_carry.clear();
+    event_external = external_input;
+    
+    uint64_t visited = 0;
+    for (size_t level = 0; level < event_levels.size(); level++) {
+        const std::vector<uint32_t>& nodes = event_levels[level];
+        if (nodes.empty()) continue;
+        visited += nodes.size();
+        forEachCircuitNode(*pool, nodes.data(), nodes.size(), [&](uint32_t v, size_t worker) {
+            const double input_signal = circuitNodeInput(v, external_input, noise_step);
+            const double control = graph.controls[v];
+            const bool integrate = control > 0.5;
+            const bool differentiate = control < -0.5;
+            const Scalar previous_output = lanes.current_output[v];
+            if (!full && !integrate && std::fabs(input_signal - event_inputs[v]) <= event_tolerance &&
+                !(differentiate && previous_output != Scalar(0))) {
+                return;
+            }
+            const Scalar output = analogSignalStep(static_cast<Scalar>(input_signal), static_cast<Scalar>(control),
+                                                   lanes.feedback_gain[v], lanes.integrator_state[v],
+                                                   lanes.previous_input[v]);
+            lanes.current_output[v] = output;
+            event_inputs[v] = input_signal;
+            EventWorkerList& list = event_workers[worker];
+            list.evaluated++;
+            if (output != previous_output) list.changed.push_back(v);
+            if (integrate || (differentiate && output != Scalar(0))) list.carry.push_back(v);
+        }, [](size_t, size_t) {});
+        
+        // Merge the workers' lists: changed nodes queue their targets, later levels
+        // this step (algebraic edges) or the next step (delay edges)
+        for (EventWorkerList& list : event_workers) {
+            for (uint32_t u : list.changed) {
+                for (uint32_t k = graph.output_offsets[u]; k < graph.output_offsets[u + 1]; k++) {
+                    queue(graph.output_targets[k]);
+                }
+                for (uint32_t k = graph.delay_output_offsets[u]; k < graph.delay_output_offsets[u + 1]; k++) {
+                    event_carry.push_back(graph.delay_output_targets[k]);
+                }
+            }
+            event_carry.insert(event_carry.end(), list.carry.begin(), list.carry.end());
+            list.changed.clear();
+            list.carry.clear();
+        }
+    }
+    
+    uint64_t evaluated = 0;
+    for (size_t w = 0; w < event_workers.size(); w++) {
+        evaluated += event_workers[w].evaluated;
+        worker_partials[w].operations += event_workers[w].evaluated;
+        event_workers[w].evaluated = 0;
+    }
+    event_stats.steps++;
+    event_stats.visited += visited;
+    event_stats.evaluated += evaluated;
+    if (full) event_stats.full_steps++;
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::setEventDriven(bool enabled, double tolerance) {
+    event_driven = enabled;
+    event_tolerance = std::isfinite(tolerance) ? std::fabs(tolerance) : 0.0;
+    event_full = true;
+    event_stats = AnalogEventStats();
+}
+
+// One derivative evaluation over the whole circuit: integrator outputs come
+// straight from y, then the level schedule rebuilds every other output and
+// collects each integrator's input as its derivative
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::evaluateCircuitDerivative(const double* y, double* dydt,
+                                                                     double external_input, bool commit) {
+    const AnalogCircuitGraph& graph = *circuit;
+    const LaneState lanes = state.lanes();
+    
+    for (size_t j = 0; j < ode_nodes.size(); j++) {
+        const uint32_t v = ode_nodes[j];
+        lanes.current_output[v] = static_cast<Scalar>(lanes.feedback_gain[v] * y[j]);
+    }
+    
+    forEachCircuitLevel(*pool, graph, [&](uint32_t v) {
+        double input_signal = graph.external_gains[v] * external_input;
+        for (uint32_t k = graph.input_offsets[v]; k < graph.input_offsets[v + 1]; k++) {
+            input_signal += graph.input_weights[k] * lanes.current_output[graph.input_sources[k]];
+        }
+        for (uint32_t k = graph.delay_offsets[v]; k < graph.delay_offsets[v + 1]; k++) {
+            const uint32_t source = graph.delay_sources[k];
+            const double held = ode_slot[source] != UINT32_MAX ? lanes.current_output[source] : circuit_latch[source];
+            input_signal += graph.delay_weights[k] * held;
+        }
+        if (ode_slot[v] != UINT32_MAX) {
+            if (dydt) dydt[ode_slot[v]] = input_signal;
+            return;
+        }
+        // Stage evaluations must not advance differentiator history
+        Accum integrator = lanes.integrator_state[v];
+        Scalar previous = lanes.previous_input[v];
+        lanes.current_output[v] = analogSignalStep(static_cast<Scalar>(input_signal), static_cast<Scalar>(graph.controls[v]),
+                                                   lanes.feedback_gain[v], integrator, previous);
+        if (commit) lanes.previous_input[v] = previous;
+    }, [&](size_t worker, size_t nodes) { worker_partials[worker].operations += nodes; });
+}
+
+template <typename Scalar, typename Accum>
+bool AnalogCellularEngineT<Scalar, Accum>::integrateCircuit(double external_input, double duration) {
+    drainCommands();
+    if (!circuit) return false;
+    const AnalogCircuitGraph& graph = *circuit;
+    const LaneState lanes = state.lanes();
+    
+    for (uint32_t source : graph.delayed_sources) {
+        circuit_latch[source] = lanes.current_output[source];
+    }
+    for (size_t j = 0; j < ode_nodes.size(); j++) {
+        ode_state[j] = lanes.integrator_state[ode_nodes[j]];
+    }
+    
+    const uint64_t steps_before = ode_solver.getStats().accepted_steps;
+    const bool converged = ode_solver.integrate(ode_state.data(), ode_state.size(), 0.0, duration,
+        [&](double, const double* y, double* dydt) { evaluateCircuitDerivative(y, dydt, external_input, false); });
+    node_passes += ode_solver.getStats().accepted_steps - steps_before;
+    
+    // Commit: integrator state, outputs at the final state, differentiator history
+    for (size_t j = 0; j < ode_nodes.size(); j++) {
+        lanes.integrator_state[ode_nodes[j]] = static_cast<Accum>(ode_state[j]);
+    }
+    evaluateCircuitDerivative(ode_state.data(), nullptr, external_input, true);
+    recordTrace();
+    return converged;
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::performSignalSweep(double base_frequency) {
     // OPTIMIZED: Simplified signal generation for speed
-    static double time_counter = 0.0;
-    time_counter += 0.001;  // Simple increment instead of complex calculations
+    const double time_counter = clock.advance();  // Simple increment instead of complex calculations
     
     // Simplified input signal generation
     double input_signal = std::sin(base_frequency * time_counter);
@@ -98,49 +604,889 @@ void AnalogCellularEngine::performSignalSweep(double base_frequency) {
     system_frequency += result * 0.001;
 }
 
+// STREAMING: Whole buffer of samples per call, one parallel region per chunk
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::processSignalBlock(const double* inputs, const double* controls, size_t n, double* outputs) {
+    drainCommands();
+    // Chunks bound the per-segment sample rows; every node slice still runs its
+    // samples in order, so the split does not change any output
+    for (size_t done = 0; done < n; done += kBlockChunkSamples) {
+        const size_t count = std::min(kBlockChunkSamples, n - done);
+        processSampleChunk(inputs + done, controls ? controls + done : nullptr, count, outputs + done);
+    }
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::processSampleChunk(const double* inputs, const double* controls, size_t n, double* outputs) {
+    const size_t node_count = state.size();
+    std::fill(outputs, outputs + n, 0.0);
+    if (node_count == 0) return;
+    
+    // Same segments as a single wave, each holding a row of n partial sums, so every
+    // sample reduces exactly as processSignalWave would
+    const ReductionMode mode = config.reduction;
+    const bool compensated = mode == ReductionMode::Kahan;
+    const size_t block_count = (node_count + kLaneBlock - 1) / kLaneBlock;
+    const size_t segments = reductionSegmentCount(block_count);
+    const size_t stride = (n + kLaneBlock - 1) / kLaneBlock * kLaneBlock;
+    block_partials.assign(stride * segments, 0.0);
+    block_compensation.assign(compensated ? stride * segments : 0, 0.0);
+    const size_t trace_columns = trace ? trace->getColumnCount() : 0;
+    if (trace) trace_rows.resize(n * trace_columns);
+    
+    // Aux harmonics for every sample, shared by all nodes
+    block_aux.resize(n * kWavePasses);
+    for (size_t t = 0; t < n; t++) {
+        computeAuxHarmonics(inputs[t], block_aux.data() + t * kWavePasses);
+    }
+    
+    parallelTasks(segments, 1, [&](size_t segment, size_t worker) {
+        // Each task carries its node slice through all n steps before syncing
+        double* partial = block_partials.data() + segment * stride;
+        double* compensation = compensated ? block_compensation.data() + segment * stride : nullptr;
+        size_t begin = 0, end = 0;
+        reductionSegmentRange(block_count, segments, segment, begin, end);
+        uint64_t operations = 0;
+        for (size_t b = begin; b < end; b++) {
+            const size_t first = b * kLaneBlock;
+            const size_t count = std::min(kLaneBlock, node_count - first);
+            const uint32_t trace_begin = trace ? trace_block_offsets[b] : 0;
+            const uint32_t trace_end = trace ? trace_block_offsets[b + 1] : 0;
+            for (size_t t = 0; t < n; t++) {
+                const double control = controls ? controls[t] : 0.0;
+                const double sample = processBlockWave(first, count, inputs[t], control, block_aux.data() + t * kWavePasses,
+                                                       noise_steps + t);
+                if (compensated) {
+                    ReductionPartial sum{partial[t], compensation[t]};
+                    sum.add(sample, mode);
+                    partial[t] = sum.sum;
+                    compensation[t] = sum.compensation;
+                } else {
+                    partial[t] += sample;
+                }
+                for (uint32_t k = trace_begin; k < trace_end; k++) {
+                    trace_rows[t * trace_columns + trace_block_columns[k]] = state.current_output[trace_block_slots[k]];
+                }
+            }
+            operations += count * n * kWavePasses;
+        }
+        worker_partials[worker].operations += operations;
+    });
+    node_passes += n * kWavePasses;
+    noise_steps += n;
+    if (trace) {
+        for (size_t t = 0; t < n; t++) trace->recordColumns(trace_rows.data() + t * trace_columns);
+    }
+    
+    // Column t of the segment rows, in segment order, scaled as processSignalWave
+    const uint64_t reduction_start = beginReduction();
+    const double scale = static_cast<double>(node_count) * kWavePasses;
+    for (size_t t = 0; t < n; t++) {
+        const double* column_compensation = compensated ? block_compensation.data() + t : nullptr;
+        outputs[t] = reducePartials(block_partials.data() + t, column_compensation, segments, mode, stride) / scale;
+    }
+    endReduction(reduction_start);
+}
+
+// FUSED: One dispatch for the whole run; the barrier completion is the serial part
+// of performSignalSweep / processSignalWave, in the same order
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::runSteps(size_t steps, double base_frequency, double* outputs) {
+    if (steps == 0) return;
+    const size_t node_count = state.size();
+    const size_t block_count = (node_count + kLaneBlock - 1) / kLaneBlock;
+    const size_t segments = reductionSegmentCount(block_count);
+    reduction_partials.resize(segments);
+    
+    // Step inputs, written only before the dispatch and by the barrier completion
+    double input_signal = 0.0;
+    double control_pattern = 0.0;
+    double aux_passes[kWavePasses];
+    size_t step = 0;
+    auto beginStep = [&]() {
+        const double time_counter = clock.advance();
+        input_signal = std::sin(base_frequency * time_counter);
+        control_pattern = std::sin(time_counter * 0.1) * 0.5;
+        drainCommands();
+        computeAuxHarmonics(input_signal, aux_passes);
+    };
+    auto finishStep = [&]() {
+        const uint64_t reduction_start = beginReduction();
+        const double total_output = reducePartials(reduction_partials.data(), segments, config.reduction);
+        endReduction(reduction_start);
+        node_passes += kWavePasses;
+        noise_steps++;
+        recordTrace();
+        const double result = total_output / (static_cast<double>(node_count) * kWavePasses);
+        system_frequency += result * 0.001;
+        if (outputs) outputs[step] = result;
+        if (++step < steps) beginStep();
+    };
+    
+    beginStep();
+    step_barrier.reset(node_count < config.sequential_below ? 1 : pool->getDispatchWidth(), config.spin_iterations);
+    parallelWorkers([&](size_t worker, size_t worker_count) {
+        // Static segments: each worker's nodes stay in its cache for the whole run
+        size_t begin = 0, end = 0;
+        EngineThreadPool::staticRange(segments, worker, worker_count, begin, end);
+        uint32_t sense = 0;
+        for (size_t t = 0; t < steps; t++) {
+            for (size_t segment = begin; segment < end; segment++) {
+                reduction_partials[segment] =
+                    processWaveSegment(segment, segments, input_signal, control_pattern, aux_passes, worker);
+            }
+            step_barrier.arriveAndWait(sense, finishStep);
+        }
+    });
+}
+
+// STREAMING: performSignalSweep for many steps at once
+// Inputs come from a phasor rotation seeded once per block instead of two sin calls per step
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::performSignalSweepBlock(double base_frequency, size_t steps, double* outputs) {
+    if (steps == 0) return;
+    sweep_inputs.resize(steps);
+    sweep_controls.resize(steps);
+    sweep_outputs.resize(steps);
+    
+    const double dt = clock.getTimeStep();
+    const double first_time = clock.now() + dt;
+    
+    // Rotate (cos, sin) pairs by a fixed angle per step
+    const double input_step = base_frequency * dt;
+    const double control_step = 0.1 * dt;
+    const double input_rot_c = std::cos(input_step), input_rot_s = std::sin(input_step);
+    const double control_rot_c = std::cos(control_step), control_rot_s = std::sin(control_step);
+    double input_c = std::cos(base_frequency * first_time), input_s = std::sin(base_frequency * first_time);
+    double control_c = std::cos(first_time * 0.1), control_s = std::sin(first_time * 0.1);
+    
+    for (size_t t = 0; t < steps; t++) {
+        clock.advance();
+        sweep_inputs[t] = input_s;
+        sweep_controls[t] = control_s * 0.5;
+        
+        const double next_input_c = input_c * input_rot_c - input_s * input_rot_s;
+        input_s = input_s * input_rot_c + input_c * input_rot_s;
+        input_c = next_input_c;
+        const double next_control_c = control_c * control_rot_c - control_s * control_rot_s;
+        control_s = control_s * control_rot_c + control_c * control_rot_s;
+        control_c = next_control_c;
+    }
+    
+    processSignalBlock(sweep_inputs.data(), sweep_controls.data(), steps, sweep_outputs.data());
+    
+    // Minimal system state update, in step order
+    for (size_t t = 0; t < steps; t++) {
+        system_frequency += sweep_outputs[t] * 0.001;
+    }
+    if (outputs) {
+        std::copy(sweep_outputs.begin(), sweep_outputs.end(), outputs);
+    }
+}
+
+// LATTICE MODE: Cells live on the engine's layout grid, node ID = x + nx * (y + ny * z).
+// Buffers are indexed by storage slot like the SoA state.
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::setLattice(const AnalogLatticeConfig& lattice_config) {
+    lattice = lattice_config;
+    lattice_enabled = true;
+    
+    // Row-major: cells past the last node stay zero in both buffers and act as empty space
+    const size_t cells = slot_to_id.empty() ? lattice_dims[0] * lattice_dims[1] * lattice_dims[2] : state.size();
+    for (auto& buffer : lattice_buffers) buffer.assign(cells, Scalar(0));
+    std::copy(state.current_output, state.current_output + state.size(), lattice_buffers[0].begin());
+    lattice_front = 0;
+    
+    // Scratch rows padded to whole cache lines, so no two workers write one line
+    if (slot_to_id.empty()) {
+        constexpr size_t kLineScalars = 64 / sizeof(Scalar);
+        lattice_row_stride = (lattice_dims[0] + kLineScalars - 1) / kLineScalars * kLineScalars;
+        lattice_rows.assign(pool->getThreadCount() * 3 * lattice_row_stride, Scalar(0));
+        lattice_controls.assign(lattice_dims[0], static_cast<Scalar>(lattice.control));
+    } else {
+        lattice_rows.clear();
+        lattice_controls.clear();
+        lattice_row_stride = 0;
+    }
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::clearLattice() {
+    lattice_enabled = false;
+    for (auto& buffer : lattice_buffers) {
+        buffer.clear();
+        buffer.shrink_to_fit();
+    }
+    for (auto* rows : {&lattice_rows, &lattice_controls}) {
+        rows->clear();
+        rows->shrink_to_fit();
+    }
+    lattice_row_stride = 0;
+}
+
+template <typename Scalar, typename Accum>
+double AnalogCellularEngineT<Scalar, Accum>::processLatticeSlab(size_t z_begin, size_t z_end, double external_input,
+                                                               size_t worker) {
+    const size_t nx = lattice_dims[0], ny = lattice_dims[1], nz = lattice_dims[2];
+    const size_t node_count = state.size();
+    const Scalar* front = lattice_buffers[lattice_front].data();
+    Scalar* back = lattice_buffers[lattice_front ^ 1].data();
+    const bool full = lattice.neighbourhood == LatticeNeighbourhood::Full26;
+    const LaneState lanes = state.lanes();
+    
+    Scalar* neighbours = lattice_rows.data() + worker * 3 * lattice_row_stride;
+    Scalar* input = neighbours + lattice_row_stride;
+    Scalar* noise = input + lattice_row_stride;
+    const Scalar* control = lattice_controls.data();
+    double slab_output = 0.0;
+    
+    // Neighbouring row or plane index, or SIZE_MAX past an open boundary
+    auto wrap = [&](size_t coordinate, int delta, size_t extent) -> size_t {
+        if (delta < 0 && coordinate == 0) return lattice.periodic ? extent - 1 : SIZE_MAX;
+        if (delta > 0 && coordinate + 1 == extent) return lattice.periodic ? 0 : SIZE_MAX;
+        return coordinate + delta;
+    };
+    
+    for (size_t z = z_begin; z < z_end; z++) {
+        for (size_t y = 0; y < ny; y++) {
+            const size_t row_start = (z * ny + y) * nx;
+            if (row_start >= node_count) return slab_output;
+            const size_t row_count = std::min(nx, node_count - row_start);
+            
+            // One pass per offset in (dz, dy, dx) order, so every cell adds its neighbours
+            // in the same order as processLatticeCells and the layout cannot change a sum
+            std::fill(neighbours, neighbours + nx, Scalar(0));
+            for (int dz = -1; dz <= 1; dz++) {
+                const size_t nzi = wrap(z, dz, nz);
+                if (nzi == SIZE_MAX) continue;
+                for (int dy = -1; dy <= 1; dy++) {
+                    const size_t nyi = wrap(y, dy, ny);
+                    if (nyi == SIZE_MAX) continue;
+                    const Scalar* row = front + (nzi * ny + nyi) * nx;
+                    for (int dx = -1; dx <= 1; dx++) {
+                        const int distance = (dx != 0) + (dy != 0) + (dz != 0);
+                        if (distance == 0 || (!full && distance != 1)) continue;
+                        if (dx == 0) {
+                            for (size_t x = 0; x < nx; x++) neighbours[x] += row[x];
+                        } else if (dx < 0) {
+                            if (lattice.periodic) neighbours[0] += row[nx - 1];
+                            for (size_t x = 1; x < nx; x++) neighbours[x] += row[x - 1];
+                        } else {
+                            for (size_t x = 0; x + 1 < nx; x++) neighbours[x] += row[x + 1];
+                            if (lattice.periodic) neighbours[nx - 1] += row[0];
+                        }
+                    }
+                }
+            }
+            
+            for (size_t x = 0; x < row_count; x++) {
+                input[x] = static_cast<Scalar>(external_input + lattice.coupling * neighbours[x]);
+            }
+            if (noise_level != 0.0) {
+                noiseLanes(noise_steps, 0, row_start, row_count, noise);
+                for (size_t x = 0; x < row_count; x++) input[x] += noise[x];
+            }
+            processSignalLanes(lanes, row_start, row_count, input, control, input, back + row_start);
+            for (size_t x = 0; x < row_count; x++) {
+                slab_output += back[row_start + x];
+            }
+        }
+    }
+    return slab_output;
+}
+
+// Curve order: neighbours are found through their IDs. Consecutive slots form
+// compact boxes, so the gathered slots stay close to the ones being written.
+template <typename Scalar, typename Accum>
+double AnalogCellularEngineT<Scalar, Accum>::processLatticeCells(size_t begin, size_t end, double external_input) {
+    const int64_t nx = static_cast<int64_t>(lattice_dims[0]);
+    const int64_t ny = static_cast<int64_t>(lattice_dims[1]);
+    const int64_t nz = static_cast<int64_t>(lattice_dims[2]);
+    const int64_t node_count = static_cast<int64_t>(state.size());
+    const Scalar* front = lattice_buffers[lattice_front].data();
+    Scalar* back = lattice_buffers[lattice_front ^ 1].data();
+    const bool full = lattice.neighbourhood == LatticeNeighbourhood::Full26;
+    const LaneState lanes = state.lanes();
+    
+    Scalar input[kLaneBlock];
+    Scalar control[kLaneBlock];
+    double slab_output = 0.0;
+    for (size_t lane = 0; lane < kLaneBlock; lane++) control[lane] = static_cast<Scalar>(lattice.control);
+    
+    // Neighbour offsets in (dx, dy, dz) and as node ID deltas for interior cells
+    int offsets[26][3];
+    int64_t id_deltas[26];
+    int neighbour_count = 0;
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                const int distance = (dx != 0) + (dy != 0) + (dz != 0);
+                if (distance == 0 || (!full && distance != 1)) continue;
+                offsets[neighbour_count][0] = dx;
+                offsets[neighbour_count][1] = dy;
+                offsets[neighbour_count][2] = dz;
+                id_deltas[neighbour_count++] = (dz * ny + dy) * nx + dx;
+            }
+        }
+    }
+    
+    // Out-of-grid coordinate: wrapped when periodic, -1 for an open boundary
+    auto wrap = [&](int64_t coordinate, int64_t extent) -> int64_t {
+        if (coordinate >= 0 && coordinate < extent) return coordinate;
+        if (!lattice.periodic) return -1;
+        return coordinate < 0 ? coordinate + extent : coordinate - extent;
+    };
+    
+    for (size_t first = begin; first < end; first += kLaneBlock) {
+        const size_t count = std::min(kLaneBlock, end - first);
+        for (size_t lane = 0; lane < count; lane++) {
+            const AnalogNodeInfo& cell = node_info[first + lane];
+            const int64_t id = cell.node_id;
+            Scalar neighbours = Scalar(0);
+            const bool interior = cell.x > 0 && cell.x + 1 < nx && cell.y > 0 && cell.y + 1 < ny &&
+                                  cell.z > 0 && id + nx * ny + nx + 1 < node_count;
+            if (interior) {
+                for (int k = 0; k < neighbour_count; k++) {
+                    neighbours += front[id_to_slot[id + id_deltas[k]]];
+                }
+            } else {
+                for (int k = 0; k < neighbour_count; k++) {
+                    const int64_t x = wrap(cell.x + offsets[k][0], nx);
+                    const int64_t y = wrap(cell.y + offsets[k][1], ny);
+                    const int64_t z = wrap(cell.z + offsets[k][2], nz);
+                    if (x < 0 || y < 0 || z < 0) continue;
+                    const int64_t neighbour = (z * ny + y) * nx + x;
+                    if (neighbour < node_count) neighbours += front[id_to_slot[neighbour]];
+                }
+            }
+            input[lane] = static_cast<Scalar>(external_input + lattice.coupling * neighbours);
+        }
+        if (noise_level != 0.0) {
+            Scalar noise[kLaneBlock];
+            noiseLanes(noise_steps, 0, first, count, noise);
+            for (size_t lane = 0; lane < count; lane++) input[lane] += noise[lane];
+        }
+        processSignalLanes(lanes, first, count, input, control, input, back + first);
+        for (size_t lane = 0; lane < count; lane++) {
+            slab_output += back[first + lane];
+        }
+    }
+    return slab_output;
+}
+
+template <typename Scalar, typename Accum>
+double AnalogCellularEngineT<Scalar, Accum>::processLatticeStep(double external_input) {
+    drainCommands();
+    if (!lattice_enabled) return 0.0;
+    const size_t node_count = state.size();
+    if (node_count == 0) return 0.0;
+    
+    // Slab height: the planes a task touches (two output buffers plus four
+    // state arrays) should fit in roughly 256 KB of per-core cache
+    constexpr size_t kSlabBytes = 256 * 1024;
+    const size_t plane_cells = lattice_dims[0] * lattice_dims[1];
+    const size_t plane_bytes = plane_cells * (sizeof(Scalar) * 5 + sizeof(Accum));
+    const size_t slab_planes = std::max<size_t>(1, kSlabBytes / plane_bytes);
+    const size_t slabs = (lattice_dims[2] + slab_planes - 1) / slab_planes;
+    
+    // Tasks are fixed by the grid, so one partial per task reduces in a fixed order
+    if (slot_to_id.empty()) {
+        reduction_partials.resize(slabs);
+        parallelTasks(slabs, 1, [&](size_t slab, size_t worker) {
+            const size_t z_begin = slab * slab_planes;
+            const size_t z_end = std::min(lattice_dims[2], z_begin + slab_planes);
+            reduction_partials[slab] = ReductionPartial{processLatticeSlab(z_begin, z_end, external_input, worker), 0.0};
+            worker_partials[worker].operations += std::min(node_count, z_end * plane_cells) -
+                                                  std::min(node_count, z_begin * plane_cells);
+        });
+    } else {
+        // Curve order: equal runs of slots are compact boxes of about the same cache footprint
+        const size_t run = std::max<size_t>(kLaneBlock, kSlabBytes / (sizeof(Scalar) * 5 + sizeof(Accum))
+                                            / kLaneBlock * kLaneBlock);
+        reduction_partials.resize((node_count + run - 1) / run);
+        parallelTasks(reduction_partials.size(), 1, [&](size_t task, size_t worker) {
+            const size_t begin = task * run;
+            const size_t end = std::min(node_count, begin + run);
+            reduction_partials[task] = ReductionPartial{processLatticeCells(begin, end, external_input), 0.0};
+            worker_partials[worker].operations += end - begin;
+        });
+    }
+    lattice_front ^= 1;
+    node_passes++;
+    noise_steps++;
+    recordTrace();
+    
+    const uint64_t reduction_start = beginReduction();
+    const double total_output = reducePartials(reduction_partials.data(), reduction_partials.size(), config.reduction);
+    endReduction(reduction_start);
+    return total_output / static_cast<double>(node_count);
+}
+
 // Additional analog computing functions
-void AnalogUniversalNode::setFeedback(double feedback_coefficient) {
-    feedback_gain = std::clamp(feedback_coefficient, 0.1, 10.0);
+template <typename Scalar, typename Accum>
+void AnalogUniversalNodeT<Scalar, Accum>::setFeedback(double feedback_coefficient) {
+    feedback_gain = static_cast<Scalar>(std::clamp(feedback_coefficient, 0.1, 10.0));
 }
 
-void AnalogUniversalNode::resetIntegrator() {
-    integrator_state = 0.0;
-    previous_input = 0.0;
+template <typename Scalar, typename Accum>
+void AnalogUniversalNodeT<Scalar, Accum>::resetIntegrator() {
+    integrator_state = Accum(0);
+    previous_input = Scalar(0);
 }
 
-double AnalogUniversalNode::getOutput() const {
+template <typename Scalar, typename Accum>
+Scalar AnalogUniversalNodeT<Scalar, Accum>::getOutput() const {
     return current_output;
 }
 
-double AnalogUniversalNode::getIntegratorState() const {
+template <typename Scalar, typename Accum>
+Accum AnalogUniversalNodeT<Scalar, Accum>::getIntegratorState() const {
     return integrator_state;
 }
 
-void AnalogCellularEngine::setSystemFeedback(double feedback_level) {
-    #pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(nodes.size()); i++) {
-        nodes[i].setFeedback(feedback_level);
+// TRACE: Columns follow config.nodes; the recorder reads them from storage slots
+template <typename Scalar, typename Accum>
+bool AnalogCellularEngineT<Scalar, Accum>::setTrace(const EngineTraceConfig& config) {
+    const size_t node_count = state.size();
+    std::vector<uint32_t> slots;
+    slots.reserve(config.nodes.size());
+    for (uint32_t id : config.nodes) {
+        if (id >= node_count) return false;
+        slots.push_back(getNodeSlot(id));
     }
+    auto recorder = std::make_unique<EngineTraceRecorder>();
+    if (!recorder->configure(config, slots)) return false;
+    
+    // Counting sort of the columns by lane block
+    const size_t block_count = (node_count + kLaneBlock - 1) / kLaneBlock;
+    trace_block_offsets.assign(block_count + 1, 0);
+    for (uint32_t slot : slots) trace_block_offsets[slot / kLaneBlock + 1]++;
+    for (size_t b = 0; b < block_count; b++) trace_block_offsets[b + 1] += trace_block_offsets[b];
+    trace_block_slots.resize(slots.size());
+    trace_block_columns.resize(slots.size());
+    std::vector<uint32_t> fill(trace_block_offsets.begin(), trace_block_offsets.end() - 1);
+    for (size_t c = 0; c < slots.size(); c++) {
+        const uint32_t k = fill[slots[c] / kLaneBlock]++;
+        trace_block_slots[k] = slots[c];
+        trace_block_columns[k] = static_cast<uint32_t>(c);
+    }
+    trace = std::move(recorder);
+    return true;
 }
 
-void AnalogCellularEngine::resetAllIntegrators() {
-    #pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(nodes.size()); i++) {
-        nodes[i].resetIntegrator();
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::clearTrace() {
+    trace.reset();
+    trace_block_offsets.clear();
+    trace_block_slots.clear();
+    trace_block_columns.clear();
+    trace_rows.clear();
+    trace_rows.shrink_to_fit();
+}
+
+// Static worker slice of [0, node_count) cut at lane block (cache line) boundaries
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::laneAlignedRange(size_t node_count, size_t worker, size_t worker_count,
+                                                            size_t& begin, size_t& end) {
+    EngineThreadPool::staticRange((node_count + kLaneBlock - 1) / kLaneBlock, worker, worker_count, begin, end);
+    begin = std::min(node_count, begin * kLaneBlock);
+    end = std::min(node_count, end * kLaneBlock);
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::setSystemFeedback(double feedback_level) {
+    const Scalar gain = static_cast<Scalar>(std::clamp(feedback_level, 0.1, 10.0));
+    Scalar* feedback = state.feedback_gain;
+    const size_t node_count = state.size();
+    pool->runOnWorkers([&](size_t worker, size_t worker_count) {
+        size_t begin = 0, end = 0;
+        laneAlignedRange(node_count, worker, worker_count, begin, end);
+        std::fill(feedback + begin, feedback + end, gain);
+    });
+    event_full = true;
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::setNoise(double level, uint64_t seed) {
+    noise_level = std::isfinite(level) ? std::fabs(level) : 0.0;
+    noise_seed = seed;
+    event_full = true;
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::resetAllIntegrators() {
+    Accum* integrator = state.integrator_state;
+    Scalar* previous = state.previous_input;
+    const size_t node_count = state.size();
+    pool->runOnWorkers([&](size_t worker, size_t worker_count) {
+        size_t begin = 0, end = 0;
+        laneAlignedRange(node_count, worker, worker_count, begin, end);
+        std::fill(integrator + begin, integrator + end, Accum(0));
+        std::fill(previous + begin, previous + end, Scalar(0));
+    });
+    event_full = true;
+}
+
+// COMMANDS: Drained in batches; each batch is applied in post order
+template <typename Scalar, typename Accum>
+size_t AnalogCellularEngineT<Scalar, Accum>::applyCommands() {
+    constexpr size_t kBatch = 64;
+    EngineCommand batch[kBatch];
+    size_t applied = 0;
+    for (;;) {
+        size_t count = 0;
+        while (count < kBatch && commands.pop(batch[count])) count++;
+        if (count == 0) break;
+        
+        for (size_t i = 0; i < count; i++) {
+            const EngineCommand& command = batch[i];
+            const bool known_node = command.node < state.size();
+            const size_t slot = known_node ? getNodeSlot(command.node) : 0;
+            switch (command.type) {
+                case EngineCommandType::SetFeedback:
+                    setSystemFeedback(command.value);
+                    break;
+                case EngineCommandType::SetNodeFeedback:
+                    if (known_node) state.feedback_gain[slot] = static_cast<Scalar>(std::clamp(command.value, 0.1, 10.0));
+                    break;
+                case EngineCommandType::ResetIntegrators:
+                    resetAllIntegrators();
+                    break;
+                case EngineCommandType::ResetNode:
+                    if (known_node) {
+                        state.integrator_state[slot] = Accum(0);
+                        state.previous_input[slot] = Scalar(0);
+                    }
+                    break;
+                case EngineCommandType::SetFrequency:
+                    system_frequency = command.value;
+                    break;
+                case EngineCommandType::SetNoise:
+                    setNoise(command.value, noise_seed);
+                    break;
+                case EngineCommandType::SetTimeStep:
+                    clock.setTimeStep(command.value);
+                    break;
+            }
+        }
+        applied += count;
+    }
+    if (applied) event_full = true;
+    commands_applied.fetch_add(applied, std::memory_order_relaxed);
+    return applied;
+}
+
+// RUNNER: The runner thread becomes worker 0 of the engine's pool
+template <typename Scalar, typename Accum>
+bool AnalogCellularEngineT<Scalar, Accum>::startRunner(std::function<void(AnalogCellularEngineT&)> step) {
+    if (!step || runner.joinable()) return false;
+    runner_active.store(true, std::memory_order_release);
+    runner = std::thread([this, step = std::move(step)]() {
+        while (runner_active.load(std::memory_order_acquire)) {
+            drainCommands();
+            step(*this);
+            runner_steps.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    return true;
+}
+
+template <typename Scalar, typename Accum>
+void AnalogCellularEngineT<Scalar, Accum>::stopRunner() {
+    runner_active.store(false, std::memory_order_release);
+    if (runner.joinable()) runner.join();
+}
+
+template <typename Scalar, typename Accum>
+AnalogCellularEngineT<Scalar, Accum>::~AnalogCellularEngineT() {
+    stopRunner();
+}
+
+template <typename Scalar, typename Accum>
+uint64_t AnalogCellularEngineT<Scalar, Accum>::getOperationCount() const {
+    uint64_t total = 0;
+    for (const auto& partial : worker_partials) total += partial.operations;
+    return total;
+}
+
+template <typename Scalar, typename Accum>
+typename AnalogCellularEngineT<Scalar, Accum>::Node AnalogCellularEngineT<Scalar, Accum>::getNode(size_t node_id) const {
+    const size_t index = getNodeSlot(static_cast<uint32_t>(node_id));
+    Node node;
+    node.current_output = state.current_output[index];
+    node.integrator_state = state.integrator_state[index];
+    node.previous_input = state.previous_input[index];
+    node.feedback_gain = state.feedback_gain[index];
+    node.x = node_info[index].x;
+    node.y = node_info[index].y;
+    node.z = node_info[index].z;
+    node.node_id = node_info[index].node_id;
+    node.operation_count = node_passes;
+    return node;
+}
+
+// SoA storage: one aligned block split into per-field arrays
+template <typename Scalar, typename Accum>
+AnalogNodeStorageT<Scalar, Accum>::AnalogNodeStorageT(size_t node_count) {
+    allocate(node_count);
+}
+
+template <typename Scalar, typename Accum>
+AnalogNodeStorageT<Scalar, Accum>::~AnalogNodeStorageT() {
+    release();
+}
+
+template <typename Scalar, typename Accum>
+AnalogNodeStorageT<Scalar, Accum>::AnalogNodeStorageT(const AnalogNodeStorageT& other) {
+    allocate(other.count);
+    if (block) {
+        std::memcpy(block, other.block, blockBytes());
+    }
+}
+
+template <typename Scalar, typename Accum>
+AnalogNodeStorageT<Scalar, Accum>& AnalogNodeStorageT<Scalar, Accum>::operator=(const AnalogNodeStorageT& other) {
+    if (this != &other) {
+        AnalogNodeStorageT copy(other);
+        *this = std::move(copy);
     }
+    return *this;
+}
+
+template <typename Scalar, typename Accum>
+AnalogNodeStorageT<Scalar, Accum>::AnalogNodeStorageT(AnalogNodeStorageT&& other) noexcept
+    : integrator_state(other.integrator_state), previous_input(other.previous_input),
+      feedback_gain(other.feedback_gain), current_output(other.current_output),
+      block(other.block), mapping(std::move(other.mapping)), count(other.count), lane_capacity(other.lane_capacity) {
+    other.integrator_state = nullptr;
+    other.previous_input = other.feedback_gain = other.current_output = nullptr;
+    other.block = nullptr;
+    other.count = other.lane_capacity = 0;
+}
+
+template <typename Scalar, typename Accum>
+AnalogNodeStorageT<Scalar, Accum>& AnalogNodeStorageT<Scalar, Accum>::operator=(AnalogNodeStorageT&& other) noexcept {
+    if (this != &other) {
+        release();
+        integrator_state = other.integrator_state;
+        previous_input = other.previous_input;
+        feedback_gain = other.feedback_gain;
+        current_output = other.current_output;
+        block = other.block;
+        mapping = std::move(other.mapping);
+        count = other.count;
+        lane_capacity = other.lane_capacity;
+        other.integrator_state = nullptr;
+        other.previous_input = other.feedback_gain = other.current_output = nullptr;
+        other.block = nullptr;
+        other.count = other.lane_capacity = 0;
+    }
+    return *this;
+}
+
+template <typename Scalar, typename Accum>
+void AnalogNodeStorageT<Scalar, Accum>::allocate(size_t node_count) {
+    count = node_count;
+    lane_capacity = (node_count + kLaneBlock - 1) / kLaneBlock * kLaneBlock;
+    if (lane_capacity == 0) return;
+    
+    carve(::operator new(blockBytes(), std::align_val_t(kAlignment)));
+    std::fill(integrator_state, integrator_state + lane_capacity, Accum(0));
+    std::fill(previous_input, previous_input + lane_capacity, Scalar(0));
+    std::fill(feedback_gain, feedback_gain + lane_capacity, Scalar(1));
+    std::fill(current_output, current_output + lane_capacity, Scalar(0));
+}
+
+// Accumulator array first: it is the widest, so every array starts on a 64-byte boundary
+template <typename Scalar, typename Accum>
+void AnalogNodeStorageT<Scalar, Accum>::carve(void* memory) {
+    block = memory;
+    integrator_state = static_cast<Accum*>(block);
+    Scalar* base = reinterpret_cast<Scalar*>(integrator_state + lane_capacity);
+    previous_input = base;
+    feedback_gain = base + lane_capacity;
+    current_output = base + lane_capacity * 2;
+}
+
+template <typename Scalar, typename Accum>
+bool AnalogNodeStorageT<Scalar, Accum>::adopt(std::unique_ptr<MappedFile> file, size_t offset, size_t node_count) {
+    const size_t capacity = (node_count + kLaneBlock - 1) / kLaneBlock * kLaneBlock;
+    const size_t bytes = capacity * (sizeof(Accum) + 3 * sizeof(Scalar));
+    if (!file || capacity == 0 || offset % kAlignment != 0 || offset + bytes > file->size()) return false;
+    release();
+    count = node_count;
+    lane_capacity = capacity;
+    carve(file->data() + offset);
+    mapping = std::move(file);
+    return true;
+}
+
+template <typename Scalar, typename Accum>
+void AnalogNodeStorageT<Scalar, Accum>::release() {
+    if (mapping) {
+        mapping.reset();                     // Unmaps `block`
+    } else if (block) {
+        ::operator delete(block, std::align_val_t(kAlignment));
+    }
+    integrator_state = nullptr;
+    previous_input = feedback_gain = current_output = nullptr;
+    block = nullptr;
+    count = lane_capacity = 0;
 }
 
 // Constructor implementation
-AnalogCellularEngine::AnalogCellularEngine(size_t num_nodes) 
-    : nodes(num_nodes), system_frequency(1.0), noise_level(0.001) {
+template <typename Scalar, typename Accum>
+AnalogCellularEngineT<Scalar, Accum>::AnalogCellularEngineT(size_t num_nodes, const AnalogEngineConfig& engine_config,
+                                                            const AnalogLatticeLayout& lattice_layout) 
+    : state(num_nodes), node_info(num_nodes),
+      system_frequency(1.0), noise_level(0.0), config(engine_config),
+      pool(std::make_unique<EngineThreadPool>(engine_config)),
+      worker_partials(pool->getThreadCount()), commands(engine_config.command_capacity), layout(lattice_layout) {
+    
+#ifdef DASE_ENABLE_INSTRUMENTATION
+    // Counters attach to the thread that opens them, so every worker opens its own
+    instrumentation = std::make_unique<EngineInstrumentation>(pool->getThreadCount());
+    if (config.perf_counters) {
+        pool->runOnWorkers([&](size_t worker, size_t) { instrumentation->openCounters(worker); });
+    }
+#endif
+    
+    // Resolve the grid: enough z-planes for every node, curve order if it fits
+    if (!buildNodeOrder(layout, num_nodes, slot_to_id, id_to_slot)) {
+        layout = AnalogLatticeLayout();
+    }
+    const size_t plane = static_cast<size_t>(layout.nx) * layout.ny;
+    layout.nz = static_cast<uint32_t>(std::max<size_t>(layout.nz, (num_nodes + plane - 1) / plane));
+    lattice_dims[0] = layout.nx;
+    lattice_dims[1] = layout.ny;
+    lattice_dims[2] = layout.nz;
     
     // Initialize nodes with spatial coordinates for cellular organization
-    for (size_t i = 0; i < num_nodes; i++) {
-        nodes[i] = AnalogUniversalNode();
+    for (size_t slot = 0; slot < num_nodes; slot++) {
         // Set spatial coordinates for 3D cellular arrangement
-        nodes[i].x = static_cast<int16_t>(i % 10);
-        nodes[i].y = static_cast<int16_t>((i / 10) % 10);
-        nodes[i].z = static_cast<int16_t>(i / 100);
-        nodes[i].node_id = static_cast<uint16_t>(i);
+        const size_t id = slot_to_id.empty() ? slot : slot_to_id[slot];
+        node_info[slot].x = static_cast<int32_t>(id % layout.nx);
+        node_info[slot].y = static_cast<int32_t>((id / layout.nx) % layout.ny);
+        node_info[slot].z = static_cast<int32_t>(id / plane);
+        node_info[slot].node_id = static_cast<uint32_t>(id);
     }
-}
\ No newline at end of file
+    
+    // Per-pass control offsets sin((i + pass) * 0.1) * 0.3 only depend on i + pass,
+    // so in row-major order one table of num_nodes + passes entries covers every node and pass
+    if (slot_to_id.empty()) {
+        control_stride = 1;
+        control_offsets.resize(num_nodes + kWavePasses);
+        for (size_t k = 0; k < control_offsets.size(); k++) {
+            control_offsets[k] = static_cast<Scalar>(std::sin(static_cast<double>(k) * 0.1) * 0.3);
+        }
+    } else {
+        control_stride = num_nodes;
+        control_offsets.resize(num_nodes * kWavePasses);
+        for (int pass = 0; pass < kWavePasses; pass++) {
+            for (size_t slot = 0; slot < num_nodes; slot++) {
+                control_offsets[pass * num_nodes + slot] =
+                    static_cast<Scalar>(std::sin(static_cast<double>(slot_to_id[slot] + pass) * 0.1) * 0.3);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// SNAPSHOT
+// ============================================================================
+
+static const char kSnapshotMagic[8] = {'D', 'A', 'S', 'E', 'S', 'N', 'P', '1'};
+
+static bool snapshotHeaderValid(const AnalogSnapshotHeader& header, size_t file_bytes) {
+    const uint64_t per_entry = header.accum_bytes + 3ull * header.scalar_bytes;
+    return std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) == 0 &&
+           header.version == kAnalogSnapshotVersion && header.header_bytes == kAnalogSnapshotPage &&
+           header.lane_capacity >= header.node_count && header.state_bytes == header.lane_capacity * per_entry &&
+           header.header_bytes + header.state_bytes <= file_bytes;
+}
+
+bool readAnalogSnapshotHeader(const std::string& path, AnalogSnapshotHeader& header) {
+    MappedFile file;
+    if (!file.openRead(path) || file.size() < kAnalogSnapshotPage) return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+    return snapshotHeaderValid(header, file.size());
+}
+
+template <typename Scalar, typename Accum>
+bool AnalogCellularEngineT<Scalar, Accum>::saveSnapshot(const std::string& path) const {
+    AnalogSnapshotHeader header{};
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    header.version = kAnalogSnapshotVersion;
+    header.header_bytes = static_cast<uint32_t>(kAnalogSnapshotPage);
+    header.scalar_bytes = sizeof(Scalar);
+    header.accum_bytes = sizeof(Accum);
+    header.node_count = state.size();
+    header.lane_capacity = state.capacity();
+    header.state_bytes = state.blockBytes();
+    header.nx = layout.nx;
+    header.ny = layout.ny;
+    header.nz = layout.nz;
+    header.ordering = static_cast<uint32_t>(layout.ordering);
+    header.clock_time = clock.now();
+    header.clock_step = clock.getTimeStep();
+    header.clock_ticks = clock.getTicks();
+    header.system_frequency = system_frequency;
+    header.noise_level = noise_level;
+    header.noise_seed = noise_seed;
+    header.noise_steps = noise_steps;
+    header.node_passes = node_passes;
+    header.operations = getOperationCount();
+
+    const std::string temporary = path + ".tmp";
+    {
+        MappedFile file;
+        if (!file.create(temporary, kAnalogSnapshotPage + header.state_bytes)) return false;
+        std::memcpy(file.data(), &header, sizeof(header));
+        if (header.state_bytes) std::memcpy(file.data() + kAnalogSnapshotPage, state.integrator_state, header.state_bytes);
+    }
+#ifdef _WIN32
+    std::remove(path.c_str());  // rename() does not replace on Windows
+#endif
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+template <typename Scalar, typename Accum>
+bool AnalogCellularEngineT<Scalar, Accum>::loadSnapshot(const std::string& path) {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->openPrivate(path) || file->size() < kAnalogSnapshotPage) return false;
+    AnalogSnapshotHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (!snapshotHeaderValid(header, file->size()) || header.scalar_bytes != sizeof(Scalar) ||
+        header.accum_bytes != sizeof(Accum) || header.node_count != state.size() ||
+        header.lane_capacity != state.capacity() || header.nx != layout.nx || header.ny != layout.ny ||
+        header.nz != layout.nz || header.ordering != static_cast<uint32_t>(layout.ordering)) {
+        return false;
+    }
+    if (!state.adopt(std::move(file), header.header_bytes, header.node_count)) return false;
+
+    clock.restore(header.clock_time, header.clock_ticks, header.clock_step);
+    system_frequency = header.system_frequency;
+    noise_level = header.noise_level;
+    noise_seed = header.noise_seed;
+    noise_steps = header.noise_steps;
+    node_passes = header.node_passes;
+    for (auto& partial : worker_partials) partial.operations = 0;
+    worker_partials[0].operations = header.operations;
+
+    // Mode buffers derived from node outputs start from the restored state
+    if (circuit) std::fill(circuit_latch.begin(), circuit_latch.end(), Scalar(0));
+    if (lattice_enabled) setLattice(lattice);
+    event_full = true;
+    return true;
+}
+
+// PRECISION: Explicit double, float and mixed (float state, double integrator) builds
+template class AnalogUniversalNodeT<double>;
+template class AnalogUniversalNodeT<float>;
+template class AnalogUniversalNodeT<float, double>;
+template class AnalogNodeStorageT<double>;
+template class AnalogNodeStorageT<float>;
+template class AnalogNodeStorageT<float, double>;
+template class AnalogCellularEngineT<double>;
+template class AnalogCellularEngineT<float>;
+template class AnalogCellularEngineT<float, double>;
@@ -1,55 +1,479 @@
 #pragma once
 #include <vector>
+#include <atomic>
 #include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include "analog_simd_kernels.h"
+#include "analog_circuit_graph.h"
+#include "analog_engine_snapshot.h"
+#include "analog_ode_solver.h"
+#include "analog_node_layout.h"
+#include "engine_thread_pool.h"
+#include "engine_command_queue.h"
+#include "engine_instrumentation.h"
+#include "engine_mapped_file.h"
+#include "engine_philox_rng.h"
+#include "engine_trace_recorder.h"
+#include "simulation_clock.h"
+
+// PRECISION: Engine variants are built for
+//   AnalogCellularEngine       double state (reference)
+//   AnalogCellularEngineF32    float state, twice the lanes per cache line
+//   AnalogCellularEngineMixed  float state with double integrator accumulators
+// Public inputs and results stay double; reductions always accumulate in double.
+template <typename Scalar, typename Accum = Scalar>
+class AnalogCellularEngineT;
 
 // BREAKTHROUGH: Analog Signal-Controlled Universal Node
 // No discrete types - control signal determines function like op-amp feedback
-class AnalogUniversalNode {
+template <typename Scalar, typename Accum = Scalar>
+class AnalogUniversalNodeT {
 private:
     // Continuous analog state (no discrete types!)
-    double current_output = 0.0;
-    double integrator_state = 0.0;      // For integration operations
-    double previous_input = 0.0;        // For differentiation operations
-    double feedback_gain = 1.0;         // Internal feedback coefficient
-    
+    Scalar current_output = Scalar(0);
+    Accum integrator_state = Accum(0);    // For integration operations
+    Scalar previous_input = Scalar(0);    // For differentiation operations
+    Scalar feedback_gain = Scalar(1);     // Internal feedback coefficient
+
+    template <typename, typename> friend class AnalogCellularEngineT;  // Builds node views from SoA storage
+
 public:
     // Spatial coordinates for cellular organization
-    int16_t x = 0, y = 0, z = 0;
-    uint16_t node_id = 0;
-    
+    int32_t x = 0, y = 0, z = 0;
+    uint32_t node_id = 0;
+
     // Performance tracking
     uint64_t operation_count = 0;
-    
+
     // CORE BREAKTHROUGH: Signal-controlled processing
-    double processSignal(double input_signal, double control_signal, double aux_signal = 0.0);
-    
+    Scalar processSignal(Scalar input_signal, Scalar control_signal, Scalar aux_signal = Scalar(0));
+
     // Analog control functions
     void setFeedback(double feedback_coefficient);
     void resetIntegrator();
-    double getOutput() const;
-    double getIntegratorState() const;
+    Scalar getOutput() const;
+    Accum getIntegratorState() const;
 };
 
+using AnalogUniversalNode = AnalogUniversalNodeT<double>;
+using AnalogUniversalNodeF32 = AnalogUniversalNodeT<float>;
+using AnalogUniversalNodeMixed = AnalogUniversalNodeT<float, double>;
+
+// CACHE-FRIENDLY: Structure-of-arrays node storage
+// Hot per-step fields live in separate 64-byte aligned arrays carved from one
+// block, padded to whole lane blocks so SIMD loads never straddle two arrays.
+template <typename Scalar, typename Accum = Scalar>
+class AnalogNodeStorageT {
+public:
+    static constexpr size_t kAlignment = 64;
+    static constexpr size_t kLaneBlock = kAnalogLaneBlockFor<Scalar>;
+
+    explicit AnalogNodeStorageT(size_t count = 0);
+    ~AnalogNodeStorageT();
+    AnalogNodeStorageT(const AnalogNodeStorageT& other);
+    AnalogNodeStorageT& operator=(const AnalogNodeStorageT& other);
+    AnalogNodeStorageT(AnalogNodeStorageT&& other) noexcept;
+    AnalogNodeStorageT& operator=(AnalogNodeStorageT&& other) noexcept;
+
+    size_t size() const { return count; }
+    size_t capacity() const { return lane_capacity; }
+    size_t blockBytes() const { return lane_capacity * (sizeof(Accum) + 3 * sizeof(Scalar)); }
+    AnalogLaneStateT<Scalar, Accum> lanes() const { return {integrator_state, previous_input, feedback_gain, current_output}; }
+
+    // SNAPSHOT: Use the block at `offset` of a mapped file as storage for `node_count`
+    // nodes (laid out as this class allocates it). False if it does not fit or align.
+    bool adopt(std::unique_ptr<MappedFile> file, size_t offset, size_t node_count);
+    bool isMapped() const { return mapping != nullptr; }
+
+    // Hot state arrays (length capacity(), valid entries [0, size()))
+    Accum* integrator_state = nullptr;
+    Scalar* previous_input = nullptr;
+    Scalar* feedback_gain = nullptr;
+    Scalar* current_output = nullptr;
+
+private:
+    void allocate(size_t node_count);
+    void carve(void* memory);
+    void release();
+
+    void* block = nullptr;
+    std::unique_ptr<MappedFile> mapping;     // Set when `block` lives in a mapped snapshot
+    size_t count = 0;
+    size_t lane_capacity = 0;
+};
+
+using AnalogNodeStorage = AnalogNodeStorageT<double>;
+using AnalogNodeStorageF32 = AnalogNodeStorageT<float>;
+using AnalogNodeStorageMixed = AnalogNodeStorageT<float, double>;
+
+// Cold per-node data kept out of the hot cache lines
+struct AnalogNodeInfo {
+    int32_t x = 0, y = 0, z = 0;
+    uint32_t node_id = 0;
+};
+
+// LATTICE: Neighbour coupling over the engine's x/y/z cell grid
+enum class LatticeNeighbourhood : uint8_t {
+    Faces6 = 6,   // +-x, +-y, +-z
+    Full26 = 26   // Every cell of the surrounding 3x3x3 block
+};
+
+struct AnalogLatticeConfig {
+    LatticeNeighbourhood neighbourhood = LatticeNeighbourhood::Faces6;
+    double coupling = 0.1;   // Weight applied to each neighbour's previous output
+    double control = 0.0;    // Control signal (mode) shared by every cell
+    bool periodic = false;   // Wrap around the grid faces instead of open (zero) boundaries
+};
+
+// EVENT-DRIVEN: Circuit step counters since setEventDriven()
+struct AnalogEventStats {
+    uint64_t steps = 0;
+    uint64_t full_steps = 0;    // Steps that evaluated every node (first step, after outside changes, noise)
+    uint64_t visited = 0;       // Queued nodes whose input was recomputed
+    uint64_t evaluated = 0;     // Nodes actually re-evaluated
+};
+
+// Signal processing passes per node per wave
+constexpr int kAnalogWavePasses = 10;
+
 // PARALLEL-READY: Analog Cellular Engine
-class AnalogCellularEngine {
+// THREAD SAFETY: An engine owns all of its mutable state (nodes, clock, scratch
+// buffers, worker pool), so separate engines may run concurrently on different
+// threads. A single engine must not be called from several threads at once;
+// postCommand() is the exception and may be called from any thread.
+template <typename Scalar, typename Accum>
+class AnalogCellularEngineT {
+public:
+    using Node = AnalogUniversalNodeT<Scalar, Accum>;
+    using Storage = AnalogNodeStorageT<Scalar, Accum>;
+    using LaneState = AnalogLaneStateT<Scalar, Accum>;
+    static constexpr size_t kLaneBlock = kAnalogLaneBlockFor<Scalar>;
+
 private:
-    std::vector<AnalogUniversalNode> nodes;
+    Storage state;                 // Hot SoA state, indexed by storage slot
+    std::vector<AnalogNodeInfo> node_info;   // Cold spatial data, indexed by storage slot
     double system_frequency = 1.0;
-    double noise_level = 0.001;
+    double noise_level = 0.0;                // Input noise standard deviation, 0 = off (setNoise)
+    uint64_t noise_seed = 0;
+    uint64_t noise_steps = 0;                // Noise counter: waves, block samples and lattice/circuit steps so far
+    SimulationClock clock;                   // Sweep time base, one per engine
+
+    // Engine-owned workers, sized and pinned once at construction
+    AnalogEngineConfig config;
+    std::unique_ptr<EngineThreadPool> pool;
+
+    // Per-worker operation counters, one cache line each. Counters are only summed
+    // when read, so no node or line is shared between writers.
+    struct alignas(64) WorkerPartial {
+        uint64_t operations = 0;  // Node evaluations performed by this worker
+    };
+    std::vector<WorkerPartial> worker_partials;
+
+    // REDUCTION: Output sums go to fixed segments (engine_reduction.h), not to workers,
+    // so every mode's result is bit-identical for any thread count
+    std::vector<ReductionPartial> reduction_partials;
+    uint64_t node_passes = 0;     // Evaluations applied to every node (each mode updates all nodes)
+
+#ifdef DASE_ENABLE_INSTRUMENTATION
+    std::unique_ptr<EngineInstrumentation> instrumentation;
+#endif
+
+    // Parallel regions of the engine; instrumented builds time every task and region
+    template <typename Fn>
+    void parallelTasks(size_t task_count, size_t chunk, Fn&& fn);
+    template <typename Fn>
+    void parallelWorkers(Fn&& fn);
+    // TUNING: Applies config.schedule / chunk / sequential_below to one region
+    template <typename Fn>
+    void scheduleTasks(size_t task_count, size_t chunk, Fn&& fn);
+    uint64_t beginReduction() const;
+    void endReduction(uint64_t reduction_start);
+
+    // STREAMING: processSignalBlock runs at most this many samples per parallel region
+    static constexpr size_t kBlockChunkSamples = 4096;
+    void processSampleChunk(const double* inputs, const double* controls, size_t n, double* outputs);
+
+    // Reused sample buffers for processSignalBlock / performSignalSweepBlock;
+    // block_partials holds one row of per-sample sums per reduction segment
+    std::vector<double> block_partials;
+    std::vector<double> block_compensation;   // Kahan mode only
+    std::vector<double> block_aux;
+    std::vector<double> sweep_inputs;
+    std::vector<double> sweep_controls;
+    std::vector<double> sweep_outputs;
+
+    // TRACE: Optional recorder fed after every step. processSignalBlock keeps each node
+    // slice for all samples, so it captures per sample through a lane block index:
+    // block b holds traced slots trace_block_slots[trace_block_offsets[b] .. [b + 1])
+    std::unique_ptr<EngineTraceRecorder> trace;
+    std::vector<uint32_t> trace_block_offsets;
+    std::vector<uint32_t> trace_block_slots;
+    std::vector<uint32_t> trace_block_columns;
+    std::vector<double> trace_rows;    // Sample-major traced outputs of one block call
+    void recordTrace() {
+        if (trace) trace->record(state.current_output);
+    }
+
+    // COMMANDS: Posted from any thread, applied by the driving thread between waves
+    EngineCommandQueue commands;
+    std::atomic<uint64_t> commands_applied{0};
+    void drainCommands() {
+        if (!commands.empty()) applyCommands();
+    }
+
+    // RUNNER: Optional thread that drives the engine (see startRunner)
+    std::thread runner;
+    std::atomic<bool> runner_active{false};
+    std::atomic<uint64_t> runner_steps{0};
+
+    // Patched circuit (optional) and the latched outputs read by its delay edges
+    std::unique_ptr<AnalogCircuitGraph> circuit;
+    std::vector<Scalar> circuit_latch;
+    double circuitNodeInput(uint32_t v, double external_input, uint64_t noise_step) const;
     
+    // EVENT-DRIVEN: Per-step queues of nodes that may have changed (see setEventDriven)
+    bool event_driven = false;
+    double event_tolerance = 0.0;
+    bool event_full = true;                    // Next step evaluates every node: node state changed outside circuit steps
+    uint64_t event_passes = 0;                 // node_passes after the last circuit step
+    double event_external = 0.0;               // External input of the last circuit step
+    std::vector<double> event_inputs;          // Input of every node at its last evaluation
+    std::vector<uint32_t> event_marks;         // Stamp of the step that last queued each node
+    uint32_t event_stamp = 0;
+    std::vector<std::vector<uint32_t>> event_levels;   // Queued nodes of each level, this step
+    std::vector<uint32_t> event_carry;         // Queued for the next step: delay targets and stateful nodes
+    std::vector<uint32_t> event_external_nodes;        // Nodes with a share of the external input
+    struct alignas(64) EventWorkerList {
+        std::vector<uint32_t> changed;         // Evaluated nodes whose output moved
+        std::vector<uint32_t> carry;           // Integrators and unrelaxed differentiators
+        uint64_t evaluated = 0;
+    };
+    std::vector<EventWorkerList> event_workers;
+    AnalogEventStats event_stats;
+    void evaluateCircuitEvents(double external_input, uint64_t noise_step);
+
+    // Continuous-time circuit state: one ODE component per integrator-mode node
+    AnalogOdeSolver ode_solver;
+    std::vector<uint32_t> ode_nodes;   // Component -> node
+    std::vector<uint32_t> ode_slot;    // Node -> component (UINT32_MAX for memoryless nodes)
+    std::vector<double> ode_state;
+
+    // dy/dt of every integrator given state y; memoryless node outputs are rebuilt on the
+    // way. commit also advances differentiator history (dydt may then be null).
+    void evaluateCircuitDerivative(const double* y, double* dydt, double external_input, bool commit);
+
+    // Grid geometry and storage order; both maps stay empty for RowMajor (slot == ID)
+    AnalogLatticeLayout layout;
+    std::vector<uint32_t> slot_to_id;
+    std::vector<uint32_t> id_to_slot;
+
+    // Loop-invariant control offsets sin((id + pass) * 0.1) * 0.3. Row-major storage
+    // shares one table indexed by slot + pass (control_stride 1); curve orders keep
+    // one row per pass indexed by slot (control_stride = node count).
+    std::vector<Scalar> control_offsets;
+    size_t control_stride = 1;
+
+    // Lattice mode: grid dimensions and double-buffered outputs (previous step / this step)
+    bool lattice_enabled = false;
+    AnalogLatticeConfig lattice;
+    size_t lattice_dims[3] = {10, 10, 0};
+    std::vector<Scalar> lattice_buffers[2];
+    int lattice_front = 0;
+    // Row-major scratch sized by setLattice, so steps never allocate: per worker three
+    // x rows (neighbour sums, inputs, noise) lattice_row_stride apart, plus one shared
+    // row holding the control signal
+    std::vector<Scalar> lattice_rows;
+    std::vector<Scalar> lattice_controls;
+    size_t lattice_row_stride = 0;
+
+    // STENCIL: Update the cells of z-planes [z_begin, z_end) on `worker`'s scratch rows,
+    // returns their output sum
+    double processLatticeSlab(size_t z_begin, size_t z_end, double external_input, size_t worker);
+    // STENCIL (curve order): Update storage slots [begin, end), gathering neighbours by ID
+    double processLatticeCells(size_t begin, size_t end, double external_input);
+
+    // Static worker slice of the nodes, cut at lane block (cache line) boundaries
+    static void laneAlignedRange(size_t node_count, size_t worker, size_t worker_count, size_t& begin, size_t& end);
+
+    // NOISE: level * N(0, 1) for the nodes in slots first .. first + count - 1, keyed
+    // by node ID through slot_to_id
+    void noiseLanes(uint64_t step, uint32_t pass, size_t first, size_t count, Scalar* out) const;
+
+    // SIMD: Run every wave pass for one lane block, returns the block's output sum.
+    // `noise_step` keys the block's input noise when noise is on.
+    double processBlockWave(size_t first, size_t count, double input_signal, double control_pattern,
+                            const double* aux_passes, uint64_t noise_step);
+    // One reduction segment of a wave: its lane blocks in order, evaluations counted for `worker`
+    ReductionPartial processWaveSegment(size_t segment, size_t segments, double input_signal, double control_pattern,
+                                        const double* aux_passes, size_t worker);
+
+    // FUSED: Meeting point of the workers of one runSteps() dispatch
+    EngineStepBarrier step_barrier;
+
 public:
-    // Constructor
-    AnalogCellularEngine(size_t num_nodes = 100);
-    
+    static constexpr int kWavePasses = kAnalogWavePasses;
+
+    // Constructor: thread count, CPU affinity, grid geometry and storage order are fixed
+    // here for the engine's lifetime. Node IDs are row-major grid positions; with a
+    // Morton or Hilbert layout the SoA storage (and getNodeStorage()) is in curve order.
+    // An unusable layout (nx or ny of 0, more than 2^21 cells per axis) falls back to
+    // the 10 x 10 row-major default; getLayout() reports what was applied.
+    AnalogCellularEngineT(size_t num_nodes = 100, const AnalogEngineConfig& engine_config = AnalogEngineConfig(),
+                          const AnalogLatticeLayout& lattice_layout = AnalogLatticeLayout());
+    ~AnalogCellularEngineT();
+
     // PARALLEL PROCESSING: All nodes process simultaneously
     double processSignalWave(double input_signal, double control_pattern = 0.0);
-    
+
+    // STREAMING: processSignalWave for n samples in one call.
+    // outputs[t] equals processSignalWave(inputs[t], controls[t]) bit for bit; controls may
+    // be null (0.0).
+    void processSignalBlock(const double* inputs, const double* controls, size_t n, double* outputs);
+
+    // CIRCUIT MODE: Evaluate the patched netlist for one time step, level by level.
+    // Returns the mean node output, like processSignalWave. The netlist addresses
+    // nodes by ID; getCircuit() returns it relabelled to storage slots.
+    bool setCircuit(AnalogCircuitGraph graph);
+    void clearCircuit();
+    bool hasCircuit() const { return circuit != nullptr; }
+    const AnalogCircuitGraph* getCircuit() const { return circuit.get(); }
+    double processCircuitStep(double external_input);
+
+    // EVENT-DRIVEN: Circuit steps re-evaluate a node only when its input moved by more
+    // than `tolerance` since it was last evaluated, or when it holds time-dependent
+    // state (integrators, differentiators until their output is back at 0). Changes
+    // propagate along the netlist through per-worker lists of changed nodes, so a
+    // step costs in proportion to the active part of the circuit. Skipped nodes keep
+    // outputs within tolerance * gain of a full evaluation; tolerance 0 is exact.
+    // Any step of another mode, patch, command or gain change makes the next step
+    // evaluate every node, as does input noise.
+    void setEventDriven(bool enabled, double tolerance = 1.0e-9);
+    bool isEventDriven() const { return event_driven; }
+    const AnalogEventStats& getEventStats() const { return event_stats; }
+
+    // CONTINUOUS TIME: Integrate the patched circuit over `duration` with the engine's
+    // scheme. Integrator-mode nodes follow d(state)/dt = input, so one Euler step of
+    // 0.1 is the legacy integrator gain; amplifier and inverting nodes are algebraic
+    // and differentiators difference against the input latched at the previous call.
+    // Delay edges from integrators read the live state, other delay edges are held
+    // for the whole call. Returns false without a circuit or if RK45 cannot meet its
+    // tolerance (the state is left at the last accepted step).
+    bool integrateCircuit(double external_input, double duration);
+    void setIntegrator(const AnalogIntegratorConfig& integrator_config) { ode_solver.setConfig(integrator_config); }
+    const AnalogIntegratorConfig& getIntegrator() const { return ode_solver.getConfig(); }
+    const AnalogIntegratorStats& getIntegratorStats() const { return ode_solver.getStats(); }
+
+    // LATTICE MODE: Each cell's input is the external input plus `coupling` times the
+    // sum of its 6 or 26 neighbours' outputs from the previous step. Reads and writes
+    // go to separate buffers, so every cell of a step updates in parallel; work is
+    // tiled into cache-sized z-slabs. Returns the mean node output. Every cell adds
+    // its neighbours in the same (dz, dy, dx) order under any NodeOrdering, so node
+    // outputs are bit-identical across layouts (only the mean's summation order differs).
+    void setLattice(const AnalogLatticeConfig& lattice_config);
+    void clearLattice();
+    bool hasLattice() const { return lattice_enabled; }
+    double processLatticeStep(double external_input);
+
     // Analog computer operations
     void performSignalSweep(double base_frequency);
+    void performSignalSweepBlock(double base_frequency, size_t steps, double* outputs = nullptr);
+    // FUSED: `steps` performSignalSweep(base_frequency) calls in one pool dispatch, with
+    // bit-identical results, traces and command timing. Workers keep fixed node segments
+    // for the whole run and meet at a sense-reversing barrier after every step; the last
+    // to arrive reduces the step, records the trace, applies pending commands and sets
+    // up the next input. Small engines, where a wave is a few microseconds, save the
+    // per-step dispatch and wake-up. outputs (optional) receives every step's result.
+    void runSteps(size_t steps, double base_frequency, double* outputs = nullptr);
     void setSystemFeedback(double feedback_level);
+
+    // NOISE: Add Gaussian noise of standard deviation `level` to every node input on
+    // every wave pass, block sample, lattice step and circuit step (not to the ODE
+    // integrator). Samples come from a counter-based generator keyed by (seed, node ID,
+    // step, pass), so noisy runs reproduce exactly for any thread count and any node
+    // layout. Level 0 is off.
+    void setNoise(double level, uint64_t seed = 0);
+    double getNoiseLevel() const { return noise_level; }
+    uint64_t getNoiseSeed() const { return noise_seed; }
+
+    // Simulation time: sweeps advance the clock by its time step (default 0.001) per sample
+    double advance(double dt) { return clock.advance(dt); }
+    void reset(double start_time = 0.0) { clock.reset(start_time); }
+    void setTimeStep(double dt) { clock.setTimeStep(dt); }
+    const SimulationClock& getClock() const { return clock; }
     void resetAllIntegrators();
-    
+
+    // SNAPSHOT: Checkpoint node state (integrators, differentiator history, feedback
+    // gains, outputs), the clock and the operation counters. saveSnapshot() writes a
+    // temporary file and renames it over `path`, so a crash never leaves a torn file.
+    // loadSnapshot() maps `path` copy-on-write and adopts it as node storage: engines
+    // restored from one file share its pages until they write to them. The snapshot
+    // must come from an engine of the same precision, node count and layout. Circuit
+    // and lattice patches are configuration, not state: the engine's own stay applied
+    // and restart from the restored outputs.
+    bool saveSnapshot(const std::string& path) const;
+    bool loadSnapshot(const std::string& path);
+
+    // TRACE: Record the outputs of config.nodes (node IDs) after every step of any mode;
+    // each processSignalBlock sample is a step. False, keeping the previous trace, for
+    // an unknown node ID or an unusable config (see EngineTraceRecorder::configure).
+    bool setTrace(const EngineTraceConfig& config);
+    void clearTrace();
+    EngineTraceRecorder* getTrace() { return trace.get(); }
+    const EngineTraceRecorder* getTrace() const { return trace.get(); }
+    bool flushTrace(const std::string& path) { return trace && trace->flush(path); }
+
+    // COMMANDS: Change gains, reset nodes or retune the sweep while another thread runs
+    // the engine. Every step entry point applies the pending commands first, in post
+    // order, so they always land between waves. postCommand() is lock-free and never
+    // blocks; it returns false when config.command_capacity commands are already waiting.
+    bool postCommand(const EngineCommand& command) { return commands.push(command); }
+    size_t applyCommands();   // Driving thread; returns the number applied
+    uint64_t getAppliedCommandCount() const { return commands_applied.load(std::memory_order_relaxed); }
+
+    // RUNNER: Drive the engine from its own thread, calling step(*this) in a loop until
+    // stopRunner(). While it runs, other threads control the engine through
+    // postCommand() only. False if a runner is already active.
+    bool startRunner(std::function<void(AnalogCellularEngineT&)> step);
+    void stopRunner();        // Finishes the current step, then joins
+    bool isRunning() const { return runner_active.load(std::memory_order_acquire); }
+    uint64_t getRunnerSteps() const { return runner_steps.load(std::memory_order_relaxed); }
+
     // Access functions
-    size_t getNodeCount() const { return nodes.size(); }
-    const AnalogUniversalNode& getNode(size_t index) const { return nodes[index]; }
-};
\ No newline at end of file
+    size_t getNodeCount() const { return state.size(); }
+    Node getNode(size_t node_id) const;  // Snapshot view assembled from SoA storage
+    uint64_t getOperationCount() const;  // Node evaluations summed over all workers
+    uint64_t getWorkerOperationCount(size_t worker) const { return worker_partials[worker].operations; }
+    uint32_t getNodeSlot(uint32_t node_id) const { return id_to_slot.empty() ? node_id : id_to_slot[node_id]; }
+    uint32_t getNodeId(size_t slot) const { return node_info[slot].node_id; }
+    const AnalogLatticeLayout& getLayout() const { return layout; }
+    const Storage& getNodeStorage() const { return state; }
+    const AnalogEngineConfig& getConfig() const { return config; }
+    size_t getThreadCount() const { return pool->getThreadCount(); }
+
+    // INSTRUMENTATION: Phase timing (compute / barrier / reduction) of the wave, block and
+    // lattice regions, per-worker busy and idle time, and per-worker perf_event counters
+    // when AnalogEngineConfig::perf_counters is set. Export appends one JSON line to
+    // `path` every `interval_regions` regions. Builds without DASE_ENABLE_INSTRUMENTATION
+    // return a snapshot with enabled == false and setInstrumentationExport() fails.
+    EngineInstrumentationSnapshot getInstrumentation() const;
+    void resetInstrumentation();
+    bool setInstrumentationExport(const std::string& path, uint64_t interval_regions);
+};
+
+using AnalogCellularEngine = AnalogCellularEngineT<double>;
+using AnalogCellularEngineF32 = AnalogCellularEngineT<float>;
+using AnalogCellularEngineMixed = AnalogCellularEngineT<float, double>;
+
+extern template class AnalogUniversalNodeT<double>;
+extern template class AnalogUniversalNodeT<float>;
+extern template class AnalogUniversalNodeT<float, double>;
+extern template class AnalogNodeStorageT<double>;
+extern template class AnalogNodeStorageT<float>;
+extern template class AnalogNodeStorageT<float, double>;
+extern template class AnalogCellularEngineT<double>;
+extern template class AnalogCellularEngineT<float>;
+extern template class AnalogCellularEngineT<float, double>;
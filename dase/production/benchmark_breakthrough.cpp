@@ -4,12 +4,10 @@
 #include <chrono>
 #include <vector>
 #include <iomanip>
+#include <cmath>
+#include <algorithm>
 #include "analog_universal_node_engine.h"
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
-
 // CRITICAL: Implementation of missing function for linkage
 void minimal_computation_test() {
     // Simple analog computation test
@@ -29,6 +27,50 @@ void minimal_computation_test() {
               << duration.count() / 1000.0 << " ns per operation" << std::endl;
 }
 
+// PRECISION: One engine variant's sweep outputs, timing and final integrator states
+struct PrecisionRun {
+    const char* name;
+    double avg_nanoseconds = 0.0;
+    std::vector<double> outputs;
+    std::vector<double> integrators;
+    double max_drift = 0.0;             // Largest |output - double output| over all steps
+    double mean_drift = 0.0;            // Mean |output - double output|
+    double max_integrator_drift = 0.0;  // Largest final |integrator - double integrator|
+};
+
+template <typename Engine>
+static PrecisionRun runPrecisionSweep(const char* name, size_t nodes, size_t steps) {
+    PrecisionRun run;
+    run.name = name;
+    run.outputs.resize(steps);
+    Engine engine(nodes);
+    engine.setTimeStep(0.05);  // Coarse step so the control pattern reaches every node mode
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    engine.performSignalSweepBlock(1.0, steps, run.outputs.data());
+    auto end = std::chrono::high_resolution_clock::now();
+    run.avg_nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / steps;
+    
+    for (size_t i = 0; i < nodes; i++) {
+        run.integrators.push_back(static_cast<double>(engine.getNode(i).getIntegratorState()));
+    }
+    return run;
+}
+
+static void measureDrift(PrecisionRun& run, const PrecisionRun& reference) {
+    double drift_sum = 0.0;
+    for (size_t t = 0; t < run.outputs.size(); t++) {
+        const double drift = std::fabs(run.outputs[t] - reference.outputs[t]);
+        run.max_drift = std::max(run.max_drift, drift);
+        drift_sum += drift;
+    }
+    run.mean_drift = run.outputs.empty() ? 0.0 : drift_sum / run.outputs.size();
+    for (size_t i = 0; i < run.integrators.size(); i++) {
+        run.max_integrator_drift = std::max(run.max_integrator_drift,
+                                            std::fabs(run.integrators[i] - reference.integrators[i]));
+    }
+}
+
 // BREAKTHROUGH: Analog Cellular Computing Benchmark
 void run_role_switch_benchmark() {
     std::cout << "\n=== D-ASE ANALOG CELLULAR COMPUTING BENCHMARK ===" << std::endl;
@@ -39,7 +81,7 @@ void run_role_switch_benchmark() {
     // Create analog cellular engine with 100 nodes
     AnalogCellularEngine engine(100);
     
-    const int iterations = 1000;  // 1 million iterations for accurate measurement
+    const int iterations = 1000;  // Single timed run; use dase_bench for medians and p99
     std::cout << "\nTesting " << iterations << " iterations of analog cellular computing..." << std::endl;
     
     // Warm-up phase
@@ -71,6 +113,15 @@ void run_role_switch_benchmark() {
     std::cout << "Average per operation: " << avg_nanoseconds << " nanoseconds" << std::endl;
     std::cout << "Operations per second: " << (1000000000.0 / avg_nanoseconds) << std::endl;
     
+    // FUSED: The same sweep as one runSteps() dispatch; the gap is per-step dispatch cost
+    auto fused_start = std::chrono::high_resolution_clock::now();
+    engine.runSteps(iterations, 1.0);
+    auto fused_end = std::chrono::high_resolution_clock::now();
+    double fused_nanoseconds = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(fused_end - fused_start).count()) / iterations;
+    std::cout << "Fused runSteps: " << fused_nanoseconds << " nanoseconds per operation ("
+              << avg_nanoseconds / fused_nanoseconds << "x)" << std::endl;
+    
     // Target analysis
     double target_ns = 1000.0;  // 1 microsecond target
     double performance_ratio = (avg_nanoseconds / target_ns) * 100.0;
@@ -93,14 +144,25 @@ void run_role_switch_benchmark() {
     
     // Parallel processing validation
     std::cout << "\n=== PARALLEL PROCESSING STATUS ===" << std::endl;
-    #ifdef _OPENMP
-    std::cout << "OpenMP enabled: YES" << std::endl;
-    std::cout << "Available threads: " << omp_get_max_threads() << std::endl;
-    std::cout << "Parallel analog processing: ACTIVE" << std::endl;
-    #else
-    std::cout << "OpenMP enabled: NO (sequential processing)" << std::endl;
-    std::cout << "Available threads: 1" << std::endl;
-    #endif
+    std::cout << "Engine worker threads: " << engine.getThreadCount() << std::endl;
+    std::cout << "Parallel analog processing: " << (engine.getThreadCount() > 1 ? "ACTIVE" : "SEQUENTIAL") << std::endl;
+    
+    // PRECISION: float and mixed variants against the double reference
+    const size_t precision_steps = 1000;
+    std::vector<PrecisionRun> precision;
+    precision.push_back(runPrecisionSweep<AnalogCellularEngine>("double", 100, precision_steps));
+    precision.push_back(runPrecisionSweep<AnalogCellularEngineF32>("float32", 100, precision_steps));
+    precision.push_back(runPrecisionSweep<AnalogCellularEngineMixed>("mixed", 100, precision_steps));
+    for (auto& run : precision) measureDrift(run, precision[0]);
+    
+    std::cout << "\n=== PRECISION VARIANTS ===" << std::endl;
+    for (const auto& run : precision) {
+        std::cout << std::setw(8) << run.name << ": " << std::fixed << std::setprecision(2)
+                  << run.avg_nanoseconds << " ns/step (" << precision[0].avg_nanoseconds / run.avg_nanoseconds
+                  << "x)  drift max " << std::scientific << std::setprecision(3) << run.max_drift
+                  << " mean " << run.mean_drift << "  integrator " << run.max_integrator_drift << std::endl;
+    }
+    std::cout << std::fixed << std::setprecision(2);
     
     // JSON output for web interface compatibility
     std::cout << "\n=== JSON OUTPUT ===" << std::endl;
@@ -108,16 +170,23 @@ void run_role_switch_benchmark() {
     std::cout << "  \"benchmark_type\": \"analog_cellular_computing\"," << std::endl;
     std::cout << "  \"iterations\": " << iterations << "," << std::endl;
     std::cout << "  \"avg_nanoseconds\": " << avg_nanoseconds << "," << std::endl;
+    std::cout << "  \"fused_avg_nanoseconds\": " << fused_nanoseconds << "," << std::endl;
     std::cout << "  \"target_nanoseconds\": " << target_ns << "," << std::endl;
     std::cout << "  \"target_achieved\": " << (avg_nanoseconds <= target_ns ? "true" : "false") << "," << std::endl;
     std::cout << "  \"performance_ratio\": " << (target_ns / avg_nanoseconds * 100.0) << "," << std::endl;
-    std::cout << "  \"parallel_processing\": " << 
-    #ifdef _OPENMP
-    "true" <<
-    #else 
-    "false" <<
-    #endif
-    std::endl;
+    std::cout << "  \"parallel_processing\": " << (engine.getThreadCount() > 1 ? "true" : "false") << "," << std::endl;
+    std::cout << "  \"worker_threads\": " << engine.getThreadCount() << "," << std::endl;
+    std::cout << "  \"precision\": [" << std::endl;
+    for (size_t k = 0; k < precision.size(); k++) {
+        const PrecisionRun& run = precision[k];
+        std::cout << "    {\"variant\": \"" << run.name << "\", \"avg_nanoseconds\": " << std::fixed
+                  << std::setprecision(2) << run.avg_nanoseconds << std::scientific << std::setprecision(6)
+                  << ", \"max_drift\": " << run.max_drift << ", \"mean_drift\": " << run.mean_drift
+                  << ", \"max_integrator_drift\": " << run.max_integrator_drift << "}"
+                  << (k + 1 < precision.size() ? "," : "") << std::endl;
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  ]" << std::endl;
     std::cout << "}" << std::endl;
     
     // Run minimal computation test
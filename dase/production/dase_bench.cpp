@@ -0,0 +1,365 @@
+#ifdef BENCHMARK_BUILD
+
+// DASE_BENCH: Parameterised engine benchmark suite
+//
+//   dase_bench [--nodes 100,1000] [--threads 1,4] [--batch 1,64]
+//              [--precision double,float32,mixed] [--steps 1000]
+//              [--warmup 3] [--reps 15] [--format text|json|csv] [--output FILE]
+//              [--baseline FILE.csv] [--tolerance 0.05] [--isa avx512|avx2|sse2|scalar]
+//
+// Every combination of node count x thread count x batch size x precision is
+// timed over --reps repetitions of --steps sweep samples, after --warmup
+// untimed repetitions. batch 1 runs performSignalSweep once per sample; larger
+// batches hand that many samples to performSignalSweepBlock per call.
+// Results report the median and p99 of the per-repetition ns/sample, so one
+// turbo spike or preemption shows up in p99 instead of moving the headline.
+//
+// Regression mode: --baseline reads a CSV written by an earlier --format csv
+// run and compares medians of matching configurations. The exit code is 1 if
+// any configuration is slower than the baseline by more than --tolerance.
+//
+// --isa runs the wave kernels built for that instruction set instead of the best
+// one this CPU supports (same as DASE_KERNEL_ISA), to compare dispatch targets.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include "analog_universal_node_engine.h"
+
+struct BenchOptions {
+    std::vector<size_t> nodes = {100, 1000};
+    std::vector<size_t> threads = {1};
+    std::vector<size_t> batches = {1, 64};
+    std::vector<std::string> precisions = {"double", "float32", "mixed"};
+    size_t steps = 1000;       // Sweep samples per repetition
+    size_t warmup = 3;         // Untimed repetitions before measuring
+    size_t repetitions = 15;   // Timed repetitions
+    std::string format = "text";
+    std::string output;        // Empty = stdout
+    std::string baseline;      // CSV from an earlier run, enables regression mode
+    double tolerance = 0.05;   // Allowed median slowdown before a regression is reported
+};
+
+struct BenchCase {
+    size_t nodes = 0;
+    size_t threads = 0;
+    size_t batch = 0;
+    std::string precision;
+};
+
+struct BenchResult {
+    BenchCase config;
+    size_t worker_threads = 0;  // Threads the engine actually started
+    double median_ns = 0.0;     // Per sweep sample
+    double p99_ns = 0.0;
+    double min_ns = 0.0;
+    double mean_ns = 0.0;
+    double ns_per_node = 0.0;   // median_ns / nodes
+};
+
+// Nearest-rank percentile of sorted samples
+static double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(fraction * sorted.size() + 0.999999);
+    rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+    return sorted[rank - 1];
+}
+
+template <typename Engine>
+static BenchResult runCase(const BenchCase& config, const BenchOptions& options) {
+    AnalogEngineConfig engine_config;
+    engine_config.num_threads = config.threads;
+    Engine engine(config.nodes, engine_config);
+    const size_t batch = std::max<size_t>(1, config.batch);
+    std::vector<double> outputs(batch);
+
+    auto repetition = [&]() {
+        if (batch == 1) {
+            for (size_t i = 0; i < options.steps; i++) {
+                engine.performSignalSweep(1.0 + (i % 100) * 0.01);
+            }
+            return;
+        }
+        for (size_t done = 0; done < options.steps; done += batch) {
+            const size_t count = std::min(batch, options.steps - done);
+            engine.performSignalSweepBlock(1.0, count, outputs.data());
+        }
+    };
+
+    for (size_t r = 0; r < options.warmup; r++) repetition();
+
+    std::vector<double> samples;
+    samples.reserve(options.repetitions);
+    for (size_t r = 0; r < options.repetitions; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        repetition();
+        const auto end = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        samples.push_back(ns / static_cast<double>(options.steps));
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchResult result;
+    result.config = config;
+    result.worker_threads = engine.getThreadCount();
+    if (!samples.empty()) {
+        result.median_ns = percentile(samples, 0.5);
+        result.p99_ns = percentile(samples, 0.99);
+        result.min_ns = samples.front();
+        double sum = 0.0;
+        for (double sample : samples) sum += sample;
+        result.mean_ns = sum / samples.size();
+        result.ns_per_node = config.nodes ? result.median_ns / config.nodes : 0.0;
+    }
+    return result;
+}
+
+static bool runConfiguredCase(const BenchCase& config, const BenchOptions& options, BenchResult& result) {
+    if (config.precision == "double") {
+        result = runCase<AnalogCellularEngine>(config, options);
+    } else if (config.precision == "float32") {
+        result = runCase<AnalogCellularEngineF32>(config, options);
+    } else if (config.precision == "mixed") {
+        result = runCase<AnalogCellularEngineMixed>(config, options);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// ---- Command line ----
+
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+static bool parseSizeList(const std::string& text, std::vector<size_t>& values) {
+    values.clear();
+    for (const auto& item : splitList(text)) {
+        char* end = nullptr;
+        const unsigned long long value = std::strtoull(item.c_str(), &end, 10);
+        if (end == item.c_str() || *end != '\0') return false;
+        values.push_back(static_cast<size_t>(value));
+    }
+    return !values.empty();
+}
+
+static bool parseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") return false;
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        std::vector<size_t> single;
+        if (arg == "--nodes") {
+            if (!parseSizeList(value, options.nodes)) return false;
+        } else if (arg == "--threads") {
+            if (!parseSizeList(value, options.threads)) return false;
+        } else if (arg == "--batch") {
+            if (!parseSizeList(value, options.batches)) return false;
+        } else if (arg == "--precision") {
+            options.precisions = splitList(value);
+            if (options.precisions.empty()) return false;
+        } else if (arg == "--steps" || arg == "--warmup" || arg == "--reps") {
+            if (!parseSizeList(value, single) || single.size() != 1) return false;
+            (arg == "--steps" ? options.steps : arg == "--warmup" ? options.warmup : options.repetitions) = single[0];
+        } else if (arg == "--format") {
+            options.format = value;
+            if (value != "text" && value != "json" && value != "csv") return false;
+        } else if (arg == "--output") {
+            options.output = value;
+        } else if (arg == "--baseline") {
+            options.baseline = value;
+        } else if (arg == "--tolerance") {
+            options.tolerance = std::atof(value.c_str());
+        } else if (arg == "--isa") {
+            if (!analogSelectKernelIsa(value.c_str())) {
+                std::cerr << "Kernels for " << value << " are not built in or not supported by this CPU" << std::endl;
+                return false;
+            }
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+    return options.steps > 0 && options.repetitions > 0;
+}
+
+static void printUsage() {
+    std::cerr << "Usage: dase_bench [--nodes N,..] [--threads N,..] [--batch N,..]\n"
+              << "                  [--precision double,float32,mixed] [--steps N] [--warmup N] [--reps N]\n"
+              << "                  [--format text|json|csv] [--output FILE]\n"
+              << "                  [--baseline FILE.csv] [--tolerance FRACTION] [--isa NAME]" << std::endl;
+}
+
+// ---- Output ----
+
+static const char* kCsvHeader = "nodes,threads,batch,precision,worker_threads,steps,repetitions,"
+                                "median_ns,p99_ns,min_ns,mean_ns,ns_per_node";
+
+static void writeCsv(std::ostream& out, const std::vector<BenchResult>& results, const BenchOptions& options) {
+    out << kCsvHeader << "\n" << std::fixed << std::setprecision(3);
+    for (const auto& r : results) {
+        out << r.config.nodes << "," << r.config.threads << "," << r.config.batch << "," << r.config.precision << ","
+            << r.worker_threads << "," << options.steps << "," << options.repetitions << ","
+            << r.median_ns << "," << r.p99_ns << "," << r.min_ns << "," << r.mean_ns << "," << r.ns_per_node << "\n";
+    }
+}
+
+static void writeJson(std::ostream& out, const std::vector<BenchResult>& results, const BenchOptions& options) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\n";
+    out << "  \"benchmark_type\": \"dase_bench\",\n";
+    out << "  \"kernel_isa\": \"" << analogKernelIsa() << "\",\n";
+    out << "  \"steps\": " << options.steps << ",\n";
+    out << "  \"warmup\": " << options.warmup << ",\n";
+    out << "  \"repetitions\": " << options.repetitions << ",\n";
+    out << "  \"results\": [\n";
+    for (size_t k = 0; k < results.size(); k++) {
+        const auto& r = results[k];
+        out << "    {\"nodes\": " << r.config.nodes << ", \"threads\": " << r.config.threads
+            << ", \"batch\": " << r.config.batch << ", \"precision\": \"" << r.config.precision << "\""
+            << ", \"worker_threads\": " << r.worker_threads << ", \"median_ns\": " << r.median_ns
+            << ", \"p99_ns\": " << r.p99_ns << ", \"min_ns\": " << r.min_ns << ", \"mean_ns\": " << r.mean_ns
+            << ", \"ns_per_node\": " << r.ns_per_node << "}" << (k + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+static void writeText(std::ostream& out, const std::vector<BenchResult>& results, const BenchOptions& options) {
+    out << "=== D-ASE BENCHMARK SUITE ===\n";
+    out << "Kernel: " << analogKernelIsa() << "  steps/rep: " << options.steps << "  warmup: " << options.warmup
+        << "  reps: " << options.repetitions << "\n\n";
+    out << std::setw(8) << "nodes" << std::setw(8) << "threads" << std::setw(7) << "batch" << std::setw(10) << "precision"
+        << std::setw(14) << "median ns" << std::setw(14) << "p99 ns" << std::setw(12) << "ns/node" << "\n";
+    out << std::fixed << std::setprecision(1);
+    for (const auto& r : results) {
+        out << std::setw(8) << r.config.nodes << std::setw(8) << r.worker_threads << std::setw(7) << r.config.batch
+            << std::setw(10) << r.config.precision << std::setw(14) << r.median_ns << std::setw(14) << r.p99_ns
+            << std::setw(12) << std::setprecision(3) << r.ns_per_node << std::setprecision(1) << "\n";
+    }
+}
+
+// ---- Regression mode ----
+
+static bool loadBaseline(const std::string& path, std::vector<BenchResult>& baseline) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    if (!std::getline(in, line)) return false;  // Header
+    while (std::getline(in, line)) {
+        const std::vector<std::string> fields = splitList(line);
+        if (fields.size() < 12) continue;
+        BenchResult r;
+        r.config.nodes = std::strtoull(fields[0].c_str(), nullptr, 10);
+        r.config.threads = std::strtoull(fields[1].c_str(), nullptr, 10);
+        r.config.batch = std::strtoull(fields[2].c_str(), nullptr, 10);
+        r.config.precision = fields[3];
+        r.worker_threads = std::strtoull(fields[4].c_str(), nullptr, 10);
+        r.median_ns = std::atof(fields[7].c_str());
+        r.p99_ns = std::atof(fields[8].c_str());
+        baseline.push_back(r);
+    }
+    return true;
+}
+
+// Returns the number of regressed configurations
+static size_t compareWithBaseline(const std::vector<BenchResult>& results, const std::vector<BenchResult>& baseline,
+                                  double tolerance) {
+    size_t regressions = 0;
+    std::cerr << "\n=== REGRESSION CHECK (tolerance " << std::fixed << std::setprecision(1)
+              << tolerance * 100.0 << "%) ===" << std::endl;
+    for (const auto& r : results) {
+        const auto match = std::find_if(baseline.begin(), baseline.end(), [&](const BenchResult& b) {
+            return b.config.nodes == r.config.nodes && b.config.threads == r.config.threads &&
+                   b.config.batch == r.config.batch && b.config.precision == r.config.precision;
+        });
+        std::cerr << std::setw(8) << r.config.nodes << std::setw(8) << r.config.threads << std::setw(7)
+                  << r.config.batch << std::setw(10) << r.config.precision << "  ";
+        if (match == baseline.end() || match->median_ns <= 0.0) {
+            std::cerr << "no baseline" << std::endl;
+            continue;
+        }
+        const double ratio = r.median_ns / match->median_ns;
+        const char* verdict = "ok";
+        if (ratio > 1.0 + tolerance) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (ratio < 1.0 - tolerance) {
+            verdict = "improved";
+        }
+        std::cerr << std::setprecision(1) << match->median_ns << " -> " << r.median_ns << " ns ("
+                  << std::showpos << (ratio - 1.0) * 100.0 << std::noshowpos << "%) " << verdict << std::endl;
+    }
+    return regressions;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    std::vector<BenchResult> results;
+    for (size_t nodes : options.nodes) {
+        for (size_t threads : options.threads) {
+            for (size_t batch : options.batches) {
+                for (const auto& precision : options.precisions) {
+                    BenchCase config{nodes, threads, batch, precision};
+                    BenchResult result;
+                    if (!runConfiguredCase(config, options, result)) {
+                        std::cerr << "Unknown precision " << precision << std::endl;
+                        return 2;
+                    }
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Cannot write " << options.output << std::endl;
+            return 2;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+    if (options.format == "csv") {
+        writeCsv(out, results, options);
+    } else if (options.format == "json") {
+        writeJson(out, results, options);
+    } else {
+        writeText(out, results, options);
+    }
+
+    if (!options.baseline.empty()) {
+        std::vector<BenchResult> baseline;
+        if (!loadBaseline(options.baseline, baseline)) {
+            std::cerr << "Cannot read baseline " << options.baseline << std::endl;
+            return 2;
+        }
+        if (compareWithBaseline(results, baseline, options.tolerance) > 0) return 1;
+    }
+    return 0;
+}
+
+#endif // BENCHMARK_BUILD
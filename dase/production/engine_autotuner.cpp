@@ -0,0 +1,257 @@
+#include "engine_autotuner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+static const char* kTuningCsvHeader = "cpu_model,cpus,nodes,precision,threads,schedule,chunk,sequential_below,wave_ns";
+
+// More threads must beat the current best by this fraction to replace it
+static constexpr double kMinThreadGain = 0.02;
+
+// Cache key fields are comma separated, so the model name must not contain commas
+static std::string cleanModelName(const std::string& raw) {
+    std::string name;
+    for (char c : raw) {
+        const char mapped = (c == ',' || c == '\t' || c == '\n' || c == '\r') ? ' ' : c;
+        if (mapped == ' ' && (name.empty() || name.back() == ' ')) continue;
+        name += mapped;
+    }
+    while (!name.empty() && name.back() == ' ') name.pop_back();
+    return name;
+}
+
+std::string engineCpuModel() {
+#if defined(__linux__)
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 10, "model name") != 0) continue;
+        const size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            const std::string name = cleanModelName(line.substr(colon + 1));
+            if (!name.empty()) return name;
+        }
+    }
+#endif
+    // CPUID leaves 0x80000002..4 carry the 48-byte brand string
+    unsigned int words[12] = {};
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4];
+    __cpuid(regs, 0x80000000);
+    if (static_cast<unsigned int>(regs[0]) >= 0x80000004u) {
+        for (int leaf = 0; leaf < 3; leaf++) {
+            __cpuid(regs, 0x80000002 + leaf);
+            std::memcpy(words + leaf * 4, regs, sizeof(regs));
+        }
+    }
+#elif defined(__x86_64__) || defined(__i386__)
+    if (__get_cpuid_max(0x80000000u, nullptr) >= 0x80000004u) {
+        for (unsigned int leaf = 0; leaf < 3; leaf++) {
+            __get_cpuid(0x80000002u + leaf, &words[leaf * 4], &words[leaf * 4 + 1], &words[leaf * 4 + 2],
+                        &words[leaf * 4 + 3]);
+        }
+    }
+#endif
+    char brand[sizeof(words) + 1] = {};
+    std::memcpy(brand, words, sizeof(words));
+    const std::string name = cleanModelName(brand);
+    return name.empty() ? "unknown" : name;
+}
+
+// Same names as dase_bench --precision
+template <typename Scalar, typename Accum>
+static const char* precisionName() {
+    if (sizeof(Scalar) == sizeof(double)) return "double";
+    return sizeof(Accum) == sizeof(double) ? "mixed" : "float32";
+}
+
+// ---- Cache file ----
+
+struct TuningCacheEntry {
+    std::string cpu_model;
+    size_t cpus = 0;
+    size_t nodes = 0;
+    std::string precision;
+    EngineTuning tuning;
+};
+
+static std::vector<std::string> splitCsvLine(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, ',')) fields.push_back(field);
+    return fields;
+}
+
+static std::vector<TuningCacheEntry> loadTuningCache(const std::string& path) {
+    std::vector<TuningCacheEntry> entries;
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line)) return entries;  // Header
+    while (std::getline(in, line)) {
+        const std::vector<std::string> fields = splitCsvLine(line);
+        if (fields.size() < 9) continue;
+        TuningCacheEntry entry;
+        entry.cpu_model = fields[0];
+        entry.cpus = std::strtoull(fields[1].c_str(), nullptr, 10);
+        entry.nodes = std::strtoull(fields[2].c_str(), nullptr, 10);
+        entry.precision = fields[3];
+        entry.tuning.threads = std::strtoull(fields[4].c_str(), nullptr, 10);
+        entry.tuning.schedule = fields[5] == "static" ? EngineSchedule::Static : EngineSchedule::Dynamic;
+        entry.tuning.chunk = std::max<size_t>(1, std::strtoull(fields[6].c_str(), nullptr, 10));
+        entry.tuning.sequential_below = std::strtoull(fields[7].c_str(), nullptr, 10);
+        entry.tuning.wave_ns = std::atof(fields[8].c_str());
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+// Rewrites the whole file through a temporary, so readers never see half a table
+static bool saveTuningCache(const std::string& path, const std::vector<TuningCacheEntry>& entries) {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        if (!out) return false;
+        out.precision(10);
+        out << kTuningCsvHeader << "\n";
+        for (const auto& entry : entries) {
+            const EngineTuning& t = entry.tuning;
+            out << entry.cpu_model << "," << entry.cpus << "," << entry.nodes << "," << entry.precision << ","
+                << t.threads << "," << (t.schedule == EngineSchedule::Static ? "static" : "dynamic") << ","
+                << t.chunk << "," << t.sequential_below << "," << t.wave_ns << "\n";
+        }
+        if (!out.flush()) return false;
+    }
+    std::remove(path.c_str());  // rename() does not replace on Windows
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+static bool sameKey(const TuningCacheEntry& entry, const std::string& cpu_model, size_t cpus, size_t nodes,
+                    const char* precision) {
+    return entry.cpu_model == cpu_model && entry.cpus == cpus && entry.nodes == nodes && entry.precision == precision;
+}
+
+// ---- Benchmark ----
+
+// Best time per wave over a few rounds of about candidate_seconds in total
+template <typename Scalar, typename Accum>
+static double timeCandidate(size_t node_count, const AnalogEngineConfig& config, const AnalogLatticeLayout& layout,
+                            double candidate_seconds) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kRounds = 5;
+    AnalogCellularEngineT<Scalar, Accum> engine(node_count, config, layout);
+    double input = 0.0;
+    for (int warm = 0; warm < 2; warm++) engine.processSignalWave(input += 0.01, 0.1);
+    const double round_seconds = candidate_seconds / kRounds;
+    double best = 0.0;
+    for (int round = 0; round < kRounds; round++) {
+        const Clock::time_point start = Clock::now();
+        size_t waves = 0;
+        double elapsed = 0.0;
+        do {
+            engine.processSignalWave(input += 0.01, 0.1);
+            waves++;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < round_seconds);
+        const double wave_ns = elapsed * 1.0e9 / static_cast<double>(waves);
+        if (round == 0 || wave_ns < best) best = wave_ns;
+    }
+    return best;
+}
+
+template <typename Scalar, typename Accum>
+EngineTuning autotuneEngine(size_t node_count, const AnalogEngineConfig& base, const AnalogLatticeLayout& layout,
+                            const EngineAutotuneOptions& options) {
+    const std::string cpu_model = engineCpuModel();
+    const size_t cpus = EngineThreadPool::getAvailableCpuCount();
+    const char* precision = precisionName<Scalar, Accum>();
+
+    std::vector<TuningCacheEntry> cache;
+    if (!options.cache_path.empty()) {
+        cache = loadTuningCache(options.cache_path);
+        if (!options.refresh) {
+            for (const auto& entry : cache) {
+                if (!sameKey(entry, cpu_model, cpus, node_count, precision)) continue;
+                if (base.num_threads && entry.tuning.threads > base.num_threads) continue;  // Above the caller's cap
+                EngineTuning tuning = entry.tuning;
+                tuning.cached = true;
+                return tuning;
+            }
+        }
+    }
+
+    // Sequential first, then thread counts in increasing order so ties go to fewer threads
+    const size_t max_threads = base.num_threads ? base.num_threads : cpus;
+    std::vector<EngineTuning> candidates;
+    EngineTuning sequential;
+    sequential.threads = 1;
+    sequential.sequential_below = node_count + 1;
+    candidates.push_back(sequential);
+    // Dynamic chunks beyond one grab per worker per segment only repeat the static split
+    constexpr size_t kLaneBlock = kAnalogLaneBlockFor<Scalar>;
+    const size_t segments = reductionSegmentCount((node_count + kLaneBlock - 1) / kLaneBlock);
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 2; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    if (max_threads >= 2) thread_counts.push_back(max_threads);
+    for (size_t threads : thread_counts) {
+        EngineTuning slices;
+        slices.threads = threads;
+        slices.schedule = EngineSchedule::Static;
+        candidates.push_back(slices);
+        for (size_t chunk = 1; chunk <= 8 && (chunk == 1 || chunk * threads <= segments); chunk *= 2) {
+            EngineTuning grabs;
+            grabs.threads = threads;
+            grabs.schedule = EngineSchedule::Dynamic;
+            grabs.chunk = chunk;
+            candidates.push_back(grabs);
+        }
+    }
+
+    EngineTuning best;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        AnalogEngineConfig config = base;
+        candidates[i].apply(config);
+        const double wave_ns = timeCandidate<Scalar, Accum>(node_count, config, layout, options.candidate_seconds);
+        const bool more_threads = i > 0 && candidates[i].threads > best.threads;
+        const double required = more_threads ? best.wave_ns * (1.0 - kMinThreadGain) : best.wave_ns;
+        if (i == 0 || wave_ns < required) {
+            best = candidates[i];
+            best.wave_ns = wave_ns;
+        }
+    }
+    best.candidates = candidates.size();
+
+    if (!options.cache_path.empty()) {
+        cache.erase(std::remove_if(cache.begin(), cache.end(), [&](const TuningCacheEntry& entry) {
+                        return sameKey(entry, cpu_model, cpus, node_count, precision);
+                    }),
+                    cache.end());
+        TuningCacheEntry entry;
+        entry.cpu_model = cpu_model;
+        entry.cpus = cpus;
+        entry.nodes = node_count;
+        entry.precision = precision;
+        entry.tuning = best;
+        cache.push_back(entry);
+        saveTuningCache(options.cache_path, cache);
+    }
+    return best;
+}
+
+template EngineTuning autotuneEngine<double>(size_t, const AnalogEngineConfig&, const AnalogLatticeLayout&,
+                                             const EngineAutotuneOptions&);
+template EngineTuning autotuneEngine<float>(size_t, const AnalogEngineConfig&, const AnalogLatticeLayout&,
+                                            const EngineAutotuneOptions&);
+template EngineTuning autotuneEngine<float, double>(size_t, const AnalogEngineConfig&, const AnalogLatticeLayout&,
+                                                    const EngineAutotuneOptions&);
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "analog_universal_node_engine.h"
+
+// AUTOTUNE: Pick the thread count and work distribution for one engine size on this
+// host by timing them. Candidates are the calling thread alone (sequential), then
+// 2, 4, 8 ... up to the available CPUs, each with static slices and with dynamic
+// grabs of 1, 2, 4 and 8 work items. Every candidate runs processSignalWave on a
+// scratch engine of the requested size, layout and precision, so the caller's
+// engine state is never touched. A candidate with more threads has to win by more
+// than 2% to be chosen, so memory-bound sizes settle on the smallest count that
+// saturates bandwidth rather than on noise.
+//
+// Winners are cached in a CSV file keyed by CPU model, available CPUs, node count
+// and precision; later startups on the same host reuse them without benchmarking.
+struct EngineAutotuneOptions {
+    std::string cache_path;             // Earlier winners; empty = always benchmark, store nothing
+    double candidate_seconds = 0.02;    // Timed waves per candidate
+    bool refresh = false;               // Benchmark even on a cache hit and replace the entry
+};
+
+struct EngineTuning {
+    size_t threads = 0;                 // AnalogEngineConfig::num_threads
+    EngineSchedule schedule = EngineSchedule::Dynamic;
+    size_t chunk = 1;
+    size_t sequential_below = 0;
+    double wave_ns = 0.0;               // Best time per wave of the winner
+    size_t candidates = 0;              // Configurations timed (0 on a cache hit)
+    bool cached = false;                // Taken from the cache file
+
+    // Copy the choice into a config; other fields (affinity, reduction ...) are kept
+    void apply(AnalogEngineConfig& config) const {
+        config.num_threads = threads;
+        config.schedule = schedule;
+        config.chunk = chunk;
+        config.sequential_below = sequential_below;
+    }
+};
+
+// "model name" from /proc/cpuinfo or the CPUID brand string; "unknown" otherwise
+std::string engineCpuModel();
+
+// Best configuration for an AnalogCellularEngineT<Scalar, Accum> of `node_count` nodes.
+// `base` supplies everything that is not tuned; a non-zero base.num_threads caps the
+// thread counts tried. A cache file that cannot be read or written only costs a benchmark.
+template <typename Scalar, typename Accum = Scalar>
+EngineTuning autotuneEngine(size_t node_count, const AnalogEngineConfig& base = AnalogEngineConfig(),
+                            const AnalogLatticeLayout& layout = AnalogLatticeLayout(),
+                            const EngineAutotuneOptions& options = EngineAutotuneOptions());
@@ -0,0 +1,41 @@
+#include "engine_command_queue.h"
+
+EngineCommandQueue::EngineCommandQueue(size_t requested) {
+    size_t size = 2;
+    while (size < requested) size <<= 1;
+    cells = std::make_unique<Cell[]>(size);
+    mask = size - 1;
+    for (size_t i = 0; i < size; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+// Cell at position p is free for the producer of p when its sequence is p, and
+// holds a command for the consumer when its sequence is p + 1
+bool EngineCommandQueue::push(const EngineCommand& command) {
+    size_t position = tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[position & mask];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (lag == 0) {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.command = command;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (lag < 0) {
+            return false;  // The consumer has not freed this cell yet: full
+        } else {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool EngineCommandQueue::pop(EngineCommand& command) {
+    const size_t position = head.load(std::memory_order_relaxed);
+    Cell& cell = cells[position & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1) return false;
+    command = cell.command;
+    cell.sequence.store(position + mask + 1, std::memory_order_release);  // Free for the next lap
+    head.store(position + 1, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// COMMANDS: Live parameter updates for a running engine. Any thread may post;
+// the engine drains the queue on its driving thread at the next wave boundary.
+enum class EngineCommandType : uint8_t {
+    SetFeedback,          // Every node's feedback gain = value (clamped to [0.1, 10])
+    SetNodeFeedback,      // Node `node` feedback gain = value (clamped to [0.1, 10])
+    ResetIntegrators,     // Every node's integrator and differentiator history
+    ResetNode,            // Integrator and differentiator history of node `node`
+    SetFrequency,         // system_frequency = value
+    SetNoise,             // Input noise standard deviation = value (setNoise, same seed)
+    SetTimeStep           // Clock time step = value
+};
+
+struct EngineCommand {
+    EngineCommandType type = EngineCommandType::SetFeedback;
+    uint32_t node = 0;    // Node ID for the per-node commands
+    double value = 0.0;
+};
+
+// LOCK-FREE: Bounded multi-producer ring of commands. Every cell carries a sequence
+// number that tells producers and the consumer whose turn the cell is, so a push
+// is one CAS on the tail plus a release store and never waits for another producer
+// to finish. pop() is for a single consumer.
+class EngineCommandQueue {
+public:
+    explicit EngineCommandQueue(size_t capacity = 1024);    // Rounded up to a power of two
+
+    EngineCommandQueue(const EngineCommandQueue&) = delete;
+    EngineCommandQueue& operator=(const EngineCommandQueue&) = delete;
+
+    bool push(const EngineCommand& command);   // Any thread; false when full
+    bool pop(EngineCommand& command);          // Consumer thread; false when empty
+    bool empty() const {                       // Consumer thread: nothing ready to pop
+        const size_t position = head.load(std::memory_order_relaxed);
+        return cells[position & mask].sequence.load(std::memory_order_acquire) != position + 1;
+    }
+    size_t capacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        EngineCommand command;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> tail{0};   // Next position a producer claims
+    alignas(64) std::atomic<size_t> head{0};   // Next position the consumer reads
+};
@@ -0,0 +1,124 @@
+#include "engine_huge_page_arena.h"
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+HugePageArena::HugePageArena(size_t max_bytes) {
+    reserved = (max_bytes + kChunkBytes - 1) / kChunkBytes * kChunkBytes;
+    if (reserved == 0) return;
+#ifdef _WIN32
+    base = static_cast<char*>(VirtualAlloc(nullptr, reserved, MEM_RESERVE, PAGE_NOACCESS));
+#else
+    // One extra chunk of slack so the usable range can start on a 2 MB boundary
+    mapping_bytes = reserved + kChunkBytes;
+    mapping = mmap(nullptr, mapping_bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+    } else {
+        const uintptr_t start = reinterpret_cast<uintptr_t>(mapping);
+        base = reinterpret_cast<char*>((start + kChunkBytes - 1) / kChunkBytes * kChunkBytes);
+    }
+#endif
+    if (!base) reserved = 0;
+}
+
+HugePageArena::~HugePageArena() {
+#ifdef _WIN32
+    if (base) VirtualFree(base, 0, MEM_RELEASE);
+#else
+    if (mapping) munmap(mapping, mapping_bytes);
+#endif
+}
+
+// Commit whole chunks until `bytes` are usable
+bool HugePageArena::commit(size_t bytes) {
+    while (committed < bytes) {
+        char* chunk = base + committed;
+#ifdef _WIN32
+        if (!VirtualAlloc(chunk, kChunkBytes, MEM_COMMIT, PAGE_READWRITE)) return false;
+#else
+        bool huge = false;
+#ifdef MAP_HUGETLB
+        // Explicit huge page over the reserved chunk; fails when the pool is empty
+        void* page = mmap(chunk, kChunkBytes, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB, -1, 0);
+        huge = page != MAP_FAILED;
+#endif
+        if (huge) {
+            huge_chunks++;
+        } else {
+            // A failed MAP_FIXED may already have unmapped the chunk, so map it afresh
+            // rather than mprotect() the reservation
+            if (mmap(chunk, kChunkBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) ==
+                MAP_FAILED) {
+                return false;
+            }
+#ifdef MADV_HUGEPAGE
+            madvise(chunk, kChunkBytes, MADV_HUGEPAGE);
+#endif
+        }
+#endif
+        committed += kChunkBytes;
+    }
+    return true;
+}
+
+void* HugePageArena::allocate(size_t bytes, size_t alignment) {
+    if (!base || alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > kChunkBytes) return nullptr;
+    const size_t offset = (used + alignment - 1) & ~(alignment - 1);
+    if (offset > reserved || bytes > reserved - offset) return nullptr;
+    if (!commit(offset + bytes)) return nullptr;
+    used = offset + bytes;
+    return base + offset;
+}
+
+bool HugePageArena::adoptFile(const std::string& path, size_t offset, size_t bytes) {
+    used = 0;
+#ifdef _WIN32
+    // A file view cannot be placed inside a VirtualAlloc reservation
+    (void)path;
+    (void)offset;
+    (void)bytes;
+    return false;
+#else
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (!base || bytes == 0 || bytes > reserved || offset % page != 0) return false;
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < offset ||
+        static_cast<size_t>(info.st_size) - offset < bytes) {
+        close(fd);
+        return false;
+    }
+
+    // Back to bare reservation, then fresh memory for the chunks and the file on top
+    const size_t chunk_bytes = (bytes + kChunkBytes - 1) / kChunkBytes * kChunkBytes;
+    const size_t span = committed > chunk_bytes ? committed : chunk_bytes;
+    bool mapped = mmap(base, span, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE, -1, 0) !=
+                  MAP_FAILED;
+    committed = 0;
+    huge_chunks = 0;
+    mapped = mapped && mmap(base, chunk_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1,
+                            0) != MAP_FAILED;
+    // The last file page may run past the end of the file; the OS zero-fills it
+    const size_t file_bytes = (bytes + page - 1) / page * page;
+    mapped = mapped && mmap(base, file_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd,
+                            static_cast<off_t>(offset)) != MAP_FAILED;
+    close(fd);
+    if (!mapped) {
+        mmap(base, chunk_bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE, -1, 0);
+        return false;
+    }
+    committed = chunk_bytes;
+    used = bytes;
+    return true;
+#endif
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// ARENA: Growable bump allocator over one reserved virtual address range. The
+// range is reserved up front (address space only) and committed in 2 MB chunks
+// as allocations reach them, so memory grows on demand while every address stays
+// stable and consecutive allocations stay contiguous. On Linux each chunk is
+// 2 MB aligned and backed by an explicit huge page when the hugetlbfs pool has
+// one, otherwise by a normal mapping advised for transparent huge pages.
+// Not thread-safe: callers serialize allocate() and reset().
+class HugePageArena {
+public:
+    static constexpr size_t kChunkBytes = size_t(2) << 20;
+
+    // Reserves `max_bytes` (rounded up to whole chunks); isValid() is false if
+    // the address space could not be reserved
+    explicit HugePageArena(size_t max_bytes = size_t(1) << 30);
+    ~HugePageArena();
+    HugePageArena(const HugePageArena&) = delete;
+    HugePageArena& operator=(const HugePageArena&) = delete;
+
+    // `bytes` at `alignment` (a power of two, at most one chunk), committing chunks
+    // as needed; nullptr past the reservation or when the OS refuses to commit
+    void* allocate(size_t bytes, size_t alignment = 64);
+    // Rewind to empty. Committed chunks stay mapped and are handed out again.
+    void reset() { used = 0; }
+    // ADOPT: Empty the arena, then map `bytes` of `path` from `offset` (a multiple
+    // of the page size) copy-on-write as its first `bytes`; allocations continue
+    // behind them. Pages are read from the file on first touch and copied only when
+    // written, so the file itself never changes. Chunks are released first and not
+    // backed by huge pages. False, with the arena left empty, if the file is too
+    // short or the OS cannot place the mapping (always on Windows).
+    bool adoptFile(const std::string& path, size_t offset, size_t bytes);
+
+    bool isValid() const { return base != nullptr; }
+    char* data() const { return base; }
+    size_t getUsedBytes() const { return used; }
+    size_t getCommittedBytes() const { return committed; }
+    size_t getReservedBytes() const { return reserved; }
+    size_t getHugePageChunks() const { return huge_chunks; }   // Chunks backed by explicit huge pages
+
+private:
+    char* base = nullptr;
+    size_t reserved = 0;
+    size_t committed = 0;
+    size_t used = 0;
+    size_t huge_chunks = 0;
+#ifndef _WIN32
+    void* mapping = nullptr;       // Whole reservation including alignment slack
+    size_t mapping_bytes = 0;
+#endif
+
+    bool commit(size_t bytes);
+};
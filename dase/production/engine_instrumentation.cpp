@@ -0,0 +1,180 @@
+#include "engine_instrumentation.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+double EngineInstrumentationSnapshot::imbalance() const {
+    if (workers.empty()) return 1.0;
+    double total = 0.0, busiest = 0.0;
+    for (const auto& worker : workers) {
+        total += worker.busy_ns;
+        busiest = std::max(busiest, worker.busy_ns);
+    }
+    const double mean = total / workers.size();
+    return mean > 0.0 ? busiest / mean : 1.0;
+}
+
+std::string formatInstrumentationJson(const EngineInstrumentationSnapshot& snapshot) {
+    auto counters = [](std::ostream& out, const PerfCounterValues& values) {
+        out << "{\"cycles\": " << values.cycles << ", \"instructions\": " << values.instructions
+            << ", \"llc_misses\": " << values.llc_misses << ", \"branch_misses\": " << values.branch_misses << "}";
+    };
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(0);
+    out << "{\"enabled\": " << (snapshot.enabled ? "true" : "false")
+        << ", \"regions\": " << snapshot.phases.regions
+        << ", \"compute_ns\": " << snapshot.phases.compute_ns
+        << ", \"barrier_ns\": " << snapshot.phases.barrier_ns
+        << ", \"reduction_ns\": " << snapshot.phases.reduction_ns
+        << ", \"imbalance\": " << std::setprecision(3) << snapshot.imbalance() << std::setprecision(0)
+        << ", \"workers\": [";
+    for (size_t w = 0; w < snapshot.workers.size(); w++) {
+        const auto& worker = snapshot.workers[w];
+        out << (w ? ", " : "") << "{\"tasks\": " << worker.tasks << ", \"busy_ns\": " << worker.busy_ns
+            << ", \"idle_ns\": " << worker.idle_ns;
+        if (snapshot.perf_counters) {
+            out << ", \"counters\": ";
+            counters(out, worker.counters);
+        }
+        out << "}";
+    }
+    out << "]";
+    if (snapshot.perf_counters) {
+        out << ", \"counters\": ";
+        counters(out, snapshot.counters);
+    }
+    out << "}";
+    return out.str();
+}
+
+// PERF_EVENT: One user-space counting event per fd, attached to the calling thread
+PerfCounterGroup::~PerfCounterGroup() {
+#if defined(__linux__)
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+bool PerfCounterGroup::open() {
+#if defined(__linux__)
+    const uint64_t configs[4] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                 PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (int k = 0; k < 4; k++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[k];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fds[k] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fds[k] < 0) {
+            for (int j = 0; j < k; j++) {
+                close(fds[j]);
+                fds[j] = -1;
+            }
+            return false;
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+PerfCounterValues PerfCounterGroup::read() const {
+    PerfCounterValues values;
+#if defined(__linux__)
+    uint64_t* targets[4] = {&values.cycles, &values.instructions, &values.llc_misses, &values.branch_misses};
+    for (int k = 0; k < 4; k++) {
+        uint64_t value = 0;
+        if (fds[k] >= 0 && ::read(fds[k], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+            *targets[k] = value;
+        }
+    }
+#endif
+    return values;
+}
+
+EngineInstrumentation::EngineInstrumentation(size_t worker_count)
+    : slots(worker_count) {}
+
+void EngineInstrumentation::endRegion(uint64_t region_start) {
+    const uint64_t wall = now() - region_start;
+    uint64_t busiest = 0;
+    for (auto& slot : slots) busiest = std::max(busiest, slot.region_busy_ns);
+    for (auto& slot : slots) {
+        slot.busy_ns += slot.region_busy_ns;
+        slot.idle_ns += wall > slot.region_busy_ns ? wall - slot.region_busy_ns : 0;
+        slot.region_busy_ns = 0;
+    }
+    phases.regions++;
+    phases.compute_ns += static_cast<double>(std::min(busiest, wall));
+    phases.barrier_ns += static_cast<double>(wall > busiest ? wall - busiest : 0);
+}
+
+void EngineInstrumentation::endReduction(uint64_t reduction_start) {
+    phases.reduction_ns += static_cast<double>(now() - reduction_start);
+    if (export_interval == 0 || !export_stream.is_open()) return;
+    if (++regions_since_export >= export_interval) {
+        regions_since_export = 0;
+        export_stream << formatInstrumentationJson(snapshot()) << '\n';
+        export_stream.flush();
+    }
+}
+
+EngineInstrumentationSnapshot EngineInstrumentation::snapshot() const {
+    EngineInstrumentationSnapshot result;
+    result.enabled = true;
+    result.perf_counters = !slots.empty() && std::all_of(slots.begin(), slots.end(),
+                                                         [](const WorkerSlot& slot) { return slot.counters.isOpen(); });
+    result.phases = phases;
+    result.workers.resize(slots.size());
+    for (size_t w = 0; w < slots.size(); w++) {
+        EngineWorkerStats& worker = result.workers[w];
+        worker.tasks = slots[w].tasks;
+        worker.busy_ns = static_cast<double>(slots[w].busy_ns);
+        worker.idle_ns = static_cast<double>(slots[w].idle_ns);
+        if (result.perf_counters) {
+            const PerfCounterValues now_values = slots[w].counters.read();
+            const PerfCounterValues& base = slots[w].counter_base;
+            worker.counters.cycles = now_values.cycles - base.cycles;
+            worker.counters.instructions = now_values.instructions - base.instructions;
+            worker.counters.llc_misses = now_values.llc_misses - base.llc_misses;
+            worker.counters.branch_misses = now_values.branch_misses - base.branch_misses;
+            result.counters.cycles += worker.counters.cycles;
+            result.counters.instructions += worker.counters.instructions;
+            result.counters.llc_misses += worker.counters.llc_misses;
+            result.counters.branch_misses += worker.counters.branch_misses;
+        }
+    }
+    return result;
+}
+
+void EngineInstrumentation::reset() {
+    for (auto& slot : slots) {
+        slot.region_busy_ns = slot.busy_ns = slot.idle_ns = slot.tasks = 0;
+        slot.counter_base = slot.counters.read();
+    }
+    phases = EnginePhaseStats();
+    regions_since_export = 0;
+}
+
+bool EngineInstrumentation::setExport(const std::string& path, uint64_t interval) {
+    if (export_stream.is_open()) export_stream.close();
+    export_interval = 0;
+    regions_since_export = 0;
+    if (path.empty() || interval == 0) return true;
+    export_stream.open(path, std::ios::app);
+    if (!export_stream) return false;
+    export_interval = interval;
+    return true;
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// INSTRUMENTATION: Engine telemetry is compiled in with -DDASE_ENABLE_INSTRUMENTATION.
+// Without it the engine keeps no timers or counters, and the query API reports
+// a snapshot with enabled == false. The flag changes the engine's layout, so every
+// translation unit that includes the engine header must agree on it.
+
+// Hardware counters of one thread (or their sum); user space only
+struct PerfCounterValues {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t llc_misses = 0;
+    uint64_t branch_misses = 0;
+};
+
+// Wall time of the engine's parallel regions, split into three phases:
+//   compute    critical path, the busiest worker's task time
+//   barrier    the rest of the region (dispatch, wake-up, waiting for the slowest worker)
+//   reduction  combining per-worker partials on the calling thread afterwards
+struct EnginePhaseStats {
+    uint64_t regions = 0;
+    double compute_ns = 0.0;
+    double barrier_ns = 0.0;
+    double reduction_ns = 0.0;
+};
+
+struct EngineWorkerStats {
+    uint64_t tasks = 0;
+    double busy_ns = 0.0;      // Inside tasks
+    double idle_ns = 0.0;      // In a region but not in a task
+    PerfCounterValues counters;  // Since the last reset, includes spin-waiting between regions
+};
+
+struct EngineInstrumentationSnapshot {
+    bool enabled = false;        // Built with DASE_ENABLE_INSTRUMENTATION
+    bool perf_counters = false;  // perf_event counters were opened for every worker
+    EnginePhaseStats phases;
+    std::vector<EngineWorkerStats> workers;
+    PerfCounterValues counters;  // Sum over workers
+
+    // Load imbalance: busiest worker's busy time over the mean (1.0 = perfect balance)
+    double imbalance() const;
+};
+
+// One JSON object on a single line (the periodic export format)
+std::string formatInstrumentationJson(const EngineInstrumentationSnapshot& snapshot);
+
+// PERF_EVENT: cycles, instructions, LLC misses and branch misses of the calling thread.
+// open() fails (returns false) off Linux or when perf_event_paranoid forbids it.
+class PerfCounterGroup {
+public:
+    PerfCounterGroup() = default;
+    ~PerfCounterGroup();
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool open();
+    bool isOpen() const { return fds[0] >= 0; }
+    PerfCounterValues read() const;  // Safe from any thread
+
+private:
+    int fds[4] = {-1, -1, -1, -1};
+};
+
+// Recorder owned by an instrumented engine. Task timings go to per-worker
+// cache-line slots; everything else runs on the calling thread between regions.
+class EngineInstrumentation {
+public:
+    explicit EngineInstrumentation(size_t worker_count);
+
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Called by worker `worker` after each task
+    void addTask(size_t worker, uint64_t ns) {
+        WorkerSlot& slot = slots[worker];
+        slot.region_busy_ns += ns;
+        slot.tasks++;
+    }
+
+    // Calling thread: close a region that started at region_start
+    void endRegion(uint64_t region_start);
+    // Calling thread: account the reduction that started at reduction_start, then export if due
+    void endReduction(uint64_t reduction_start);
+
+    // Opens counters for thread `worker`; must run on that thread
+    void openCounters(size_t worker) { slots[worker].counters.open(); }
+
+    EngineInstrumentationSnapshot snapshot() const;
+    void reset();
+
+    // Append a JSON line to `path` every `interval` regions (0 or empty path disables)
+    bool setExport(const std::string& path, uint64_t interval);
+
+private:
+    struct alignas(64) WorkerSlot {
+        uint64_t region_busy_ns = 0;
+        uint64_t busy_ns = 0;
+        uint64_t idle_ns = 0;
+        uint64_t tasks = 0;
+        PerfCounterGroup counters;
+        PerfCounterValues counter_base;  // Counter values at the last reset
+    };
+
+    std::vector<WorkerSlot> slots;
+    EnginePhaseStats phases;
+
+    std::ofstream export_stream;
+    uint64_t export_interval = 0;
+    uint64_t regions_since_export = 0;
+};
@@ -0,0 +1,103 @@
+#include "engine_mapped_file.h"
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::openRead(const std::string& path) {
+    close();
+    return map(path, 0, Mode::Read);
+}
+
+bool MappedFile::openPrivate(const std::string& path) {
+    close();
+    return map(path, 0, Mode::CopyOnWrite);
+}
+
+bool MappedFile::create(const std::string& path, size_t length) {
+    close();
+    return length > 0 && map(path, length, Mode::Create);
+}
+
+bool MappedFile::map(const std::string& path, size_t length, Mode mode) {
+    const bool writable = mode == Mode::Create;
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ | (writable ? GENERIC_WRITE : 0),
+                                FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, writable ? CREATE_ALWAYS : OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+    if (!writable) {
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+            CloseHandle(handle);
+            return false;
+        }
+        length = static_cast<size_t>(size.QuadPart);
+    }
+    const uint64_t wide = length;
+    const DWORD protection = writable ? PAGE_READWRITE : (mode == Mode::CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY);
+    HANDLE section = CreateFileMappingA(handle, nullptr, protection,
+                                        static_cast<DWORD>(wide >> 32), static_cast<DWORD>(wide & 0xFFFFFFFFu), nullptr);
+    if (!section) {
+        CloseHandle(handle);
+        return false;
+    }
+    const DWORD access = writable ? FILE_MAP_WRITE : (mode == Mode::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ);
+    void* view = MapViewOfFile(section, access, 0, 0, length);
+    if (!view) {
+        CloseHandle(section);
+        CloseHandle(handle);
+        return false;
+    }
+    file = handle;
+    mapping = section;
+#else
+    const int handle = ::open(path.c_str(), writable ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDONLY, 0644);
+    if (handle < 0) return false;
+    if (writable) {
+        if (ftruncate(handle, static_cast<off_t>(length)) != 0) {
+            ::close(handle);
+            return false;
+        }
+    } else {
+        struct stat info;
+        if (fstat(handle, &info) != 0 || info.st_size == 0) {  // mmap rejects empty files
+            ::close(handle);
+            return false;
+        }
+        length = static_cast<size_t>(info.st_size);
+    }
+    const int protection = mode == Mode::Read ? PROT_READ : (PROT_READ | PROT_WRITE);
+    void* view = mmap(nullptr, length, protection, mode == Mode::CopyOnWrite ? MAP_PRIVATE : MAP_SHARED, handle, 0);
+    if (view == MAP_FAILED) {
+        ::close(handle);
+        return false;
+    }
+    fd = handle;
+#endif
+    base = view;
+    bytes = length;
+    return true;
+}
+
+void MappedFile::close() {
+    if (!base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(mapping);
+    CloseHandle(file);
+    mapping = file = nullptr;
+#else
+    munmap(base, bytes);
+    ::close(fd);
+    fd = -1;
+#endif
+    base = nullptr;
+    bytes = 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// MMAP: Whole-file shared mapping (POSIX mmap / Win32 MapViewOfFile).
+// openRead() maps an existing file read-only; create() truncates or creates
+// `path`, sizes it to `bytes` and maps it read-write. openPrivate() maps an
+// existing file copy-on-write: writes go to private pages and never reach the
+// file, so many mappings of one file share every page they leave untouched.
+// All return false on failure and leave the object closed.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool openRead(const std::string& path);
+    bool openPrivate(const std::string& path);
+    bool create(const std::string& path, size_t bytes);
+    void close();
+
+    bool isOpen() const { return base != nullptr; }
+    const char* data() const { return static_cast<const char*>(base); }
+    char* data() { return static_cast<char*>(base); }
+    size_t size() const { return bytes; }
+
+private:
+    enum class Mode { Read, Create, CopyOnWrite };
+    bool map(const std::string& path, size_t length, Mode mode);
+
+    void* base = nullptr;
+    size_t bytes = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
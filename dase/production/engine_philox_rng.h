@@ -0,0 +1,87 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// NOISE: Philox4x32-10 counter-based generator (Salmon et al., SC'11). A sample is
+// a pure function of (seed, node, step, pass): there is no generator state to share
+// or advance, so any thread may produce any sample and the result never depends on
+// the schedule. One block call yields four 32-bit words, turned into four standard
+// normal samples by Box-Muller for four consecutive nodes. Engines key samples by
+// node ID, so a node draws the same noise under every storage layout.
+struct PhiloxBlock {
+    uint32_t word[4];
+};
+
+inline PhiloxBlock philox4x32(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3, uint64_t seed) {
+    uint32_t k0 = static_cast<uint32_t>(seed);
+    uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+    for (int round = 0; round < 10; round++) {
+        const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+        const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+        const uint32_t next0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        const uint32_t next2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c1 = static_cast<uint32_t>(p1);
+        c3 = static_cast<uint32_t>(p0);
+        c0 = next0;
+        c2 = next2;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    return {{c0, c1, c2, c3}};
+}
+
+// Four N(0, 1) samples for nodes 4 * group .. 4 * group + 3
+inline void philoxGaussian4(uint64_t seed, uint32_t group, uint64_t step, uint32_t pass, double* out) {
+    const PhiloxBlock bits = philox4x32(group, pass, static_cast<uint32_t>(step), static_cast<uint32_t>(step >> 32), seed);
+    constexpr double kTwoPi = 6.283185307179586476925;
+    constexpr double kUnit = 1.0 / 4294967296.0;
+    for (int pair = 0; pair < 2; pair++) {
+        const double u1 = (bits.word[2 * pair] + 0.5) * kUnit;       // (0, 1): log() never sees 0
+        const double u2 = bits.word[2 * pair + 1] * kUnit;
+        const double radius = std::sqrt(-2.0 * std::log(u1));
+        out[2 * pair] = radius * std::cos(kTwoPi * u2);
+        out[2 * pair + 1] = radius * std::sin(kTwoPi * u2);
+    }
+}
+
+// One N(0, 1) sample of `node`, equal to its lane of philoxGaussianLanes()
+inline double philoxGaussian(uint64_t seed, size_t node, uint64_t step, uint32_t pass) {
+    double group[4];
+    philoxGaussian4(seed, static_cast<uint32_t>(node / 4), step, pass, group);
+    return group[node % 4];
+}
+
+// SIMD: out[i] = level * N(0, 1) for nodes first .. first + count - 1, a whole lane
+// block per call. Lane blocks start on multiples of 4, so no sample is wasted.
+template <typename Scalar>
+inline void philoxGaussianLanes(uint64_t seed, uint64_t step, uint32_t pass, size_t first, size_t count,
+                                double level, Scalar* out) {
+    const size_t end = first + count;
+    double group[4];
+    for (size_t base = first / 4 * 4; base < end; base += 4) {
+        philoxGaussian4(seed, static_cast<uint32_t>(base / 4), step, pass, group);
+        for (size_t k = 0; k < 4; k++) {
+            const size_t node = base + k;
+            if (node >= first && node < end) out[node - first] = static_cast<Scalar>(level * group[k]);
+        }
+    }
+}
+
+// out[i] = level * N(0, 1) for nodes ids[0 .. count - 1], as philoxGaussian(); for
+// lanes of a curve layout, whose node IDs are not contiguous. Neighbouring lanes in
+// one group of four share a block call.
+template <typename Scalar>
+inline void philoxGaussianGather(uint64_t seed, uint64_t step, uint32_t pass, const uint32_t* ids, size_t count,
+                                 double level, Scalar* out) {
+    double group[4];
+    uint32_t cached = UINT32_MAX;
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t id = ids[i];
+        if (id / 4 != cached) {
+            cached = id / 4;
+            philoxGaussian4(seed, cached, step, pass, group);
+        }
+        out[i] = static_cast<Scalar>(level * group[id % 4]);
+    }
+}
@@ -0,0 +1,52 @@
+#include "engine_reduction.h"
+
+size_t reductionSegmentCount(size_t items, size_t max_segments) {
+    if (max_segments == 0) max_segments = 1;
+    return items < max_segments ? items : max_segments;
+}
+
+void reductionSegmentRange(size_t items, size_t segment_count, size_t segment, size_t& begin, size_t& end) {
+    const size_t base = items / segment_count;
+    const size_t extra = items % segment_count;
+    begin = segment * base + (segment < extra ? segment : extra);
+    end = begin + base + (segment < extra ? 1 : 0);
+}
+
+// Halves until 8 items remain, then adds them left to right: the tree only depends on count
+static double pairwiseSum(const double* values, size_t count, size_t stride) {
+    if (count <= 8) {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; i++) sum += values[i * stride];
+        return sum;
+    }
+    const size_t half = count / 2;
+    return pairwiseSum(values, half, stride) + pairwiseSum(values + half * stride, count - half, stride);
+}
+
+double reduceSum(const double* values, size_t count, ReductionMode mode, size_t stride) {
+    if (mode == ReductionMode::Pairwise) return pairwiseSum(values, count, stride);
+    ReductionPartial total;
+    for (size_t i = 0; i < count; i++) total.add(values[i * stride], mode);
+    return total.value();
+}
+
+double reducePartials(const double* sums, const double* compensations, size_t count, ReductionMode mode,
+                      size_t stride) {
+    if (count == 0) return 0.0;
+    if (mode == ReductionMode::Pairwise) return pairwiseSum(sums, count, stride);
+
+    // Kahan: compensated sum of the segment sums, plus every segment's lost bits
+    ReductionPartial total;
+    for (size_t i = 0; i < count; i++) {
+        total.add(sums[i * stride], mode);
+        total.compensation += compensations[i * stride];
+    }
+    return total.value();
+}
+
+double reducePartials(const ReductionPartial* partials, size_t count, ReductionMode mode) {
+    static_assert(sizeof(ReductionPartial) % sizeof(double) == 0, "partials must be a whole number of doubles");
+    const size_t stride = sizeof(ReductionPartial) / sizeof(double);
+    if (count == 0) return 0.0;
+    return reducePartials(&partials[0].sum, &partials[0].compensation, count, mode, stride);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// REDUCTION: Reproducible sums. Parallel reductions accumulate into a fixed number
+// of segments that depends only on the item count, never on the thread count or on
+// which worker ran which task. Each segment adds its items in index order, and the
+// segment partials are combined by a fixed-shape pairwise tree, so a result is
+// bit-identical for every run and every thread count.
+//   Pairwise  error grows with log2(n) instead of n
+//   Kahan     compensated (Neumaier) addition inside and across segments
+enum class ReductionMode : uint8_t { Pairwise = 0, Kahan = 1 };
+
+// Upper bound on segments per parallel reduction: enough tasks to balance many
+// cores, few enough that combining them stays negligible
+static constexpr size_t kReductionSegments = 256;
+
+// Running sum of one segment, alone on its cache line
+struct alignas(64) ReductionPartial {
+    double sum = 0.0;
+    double compensation = 0.0;     // Kahan: low-order bits lost by `sum`
+
+    void add(double value, ReductionMode mode) {
+        if (mode == ReductionMode::Kahan) {
+            const double next = sum + value;
+            // Neumaier: recover whichever operand lost its low-order bits
+            compensation += std::fabs(sum) >= std::fabs(value) ? (sum - next) + value : (value - next) + sum;
+            sum = next;
+        } else {
+            sum += value;
+        }
+    }
+    double value() const { return sum + compensation; }
+};
+
+// Segment count, and the item range [begin, end) of segment `segment`, for `items` items
+size_t reductionSegmentCount(size_t items, size_t max_segments = kReductionSegments);
+void reductionSegmentRange(size_t items, size_t segment_count, size_t segment, size_t& begin, size_t& end);
+
+// Fixed-order sum of values[0], values[stride], ... values[(count - 1) * stride]
+double reduceSum(const double* values, size_t count, ReductionMode mode = ReductionMode::Pairwise,
+                 size_t stride = 1);
+double reducePartials(const ReductionPartial* partials, size_t count, ReductionMode mode = ReductionMode::Pairwise);
+// The same over split rows: sums[i * stride], and for Kahan compensations[i * stride]
+double reducePartials(const double* sums, const double* compensations, size_t count, ReductionMode mode,
+                      size_t stride = 1);
@@ -0,0 +1,248 @@
+#include "engine_results_channel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+static const char kResultsMagic[8] = {'D', 'A', 'S', 'E', 'R', 'E', 'S', '1'};
+static const uint32_t kResultsVersion = 1;
+static const int kReadRetries = 64;
+
+static ResultsRecordInfo recordInfo(const ResultsRecordHeader& record) {
+    ResultsRecordInfo info;
+    info.frame = record.frame;
+    info.nodes_computed = record.nodes_computed;
+    info.time = record.time;
+    info.compute_ms = record.compute_ms;
+    info.timestamp_ns = record.timestamp_ns;
+    info.value_count = record.value_count;
+    info.flags = record.flags;
+    return info;
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+ResultsChannelWriter::~ResultsChannelWriter() {
+    close();
+}
+
+bool ResultsChannelWriter::create(const std::string& path, size_t value_capacity, size_t slot_count,
+                                  ResultsPrecision precision) {
+    close();
+    if (slot_count == 0 || value_capacity == 0 || value_capacity > UINT32_MAX || slot_count > UINT32_MAX) return false;
+    const size_t element_size = static_cast<size_t>(precision);
+    const size_t payload_bytes = (value_capacity * element_size + 63) / 64 * 64;
+    const size_t slot_bytes = sizeof(ResultsRecordHeader) + payload_bytes;
+    if (!map.create(path, sizeof(ResultsChannelHeader) + slot_count * slot_bytes)) return false;
+
+    // Fresh zero-filled file: fill in the geometry, publish the magic last
+    header = reinterpret_cast<ResultsChannelHeader*>(map.data());
+    header->version = kResultsVersion;
+    header->element_size = static_cast<uint32_t>(element_size);
+    header->slot_count = static_cast<uint32_t>(slot_count);
+    header->value_capacity = static_cast<uint32_t>(value_capacity);
+    header->slot_bytes = slot_bytes;
+    header->payload_offset = sizeof(ResultsChannelHeader);
+    header->published.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, kResultsMagic, sizeof(kResultsMagic));
+    return true;
+}
+
+void ResultsChannelWriter::close() {
+    map.close();
+    header = nullptr;
+    open_record = nullptr;
+}
+
+void* ResultsChannelWriter::beginRecord() {
+    if (!header) return nullptr;
+    open_index = header->published.load(std::memory_order_relaxed);
+    char* base = map.data() + header->payload_offset;
+    open_record = reinterpret_cast<ResultsRecordHeader*>(base + (open_index % header->slot_count) * header->slot_bytes);
+    // SEQLOCK: Odd sequence before touching the payload, readers of this slot back off
+    open_record->sequence.store(2 * open_index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return open_record + 1;
+}
+
+void ResultsChannelWriter::commitRecord(size_t count, const ResultsRecordInfo& info) {
+    if (!open_record) return;
+    open_record->frame = info.frame;
+    open_record->nodes_computed = info.nodes_computed;
+    open_record->time = info.time;
+    open_record->compute_ms = info.compute_ms;
+    open_record->timestamp_ns = info.timestamp_ns ? info.timestamp_ns
+        : static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::system_clock::now().time_since_epoch()).count());
+    open_record->value_count = static_cast<uint32_t>(std::min<size_t>(count, header->value_capacity));
+    open_record->flags = info.flags | (count > header->value_capacity ? kResultsTruncated : 0u);
+    open_record->sequence.store(2 * open_index + 2, std::memory_order_release);
+    header->published.store(open_index + 1, std::memory_order_release);
+    open_record = nullptr;
+}
+
+template <typename T>
+bool ResultsChannelWriter::publishValues(const T* values, size_t count, const ResultsRecordInfo& info) {
+    void* payload = beginRecord();
+    if (!payload) return false;
+    const size_t stored = std::min<size_t>(count, header->value_capacity);
+    if (header->element_size == sizeof(T)) {
+        std::memcpy(payload, values, stored * sizeof(T));
+    } else if (header->element_size == sizeof(float)) {
+        float* out = static_cast<float*>(payload);
+        for (size_t i = 0; i < stored; i++) out[i] = static_cast<float>(values[i]);
+    } else {
+        double* out = static_cast<double*>(payload);
+        for (size_t i = 0; i < stored; i++) out[i] = static_cast<double>(values[i]);
+    }
+    commitRecord(count, info);
+    return true;
+}
+
+bool ResultsChannelWriter::publish(const double* values, size_t count, const ResultsRecordInfo& info) {
+    return publishValues(values, count, info);
+}
+
+bool ResultsChannelWriter::publish(const float* values, size_t count, const ResultsRecordInfo& info) {
+    return publishValues(values, count, info);
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+ResultsChannelReader::~ResultsChannelReader() {
+    close();
+}
+
+bool ResultsChannelReader::open(const std::string& path) {
+    close();
+    if (!map.openRead(path)) return false;
+    const ResultsChannelHeader* candidate = reinterpret_cast<const ResultsChannelHeader*>(map.data());
+    const bool valid = map.size() >= sizeof(ResultsChannelHeader) &&
+                       std::memcmp(candidate->magic, kResultsMagic, sizeof(kResultsMagic)) == 0 &&
+                       candidate->version == kResultsVersion &&
+                       (candidate->element_size == 4 || candidate->element_size == 8) &&
+                       candidate->slot_count > 0 &&
+                       candidate->payload_offset + candidate->slot_count * candidate->slot_bytes <= map.size() &&
+                       sizeof(ResultsRecordHeader) + uint64_t(candidate->value_capacity) * candidate->element_size <= candidate->slot_bytes;
+    if (!valid) {
+        map.close();
+        return false;
+    }
+    header = candidate;
+    return true;
+}
+
+void ResultsChannelReader::close() {
+    map.close();
+    header = nullptr;
+}
+
+const ResultsRecordHeader* ResultsChannelReader::slot(uint64_t record) const {
+    const char* base = map.data() + header->payload_offset;
+    return reinterpret_cast<const ResultsRecordHeader*>(base + (record % header->slot_count) * header->slot_bytes);
+}
+
+bool ResultsChannelReader::read(uint64_t record, std::vector<double>& values, ResultsRecordInfo& info) const {
+    if (!header || record >= published()) return false;
+    const ResultsRecordHeader* entry = slot(record);
+    const uint64_t expected = 2 * record + 2;
+    for (int attempt = 0; attempt < kReadRetries; attempt++) {
+        const uint64_t before = entry->sequence.load(std::memory_order_acquire);
+        if (before != expected) {
+            if (before > expected) return false;  // Overwritten by a newer record
+            continue;                             // Still being written
+        }
+        info = recordInfo(*entry);
+        const size_t count = std::min<size_t>(info.value_count, header->value_capacity);
+        values.resize(count);
+        if (header->element_size == sizeof(double)) {
+            std::memcpy(values.data(), entry + 1, count * sizeof(double));
+        } else {
+            const float* payload = reinterpret_cast<const float*>(entry + 1);
+            for (size_t i = 0; i < count; i++) values[i] = payload[i];
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry->sequence.load(std::memory_order_relaxed) == expected) return true;
+    }
+    return false;
+}
+
+bool ResultsChannelReader::readLatest(std::vector<double>& values, ResultsRecordInfo& info) const {
+    for (int attempt = 0; attempt < kReadRetries; attempt++) {
+        const uint64_t count = published();
+        if (count == 0) return false;
+        if (read(count - 1, values, info)) return true;
+    }
+    return false;
+}
+
+bool ResultsChannelReader::latestView(View& view) const {
+    if (!header) return false;
+    for (int attempt = 0; attempt < kReadRetries; attempt++) {
+        const uint64_t count = published();
+        if (count == 0) return false;
+        const ResultsRecordHeader* entry = slot(count - 1);
+        const uint64_t expected = 2 * (count - 1) + 2;
+        if (entry->sequence.load(std::memory_order_acquire) != expected) continue;
+        view.data = entry + 1;
+        view.precision = precision();
+        view.info = recordInfo(*entry);
+        view.info.value_count = std::min<uint32_t>(view.info.value_count, header->value_capacity);
+        view.record = count - 1;
+        view.sequence = &entry->sequence;
+        view.expected = expected;
+        if (validate(view)) return true;
+    }
+    return false;
+}
+
+bool ResultsChannelReader::validate(const View& view) const {
+    if (!view.sequence) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return view.sequence->load(std::memory_order_relaxed) == view.expected;
+}
+
+// ============================================================================
+// JSON ADAPTER
+// ============================================================================
+
+static std::string spreadsheetCellName(size_t index) {
+    std::string column;
+    for (size_t n = index + 1; n > 0; n = (n - 1) / 26) {
+        column.insert(column.begin(), static_cast<char>('A' + (n - 1) % 26));
+    }
+    return column + "1";
+}
+
+std::string formatResultsJson(const std::vector<double>& values, const ResultsRecordInfo& info,
+                              const std::vector<std::string>& labels) {
+    std::ostringstream out;
+    out << std::setprecision(10) << "{\"cells\":{";
+    for (size_t i = 0; i < values.size(); i++) {
+        if (i > 0) out << ",";
+        out << "\"" << (i < labels.size() ? labels[i] : spreadsheetCellName(i)) << "\":{\"value\":" << values[i] << "}";
+    }
+    out << "},\"performance\":{\"execution_time_ms\":" << info.compute_ms
+        << ",\"nodes_computed\":" << info.nodes_computed
+        << ",\"frame\":" << info.frame
+        << ",\"timestamp\":\"" << info.timestamp_ns / 1000000000ull << "\"}}\n";
+    return out.str();
+}
+
+bool writeResultsJson(const ResultsChannelReader& reader, const std::string& path,
+                      const std::vector<std::string>& labels) {
+    std::vector<double> values;
+    ResultsRecordInfo info;
+    if (!reader.readLatest(values, info)) return false;
+    std::ofstream out(path);
+    if (!out) return false;
+    out << formatResultsJson(values, info, labels);
+    return static_cast<bool>(out);
+}
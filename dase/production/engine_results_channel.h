@@ -0,0 +1,149 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "engine_mapped_file.h"
+
+// RESULTS CHANNEL: Engine outputs published into a memory-mapped ring buffer.
+// One writer process fills records; any number of local readers (web server,
+// Python via numpy.memmap) map the same file and read without locks. Each slot
+// carries a seqlock sequence: odd while the writer is inside it, even once the
+// record is complete, so a reader retries instead of seeing a torn payload.
+//
+// File layout (native byte order, every block 64-byte aligned):
+//   [0, 128)                 ResultsChannelHeader
+//   128 + k * slot_bytes     slot k: ResultsRecordHeader (64 bytes), then
+//                            value_capacity float32 or float64 values
+// Record r lives in slot r % slot_count; its sequence is 2r + 1 while being
+// written and 2r + 2 when published. header.published counts finished records.
+
+enum class ResultsPrecision : uint32_t {
+    Float32 = 4,  // Element size in bytes
+    Float64 = 8
+};
+
+struct ResultsRecordInfo {
+    uint64_t frame = 0;           // Producer's frame / run counter
+    uint64_t nodes_computed = 0;
+    double time = 0.0;            // Simulation time of the record
+    double compute_ms = 0.0;      // Producer-side compute time
+    uint64_t timestamp_ns = 0;    // Wall clock (system_clock) at publish
+    uint32_t value_count = 0;
+    uint32_t flags = 0;
+};
+
+static constexpr uint32_t kResultsTruncated = 1u;  // More values were offered than value_capacity
+
+struct alignas(64) ResultsChannelHeader {
+    char magic[8];                // "DASERES1"
+    uint32_t version;
+    uint32_t element_size;        // 4 (float32) or 8 (float64)
+    uint32_t slot_count;
+    uint32_t value_capacity;
+    uint64_t slot_bytes;
+    uint64_t payload_offset;      // Offset of slot 0
+    alignas(64) std::atomic<uint64_t> published;
+};
+
+struct alignas(64) ResultsRecordHeader {
+    std::atomic<uint64_t> sequence;
+    uint64_t frame;
+    uint64_t nodes_computed;
+    double time;
+    double compute_ms;
+    uint64_t timestamp_ns;
+    uint32_t value_count;
+    uint32_t flags;
+};
+
+static_assert(sizeof(ResultsChannelHeader) == 128, "results channel header is part of the file format");
+static_assert(sizeof(ResultsRecordHeader) == 64, "results record header is part of the file format");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory seqlock needs lock-free 64-bit atomics");
+
+class ResultsChannelWriter {
+public:
+    ResultsChannelWriter() = default;
+    ~ResultsChannelWriter();
+    ResultsChannelWriter(const ResultsChannelWriter&) = delete;
+    ResultsChannelWriter& operator=(const ResultsChannelWriter&) = delete;
+
+    // Create (or truncate) `path` sized for `slot_count` records of up to
+    // `value_capacity` values. Returns false if the file cannot be mapped.
+    bool create(const std::string& path, size_t value_capacity, size_t slot_count = 4,
+                ResultsPrecision precision = ResultsPrecision::Float64);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // Copy `count` values into the next slot and publish it (values beyond the
+    // capacity are dropped and the record flagged kResultsTruncated)
+    bool publish(const double* values, size_t count, const ResultsRecordInfo& info);
+    bool publish(const float* values, size_t count, const ResultsRecordInfo& info);
+
+    // ZERO-COPY producer: fill the returned payload (float or double per
+    // precision(), capacity() entries) in place, then commitRecord()
+    void* beginRecord();
+    void commitRecord(size_t count, const ResultsRecordInfo& info);
+
+    ResultsPrecision precision() const { return static_cast<ResultsPrecision>(header ? header->element_size : 8); }
+    size_t capacity() const { return header ? header->value_capacity : 0; }
+    uint64_t published() const { return header ? header->published.load(std::memory_order_relaxed) : 0; }
+
+private:
+    template <typename T>
+    bool publishValues(const T* values, size_t count, const ResultsRecordInfo& info);
+
+    MappedFile map;
+    ResultsChannelHeader* header = nullptr;
+    ResultsRecordHeader* open_record = nullptr;  // Slot between beginRecord and commitRecord
+    uint64_t open_index = 0;
+};
+
+class ResultsChannelReader {
+public:
+    // In-place view of one record; the payload may be overwritten by the writer
+    // at any time, so check validate() after consuming it
+    struct View {
+        const void* data = nullptr;
+        ResultsPrecision precision = ResultsPrecision::Float64;
+        ResultsRecordInfo info;
+        uint64_t record = 0;
+        const std::atomic<uint64_t>* sequence = nullptr;
+        uint64_t expected = 0;
+    };
+
+    ResultsChannelReader() = default;
+    ~ResultsChannelReader();
+    ResultsChannelReader(const ResultsChannelReader&) = delete;
+    ResultsChannelReader& operator=(const ResultsChannelReader&) = delete;
+
+    bool open(const std::string& path);  // False for a missing or foreign file
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    uint64_t published() const { return header ? header->published.load(std::memory_order_acquire) : 0; }
+    size_t capacity() const { return header ? header->value_capacity : 0; }
+    ResultsPrecision precision() const { return static_cast<ResultsPrecision>(header ? header->element_size : 8); }
+
+    // Copy record `record` (or the newest one) as doubles. False if it was never
+    // published, has already been overwritten, or the writer kept lapping the reader.
+    bool read(uint64_t record, std::vector<double>& values, ResultsRecordInfo& info) const;
+    bool readLatest(std::vector<double>& values, ResultsRecordInfo& info) const;
+
+    bool latestView(View& view) const;
+    bool validate(const View& view) const;
+
+private:
+    MappedFile map;
+    const ResultsChannelHeader* header = nullptr;
+
+    const ResultsRecordHeader* slot(uint64_t record) const;
+};
+
+// JSON ADAPTER: web_results.json text for the file-based UI workflow.
+// Value i is reported as cell labels[i], or as A1, B1, C1, ... when labels are absent.
+std::string formatResultsJson(const std::vector<double>& values, const ResultsRecordInfo& info,
+                              const std::vector<std::string>& labels = std::vector<std::string>());
+bool writeResultsJson(const ResultsChannelReader& reader, const std::string& path,
+                      const std::vector<std::string>& labels = std::vector<std::string>());
@@ -0,0 +1,286 @@
+#include "engine_thread_pool.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#pragma comment(lib, "Synchronization.lib")
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+static inline void cpuRelax() { _mm_pause(); }
+#else
+static inline void cpuRelax() {}
+#endif
+
+// PARKING: Sleep until *address no longer holds `expected`
+static void futexWait(std::atomic<uint32_t>* address, uint32_t expected) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+    WaitOnAddress(reinterpret_cast<volatile VOID*>(address), &expected, sizeof(expected), INFINITE);
+#else
+    if (address->load() == expected) std::this_thread::yield();
+#endif
+}
+
+static void futexWakeAll(std::atomic<uint32_t>* address) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+    WakeByAddressAll(reinterpret_cast<PVOID>(address));
+#else
+    (void)address;
+#endif
+}
+
+void EngineStepBarrier::release(uint32_t next_sense) {
+    sense.store(next_sense, std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_seq_cst) > 0) {
+        futexWakeAll(&sense);
+    }
+}
+
+void EngineStepBarrier::wait(uint32_t expected_sense) {
+    uint32_t spins = 0;
+    for (;;) {
+        const uint32_t current = sense.load(std::memory_order_acquire);
+        if (current == expected_sense) return;
+        if (spins < spin_iterations) {
+            cpuRelax();
+            spins++;
+            continue;
+        }
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        if (sense.load(std::memory_order_seq_cst) != expected_sense) {
+            futexWait(&sense, current);
+        }
+        sleepers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+// Set while this thread is running a pool task, so nested dispatches run inline
+static thread_local bool tls_inside_task = false;
+
+bool EngineThreadPool::insideTask() {
+    return tls_inside_task;
+}
+
+// TOPOLOGY: Logical CPUs this process may use, grouped by physical core
+static std::vector<std::vector<int>> discoverCoreGroups() {
+    std::vector<std::vector<int>> groups;
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return groups;
+
+    std::map<std::pair<int, int>, std::vector<int>> cores;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) continue;
+        const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        int package = 0, core = cpu;
+        std::ifstream(base + "physical_package_id") >> package;
+        std::ifstream(base + "core_id") >> core;
+        cores[{package, core}].push_back(cpu);
+    }
+    for (auto& entry : cores) {
+        groups.push_back(std::move(entry.second));
+    }
+#elif defined(_WIN32)
+    DWORD length = 0;
+    GetLogicalProcessorInformation(nullptr, &length);
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (info.empty() || !GetLogicalProcessorInformation(info.data(), &length)) return groups;
+
+    DWORD_PTR process_mask = 0, system_mask = 0;
+    GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask);
+    for (const auto& entry : info) {
+        if (entry.Relationship != RelationProcessorCore) continue;
+        std::vector<int> siblings;
+        for (int cpu = 0; cpu < static_cast<int>(sizeof(ULONG_PTR) * 8); cpu++) {
+            const ULONG_PTR bit = static_cast<ULONG_PTR>(1) << cpu;
+            if ((entry.ProcessorMask & bit) && (process_mask & bit)) siblings.push_back(cpu);
+        }
+        if (!siblings.empty()) groups.push_back(std::move(siblings));
+    }
+#endif
+    return groups;
+}
+
+// Order in which workers claim logical CPUs for the requested affinity mode
+static std::vector<int> placementOrder(const std::vector<std::vector<int>>& groups, ThreadAffinity affinity) {
+    std::vector<int> order;
+    if (affinity == ThreadAffinity::SmtSiblings) {
+        for (const auto& core : groups) {
+            order.insert(order.end(), core.begin(), core.end());
+        }
+    } else {
+        // One sibling of every core first, then the second siblings, ...
+        size_t depth = 0;
+        for (const auto& core : groups) depth = std::max(depth, core.size());
+        for (size_t sibling = 0; sibling < depth; sibling++) {
+            for (const auto& core : groups) {
+                if (sibling < core.size()) order.push_back(core[sibling]);
+            }
+        }
+    }
+    return order;
+}
+
+static void pinThread(std::thread& thread, int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), static_cast<DWORD_PTR>(1) << cpu);
+#else
+    (void)thread;
+    (void)cpu;
+#endif
+}
+
+static size_t availableCpuCount() {
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        return static_cast<size_t>(CPU_COUNT(&allowed));
+    }
+#endif
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+size_t EngineThreadPool::getAvailableCpuCount() {
+    return availableCpuCount();
+}
+
+EngineThreadPool::EngineThreadPool(const AnalogEngineConfig& config)
+    : thread_count(config.num_threads ? config.num_threads : availableCpuCount()),
+      spin_iterations(config.spin_iterations) {
+
+    std::vector<int> order;
+    if (config.affinity != ThreadAffinity::None) {
+        order = placementOrder(discoverCoreGroups(), config.affinity);
+    }
+
+    // Worker 0 is the dispatching thread; slot 0 of the placement order is left to it
+    threads.reserve(thread_count - 1);
+    for (size_t worker = 1; worker < thread_count; worker++) {
+        threads.emplace_back(&EngineThreadPool::workerLoop, this, worker);
+        if (!order.empty()) {
+            pinThread(threads.back(), order[worker % order.size()]);
+        }
+    }
+}
+
+EngineThreadPool::~EngineThreadPool() {
+    stopping.store(true, std::memory_order_release);
+    generation.fetch_add(1, std::memory_order_seq_cst);
+    futexWakeAll(&generation);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void EngineThreadPool::dispatch(JobFn fn, void* context, size_t task_count, size_t chunk, size_t workers) {
+    job_fn = fn;
+    job_context = context;
+    job_tasks = task_count;
+    job_chunk = chunk;
+    job_workers = workers;
+    next_task.store(0, std::memory_order_relaxed);
+
+    // Single participant: no reason to wake anybody
+    if (workers <= 1 || threads.empty()) {
+        job_workers = 1;
+        tls_inside_task = true;
+        fn(*this, context, 0);
+        tls_inside_task = false;
+        return;
+    }
+
+    remaining_workers.store(static_cast<uint32_t>(threads.size()), std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping_workers.load(std::memory_order_seq_cst) > 0) {
+        futexWakeAll(&generation);
+    }
+
+    tls_inside_task = true;
+    fn(*this, context, 0);
+    tls_inside_task = false;
+
+    waitForWorkers();
+}
+
+void EngineThreadPool::waitForWorkers() {
+    uint32_t spins = 0;
+    for (;;) {
+        uint32_t remaining = remaining_workers.load(std::memory_order_acquire);
+        if (remaining == 0) return;
+        if (spins < spin_iterations) {
+            cpuRelax();
+            spins++;
+            continue;
+        }
+        dispatcher_parked.store(1, std::memory_order_seq_cst);
+        remaining = remaining_workers.load(std::memory_order_seq_cst);
+        if (remaining != 0) {
+            futexWait(&remaining_workers, remaining);
+        }
+        dispatcher_parked.store(0, std::memory_order_relaxed);
+    }
+}
+
+void EngineThreadPool::workerLoop(size_t worker_index) {
+    uint32_t seen = 0;
+    for (;;) {
+        // Spin first: back-to-back waves never touch the kernel
+        uint32_t spins = 0;
+        uint32_t current = generation.load(std::memory_order_acquire);
+        while (current == seen) {
+            if (spins < spin_iterations) {
+                cpuRelax();
+                spins++;
+            } else {
+                sleeping_workers.fetch_add(1, std::memory_order_seq_cst);
+                if (generation.load(std::memory_order_seq_cst) == seen) {
+                    futexWait(&generation, seen);
+                }
+                sleeping_workers.fetch_sub(1, std::memory_order_seq_cst);
+            }
+            current = generation.load(std::memory_order_acquire);
+        }
+        seen = current;
+
+        if (stopping.load(std::memory_order_acquire)) return;
+
+        if (worker_index < job_workers) {
+            tls_inside_task = true;
+            job_fn(*this, job_context, worker_index);
+            tls_inside_task = false;
+        }
+
+        // Every worker acknowledges, so job fields stay stable until all have read them
+        if (remaining_workers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (dispatcher_parked.load(std::memory_order_seq_cst)) {
+                futexWakeAll(&remaining_workers);
+            }
+        }
+    }
+}
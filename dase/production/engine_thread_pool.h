@@ -0,0 +1,170 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "engine_reduction.h"
+
+// CPU placement for engine worker threads
+enum class ThreadAffinity : uint8_t {
+    None = 0,        // Leave placement to the OS scheduler
+    Cores = 1,       // One worker per physical core, spread across cores first
+    SmtSiblings = 2  // Fill both SMT siblings of a core before moving to the next
+};
+
+// How the engine hands parallel work items to its workers
+enum class EngineSchedule : uint8_t {
+    Dynamic = 0,     // Workers grab `chunk` items at a time from a shared counter
+    Static = 1       // Each worker takes one contiguous slice, no shared counter
+};
+
+// Engine construction options
+struct AnalogEngineConfig {
+    size_t num_threads = 0;                         // 0 = every CPU this process may run on
+    ThreadAffinity affinity = ThreadAffinity::None;
+    uint32_t spin_iterations = 20000;               // Busy polls before a parked worker sleeps on a futex
+    bool perf_counters = false;                     // Instrumented builds: open perf_event counters per worker
+    size_t command_capacity = 1024;                 // Live commands that can wait for the next wave (postCommand)
+    ReductionMode reduction = ReductionMode::Pairwise;  // Output sums: pairwise, or Kahan-compensated
+    // TUNING: Work distribution, chosen per host and size by autotuneEngine() (engine_autotuner.h)
+    EngineSchedule schedule = EngineSchedule::Dynamic;
+    size_t chunk = 1;                               // Dynamic: work items per grab
+    size_t sequential_below = 0;                    // Engines with fewer nodes run every region on the calling thread
+};
+
+// STEP BARRIER: Sense-reversing barrier for workers that stay inside one dispatch
+// across many time steps. Arrival is one fetch_add; the last thread to arrive runs
+// the step's serial completion while the others wait, then flips the shared sense
+// to release them. Waiters spin briefly, then park on a futex like the pool.
+class EngineStepBarrier {
+public:
+    // Not while threads are waiting on it
+    void reset(size_t participant_count, uint32_t spin_budget) {
+        participants = static_cast<uint32_t>(participant_count ? participant_count : 1);
+        spin_iterations = spin_budget;
+        arrived.store(0, std::memory_order_relaxed);
+        sense.store(0, std::memory_order_relaxed);
+    }
+
+    // Each participant keeps its own `local_sense` (0 after reset) and calls this once
+    // per step; completion() runs on exactly one of them, after all have arrived
+    template <typename Fn>
+    void arriveAndWait(uint32_t& local_sense, Fn&& completion) {
+        local_sense ^= 1u;
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == participants) {
+            arrived.store(0, std::memory_order_relaxed);
+            completion();
+            release(local_sense);
+        } else {
+            wait(local_sense);
+        }
+    }
+
+private:
+    void release(uint32_t next_sense);
+    void wait(uint32_t expected_sense);
+
+    uint32_t participants = 1;
+    uint32_t spin_iterations = 0;
+    alignas(64) std::atomic<uint32_t> arrived{0};
+    alignas(64) std::atomic<uint32_t> sense{0};
+    std::atomic<uint32_t> sleepers{0};
+};
+
+// PERSISTENT WORKER POOL: Threads are created and pinned once per engine.
+// Between dispatches workers spin briefly, then park on a futex instead of
+// being torn down and re-forked. The calling thread always acts as worker 0.
+// Dispatch is not reentrant: a dispatch issued from inside a task runs inline.
+class EngineThreadPool {
+public:
+    explicit EngineThreadPool(const AnalogEngineConfig& config = AnalogEngineConfig());
+    ~EngineThreadPool();
+
+    EngineThreadPool(const EngineThreadPool&) = delete;
+    EngineThreadPool& operator=(const EngineThreadPool&) = delete;
+
+    size_t getThreadCount() const { return thread_count; }
+    // CPUs this process may run on (the default thread count)
+    static size_t getAvailableCpuCount();
+    // Workers a dispatch issued now would use (1 from inside a task, where it runs inline)
+    size_t getDispatchWidth() const { return insideTask() ? 1 : thread_count; }
+
+    // Dynamic scheduling: tasks [0, task_count) are handed out `chunk` at a time.
+    // fn(task_index, worker_index) must not throw.
+    template <typename Fn>
+    void parallelFor(size_t task_count, size_t chunk, Fn&& fn) {
+        if (task_count == 0) return;
+        if (chunk == 0) chunk = 1;
+        if (insideTask()) {
+            for (size_t task = 0; task < task_count; task++) fn(task, 0);
+            return;
+        }
+        const size_t chunks = (task_count + chunk - 1) / chunk;
+        dispatch(&invokeTasks<Fn>, &fn, task_count, chunk, chunks < thread_count ? chunks : thread_count);
+    }
+
+    // Static scheduling: fn(worker_index, worker_count) runs exactly once on every worker
+    template <typename Fn>
+    void runOnWorkers(Fn&& fn) {
+        if (insideTask()) {
+            fn(0, 1);
+            return;
+        }
+        dispatch(&invokeWorker<Fn>, &fn, 0, 0, thread_count);
+    }
+
+    // Contiguous static slice [begin, end) of `count` items for one worker
+    static void staticRange(size_t count, size_t worker_index, size_t worker_count, size_t& begin, size_t& end) {
+        const size_t base = count / worker_count;
+        const size_t extra = count % worker_count;
+        begin = worker_index * base + (worker_index < extra ? worker_index : extra);
+        end = begin + base + (worker_index < extra ? 1 : 0);
+    }
+
+private:
+    using JobFn = void (*)(EngineThreadPool& pool, void* context, size_t worker_index);
+
+    template <typename Fn>
+    static void invokeTasks(EngineThreadPool& pool, void* context, size_t worker_index) {
+        Fn& fn = *static_cast<typename std::remove_reference<Fn>::type*>(context);
+        for (;;) {
+            const size_t begin = pool.next_task.fetch_add(pool.job_chunk, std::memory_order_relaxed);
+            if (begin >= pool.job_tasks) break;
+            const size_t end = begin + pool.job_chunk < pool.job_tasks ? begin + pool.job_chunk : pool.job_tasks;
+            for (size_t task = begin; task < end; task++) {
+                fn(task, worker_index);
+            }
+        }
+    }
+
+    template <typename Fn>
+    static void invokeWorker(EngineThreadPool& pool, void* context, size_t worker_index) {
+        Fn& fn = *static_cast<typename std::remove_reference<Fn>::type*>(context);
+        fn(worker_index, pool.job_workers);
+    }
+
+    static bool insideTask();
+    void dispatch(JobFn fn, void* context, size_t task_count, size_t chunk, size_t workers);
+    void workerLoop(size_t worker_index);
+    void waitForWorkers();
+
+    size_t thread_count = 1;
+    uint32_t spin_iterations = 0;
+    std::vector<std::thread> threads;
+
+    // Current job (written by the dispatcher before the generation bump)
+    JobFn job_fn = nullptr;
+    void* job_context = nullptr;
+    size_t job_tasks = 0;
+    size_t job_chunk = 1;
+    size_t job_workers = 1;
+
+    alignas(64) std::atomic<size_t> next_task{0};
+    alignas(64) std::atomic<uint32_t> generation{0};
+    std::atomic<uint32_t> sleeping_workers{0};
+    alignas(64) std::atomic<uint32_t> remaining_workers{0};
+    std::atomic<uint32_t> dispatcher_parked{0};
+    std::atomic<bool> stopping{false};
+};
@@ -0,0 +1,133 @@
+#include "engine_trace_recorder.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+static const char kTraceMagic[8] = {'D', 'A', 'S', 'E', 'T', 'R', 'C', '1'};
+
+bool EngineTraceRecorder::configure(const EngineTraceConfig& config, const std::vector<uint32_t>& column_sources) {
+    if (config.nodes.empty() || config.decimation == 0 || config.capacity == 0 ||
+        column_sources.size() != config.nodes.size()) {
+        return false;
+    }
+    mode = config.mode;
+    decimation = config.decimation;
+    capacity = config.capacity;
+    node_ids = config.nodes;
+    sources = column_sources;
+
+    // Everything record() touches is sized here, once
+    const size_t columns = node_ids.size();
+    gather.assign(columns, 0.0);
+    steps.assign(capacity, 0);
+    mean.assign(columns * capacity, 0.0f);
+    const size_t envelope_cells = mode == TraceMode::Envelope ? columns * capacity : 0;
+    minimum.assign(envelope_cells, 0.0f);
+    maximum.assign(envelope_cells, 0.0f);
+    const size_t window_cells = mode == TraceMode::Envelope ? columns : 0;
+    window_sum.assign(window_cells, 0.0);
+    window_min.assign(window_cells, 0.0);
+    window_max.assign(window_cells, 0.0);
+    step = 0;
+    clear();
+    return true;
+}
+
+void EngineTraceRecorder::clear() {
+    head = 0;
+    frames = 0;
+    dropped = 0;
+    phase = 0;
+}
+
+void EngineTraceRecorder::recordColumns(const double* values) {
+    const size_t columns = node_ids.size();
+    if (mode == TraceMode::Envelope) {
+        if (phase == 0) {
+            std::copy(values, values + columns, window_sum.begin());
+            std::copy(values, values + columns, window_min.begin());
+            std::copy(values, values + columns, window_max.begin());
+        } else {
+            for (size_t c = 0; c < columns; c++) {
+                window_sum[c] += values[c];
+                window_min[c] = std::min(window_min[c], values[c]);
+                window_max[c] = std::max(window_max[c], values[c]);
+            }
+        }
+    }
+    step++;
+    if (++phase < decimation) return;
+    phase = 0;
+
+    // Full ring: the new frame takes the oldest frame's slot
+    size_t slot;
+    if (frames < capacity) {
+        slot = (head + frames) % capacity;
+        frames++;
+    } else {
+        slot = head;
+        head = (head + 1) % capacity;
+        dropped++;
+    }
+    steps[slot] = step - 1;
+    if (mode == TraceMode::Envelope) {
+        const double scale = 1.0 / decimation;
+        for (size_t c = 0; c < columns; c++) {
+            mean[c * capacity + slot] = static_cast<float>(window_sum[c] * scale);
+            minimum[c * capacity + slot] = static_cast<float>(window_min[c]);
+            maximum[c * capacity + slot] = static_cast<float>(window_max[c]);
+        }
+    } else {
+        for (size_t c = 0; c < columns; c++) {
+            mean[c * capacity + slot] = static_cast<float>(values[c]);
+        }
+    }
+}
+
+float EngineTraceRecorder::getMin(size_t frame, size_t column) const {
+    const std::vector<float>& column_data = mode == TraceMode::Envelope ? minimum : mean;
+    return column_data[column * capacity + ringIndex(frame)];
+}
+
+float EngineTraceRecorder::getMax(size_t frame, size_t column) const {
+    const std::vector<float>& column_data = mode == TraceMode::Envelope ? maximum : mean;
+    return column_data[column * capacity + ringIndex(frame)];
+}
+
+bool EngineTraceRecorder::flush(const std::string& path) {
+    if (frames == 0) return true;
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    if (!out) return false;
+
+    TraceChunkHeader header{};
+    std::memcpy(header.magic, kTraceMagic, sizeof(kTraceMagic));
+    header.version = 1;
+    header.mode = static_cast<uint32_t>(mode);
+    header.columns = static_cast<uint32_t>(node_ids.size());
+    header.decimation = decimation;
+    header.frames = frames;
+    header.dropped = dropped;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(node_ids.data()), node_ids.size() * sizeof(uint32_t));
+
+    // Oldest frame first: the ring is at most two contiguous runs per column
+    const size_t first_run = std::min(frames, capacity - head);
+    const size_t second_run = frames - first_run;
+    auto write_runs = [&](const auto* column) {
+        out.write(reinterpret_cast<const char*>(column + head), first_run * sizeof(*column));
+        out.write(reinterpret_cast<const char*>(column), second_run * sizeof(*column));
+    };
+    write_runs(steps.data());
+    for (const std::vector<float>* data : {&mean, &minimum, &maximum}) {
+        if (data->empty()) continue;
+        for (size_t c = 0; c < node_ids.size(); c++) {
+            write_runs(data->data() + c * capacity);
+        }
+    }
+    if (!out) return false;
+
+    head = 0;
+    frames = 0;
+    dropped = 0;
+    return true;
+}
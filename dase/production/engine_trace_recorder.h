@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// TRACE: Per-node output recorder for long runs. The engine hands it the traced
+// nodes' outputs once per step; every `decimation` steps close one frame. Frames
+// go to preallocated columnar ring buffers (one float column per node), so the
+// hot path never allocates and a full ring overwrites its oldest frames.
+//   Sample    the frame holds the outputs of the step that closed it
+//   Envelope  the frame holds min, max and mean of every step in it
+enum class TraceMode : uint8_t { Sample = 0, Envelope = 1 };
+
+struct EngineTraceConfig {
+    std::vector<uint32_t> nodes;   // Node IDs, one column each
+    uint32_t decimation = 1;       // Steps per frame
+    TraceMode mode = TraceMode::Sample;
+    size_t capacity = 4096;        // Frames kept between flushes
+};
+
+// Chunk written by flush(), native byte order, appended to the file
+//   TraceChunkHeader
+//   uint32_t node_ids[columns]
+//   uint64_t steps[frames]                 step index (since configure) that closed each frame
+//   float    mean[columns][frames]         Sample: the value
+//   float    minimum[columns][frames]      Envelope only
+//   float    maximum[columns][frames]      Envelope only
+struct TraceChunkHeader {
+    char magic[8];                 // "DASETRC1"
+    uint32_t version;
+    uint32_t mode;                 // TraceMode
+    uint32_t columns;
+    uint32_t decimation;
+    uint64_t frames;
+    uint64_t dropped;              // Frames overwritten before this flush
+};
+
+class EngineTraceRecorder {
+public:
+    // `sources[c]` is where column c's value is found in the output array passed to
+    // record(); the engine passes storage slots. False for an empty node list, a
+    // decimation or capacity of 0, or mismatched sizes.
+    bool configure(const EngineTraceConfig& config, const std::vector<uint32_t>& sources);
+
+    // One engine step: gathers the traced outputs only when the step contributes
+    template <typename Scalar>
+    void record(const Scalar* outputs) {
+        if (mode == TraceMode::Sample && phase + 1 < decimation) {
+            phase++;
+            step++;
+            return;
+        }
+        for (size_t c = 0; c < sources.size(); c++) {
+            gather[c] = static_cast<double>(outputs[sources[c]]);
+        }
+        recordColumns(gather.data());
+    }
+    // One engine step with the values already in column order
+    void recordColumns(const double* values);
+
+    // Append every retained frame to `path` as one chunk and empty the ring
+    bool flush(const std::string& path);
+    void clear();                  // Drop retained frames and any partial frame
+
+    size_t getColumnCount() const { return node_ids.size(); }
+    uint32_t getNodeId(size_t column) const { return node_ids[column]; }
+    uint32_t getSource(size_t column) const { return sources[column]; }
+    TraceMode getMode() const { return mode; }
+    size_t getFrameCount() const { return frames; }
+    uint64_t getDroppedFrames() const { return dropped; }
+    uint64_t getStepCount() const { return step; }   // Steps seen since configure()
+
+    // Frame 0 is the oldest retained one; min and max equal the value in Sample mode
+    uint64_t getFrameStep(size_t frame) const { return steps[ringIndex(frame)]; }
+    float getValue(size_t frame, size_t column) const { return mean[column * capacity + ringIndex(frame)]; }
+    float getMin(size_t frame, size_t column) const;
+    float getMax(size_t frame, size_t column) const;
+
+private:
+    TraceMode mode = TraceMode::Sample;
+    uint32_t decimation = 1;
+    size_t capacity = 0;
+    std::vector<uint32_t> node_ids;
+    std::vector<uint32_t> sources;
+    std::vector<double> gather;
+
+    // Ring: frame slot s of column c is column_array[c * capacity + s]
+    std::vector<uint64_t> steps;
+    std::vector<float> mean;
+    std::vector<float> minimum;    // Envelope only
+    std::vector<float> maximum;
+    size_t head = 0;               // Slot of the oldest frame
+    size_t frames = 0;
+    uint64_t dropped = 0;
+
+    // Frame being accumulated
+    std::vector<double> window_sum;
+    std::vector<double> window_min;
+    std::vector<double> window_max;
+    uint32_t phase = 0;
+    uint64_t step = 0;
+
+    size_t ringIndex(size_t frame) const { return (head + frame) % capacity; }
+};
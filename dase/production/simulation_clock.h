@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+
+// TIME BASE: Per-engine simulation clock.
+// Each engine owns one, so engines never share a time counter; advancing
+// by the default step reproduces the legacy `time_counter += 0.001` sequence.
+class SimulationClock {
+public:
+    explicit SimulationClock(double step = 0.001) : time_step(step) {}
+
+    double advance() { return advance(time_step); }
+    double advance(double dt) {
+        time += dt;
+        ticks++;
+        return time;
+    }
+    void reset(double start_time = 0.0) {
+        time = start_time;
+        ticks = 0;
+    }
+
+    // Resume a checkpointed clock exactly where it stopped
+    void restore(double start_time, uint64_t tick_count, double step) {
+        time = start_time;
+        ticks = tick_count;
+        time_step = step;
+    }
+
+    void setTimeStep(double step) { time_step = step; }
+    double getTimeStep() const { return time_step; }
+    double now() const { return time; }
+    uint64_t getTicks() const { return ticks; }
+
+private:
+    double time = 0.0;
+    double time_step = 0.001;
+    uint64_t ticks = 0;
+};
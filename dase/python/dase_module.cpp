@@ -0,0 +1,1160 @@
+// PYTHON: CPython extension module "dase" over the production engine.
+//
+//   import dase, numpy as np
+//   engine = dase.Engine(nodes=1000, precision="double", threads=0)
+//   out = engine.process_signal_block(np.sin(np.linspace(0, 6.28, 4096)))
+//   gains = np.asarray(engine.gains)          # Zero-copy view of the node state
+//
+// Engine wraps AnalogCellularEngineT in any of the three precisions ("double",
+// "float32", "mixed", as dase_bench --precision), Ensemble wraps EnsembleEngine and
+// Circuit builds the AnalogCircuitGraph both take. Sample buffers go in and out
+// through the buffer protocol, so NumPy arrays, array.array and memoryviews are used
+// in place; nothing is converted through Python floats or text. The module has no
+// build dependency beyond the Python headers.
+//
+// ZERO-COPY: engine.outputs, .integrator_state, .gains and .previous_input are
+// read-only memoryviews of the engine's SoA arrays, in storage slot order (node_slot()
+// maps node IDs to slots for Morton/Hilbert layouts). They read the live state: a
+// view taken before a run shows its results afterwards. While any view is alive,
+// load_snapshot() is refused because it replaces the arrays.
+//
+// GIL: Every call that steps the engine, saves or loads a snapshot, or runs an
+// ensemble releases the GIL for its duration, so other Python threads keep running
+// and several engines can run side by side. An engine or ensemble takes one call at
+// a time; a second thread entering it (including __init__, or a new state array view)
+// gets RuntimeError. Circuits are copied before the GIL is released, so editing one
+// never races a running call.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "analog_universal_node_engine.h"
+#include "analog_ensemble_engine.h"
+#include "analog_sheet_loader.h"
+
+// CPython stores method and getter callbacks under one generic pointer type; casting
+// through void (*)(void) is the form compilers accept without a function-type warning
+template <typename T, typename Fn>
+static T pyCallback(Fn fn) {
+    return reinterpret_cast<T>(reinterpret_cast<void (*)(void)>(fn));
+}
+
+static PyTypeObject* CircuitType = nullptr;
+static PyTypeObject* EngineType = nullptr;
+static PyTypeObject* StateArrayType = nullptr;
+static PyTypeObject* EnsembleType = nullptr;
+
+// ---- Buffers ----
+
+// C-contiguous float64 buffer of any shape, read as a flat array
+static bool getDoubleBuffer(PyObject* object, Py_buffer* view, bool writable, const char* name) {
+    const int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+    if (PyObject_GetBuffer(object, view, flags) != 0) {
+        PyErr_Clear();
+        PyErr_Format(PyExc_TypeError, "%s must be a C-contiguous%s float64 buffer", name, writable ? " writable" : "");
+        return false;
+    }
+    const char* format = view->format ? view->format : "B";
+    if (format[0] == '@' || format[0] == '=' || (format[0] == '<' && PY_LITTLE_ENDIAN)) format++;
+    if (std::strcmp(format, "d") != 0 || view->itemsize != sizeof(double)) {
+        PyBuffer_Release(view);
+        PyErr_Format(PyExc_TypeError, "%s must hold float64 values (format 'd'), not '%s'", name,
+                     view->format ? view->format : "B");
+        return false;
+    }
+    return true;
+}
+
+static size_t doubleCount(const Py_buffer& view) { return static_cast<size_t>(view.len) / sizeof(double); }
+
+// Fresh float64 memoryview of `count` entries backed by a bytearray
+static PyObject* newDoubleArray(size_t count, double** data) {
+    PyObject* bytes = PyByteArray_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(count * sizeof(double)));
+    if (!bytes) return nullptr;
+    *data = reinterpret_cast<double*>(PyByteArray_AS_STRING(bytes));
+    PyObject* raw = PyMemoryView_FromObject(bytes);
+    Py_DECREF(bytes);
+    if (!raw) return nullptr;
+    PyObject* typed = PyObject_CallMethod(raw, "cast", "s", "d");
+    Py_DECREF(raw);
+    return typed;
+}
+
+// Caller's `out` buffer of exactly `count` doubles, or a new array when out is None
+static PyObject* outputArray(PyObject* out, size_t count, Py_buffer* view, double** data) {
+    if (!out || out == Py_None) {
+        view->obj = nullptr;
+        return newDoubleArray(count, data);
+    }
+    if (!getDoubleBuffer(out, view, true, "out")) return nullptr;
+    if (doubleCount(*view) != count) {
+        PyBuffer_Release(view);
+        PyErr_Format(PyExc_ValueError, "out must have %zu entries", count);
+        return nullptr;
+    }
+    *data = static_cast<double*>(view->buf);
+    Py_INCREF(out);
+    return out;
+}
+
+static void releaseBuffer(Py_buffer* view) {
+    if (view->obj) PyBuffer_Release(view);
+}
+
+// True when two acquired buffers share any byte (e.g. out= passed the inputs back)
+static bool buffersOverlap(const Py_buffer& a, const Py_buffer& b) {
+    if (!a.obj || !b.obj || a.len == 0 || b.len == 0) return false;
+    const uintptr_t a_begin = reinterpret_cast<uintptr_t>(a.buf);
+    const uintptr_t b_begin = reinterpret_cast<uintptr_t>(b.buf);
+    return a_begin < b_begin + static_cast<uintptr_t>(b.len) && b_begin < a_begin + static_cast<uintptr_t>(a.len);
+}
+
+// ---- Circuit ----
+//
+// Circuits stay mutable Python objects, so every binding that hands one to the
+// engine copies the graph while it still holds the GIL.
+
+struct CircuitObject {
+    PyObject_HEAD
+    AnalogCircuitGraph* graph;
+    std::vector<std::string>* labels;   // Cell IDs when loaded from a sheet
+};
+
+static bool checkCircuit(CircuitObject* self) {
+    if (self->graph) return true;
+    PyErr_SetString(PyExc_RuntimeError, "Circuit is not initialized");
+    return false;
+}
+
+static int circuitInit(CircuitObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"nodes", nullptr};
+    Py_ssize_t nodes = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n", const_cast<char**>(kwlist), &nodes)) return -1;
+    if (nodes <= 0 || static_cast<uint64_t>(nodes) > UINT32_MAX) {
+        PyErr_SetString(PyExc_ValueError, "nodes must be between 1 and 2^32 - 1");
+        return -1;
+    }
+    delete self->graph;
+    delete self->labels;
+    self->labels = nullptr;
+    self->graph = new AnalogCircuitGraph(static_cast<size_t>(nodes));
+    return 0;
+}
+
+static void circuitDealloc(CircuitObject* self) {
+    delete self->graph;
+    delete self->labels;
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+static PyObject* circuitConnectImpl(CircuitObject* self, PyObject* args, PyObject* kwargs, bool delayed) {
+    static const char* kwlist[] = {"source", "target", "weight", nullptr};
+    unsigned int source = 0, target = 0;
+    double weight = 1.0;
+    if (!checkCircuit(self) ||
+        !PyArg_ParseTupleAndKeywords(args, kwargs, "II|d", const_cast<char**>(kwlist), &source, &target, &weight)) {
+        return nullptr;
+    }
+    const bool connected = delayed ? self->graph->connectDelayed(source, target, weight)
+                                   : self->graph->connect(source, target, weight);
+    if (!connected) {
+        PyErr_SetString(PyExc_ValueError, "node index out of range");
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* circuitConnect(CircuitObject* self, PyObject* args, PyObject* kwargs) {
+    return circuitConnectImpl(self, args, kwargs, false);
+}
+
+static PyObject* circuitConnectDelayed(CircuitObject* self, PyObject* args, PyObject* kwargs) {
+    return circuitConnectImpl(self, args, kwargs, true);
+}
+
+static PyObject* circuitSetControl(CircuitObject* self, PyObject* args) {
+    unsigned int node = 0;
+    double control = 0.0;
+    if (!checkCircuit(self) || !PyArg_ParseTuple(args, "Id", &node, &control)) return nullptr;
+    if (!self->graph->setControl(node, control)) {
+        PyErr_SetString(PyExc_ValueError, "node index out of range");
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* circuitSetExternalInput(CircuitObject* self, PyObject* args) {
+    unsigned int node = 0;
+    double gain = 1.0;
+    if (!checkCircuit(self) || !PyArg_ParseTuple(args, "I|d", &node, &gain)) return nullptr;
+    if (!self->graph->setExternalInput(node, gain)) {
+        PyErr_SetString(PyExc_ValueError, "node index out of range");
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+// Circuit.load_sheet(path): spreadsheet export of the UI, as webserver --circuit
+static PyObject* circuitLoadSheet(PyObject* type, PyObject* args) {
+    const char* path = nullptr;
+    if (!PyArg_ParseTuple(args, "s", &path)) return nullptr;
+    SheetCircuit sheet;
+    std::string error;
+    bool loaded = false;
+    Py_BEGIN_ALLOW_THREADS
+    loaded = loadSheetCircuit(path, sheet, &error);
+    Py_END_ALLOW_THREADS
+    if (!loaded) {
+        PyErr_Format(PyExc_ValueError, "%s: %s", path, error.c_str());
+        return nullptr;
+    }
+    CircuitObject* circuit = reinterpret_cast<CircuitObject*>(PyType_GenericAlloc(reinterpret_cast<PyTypeObject*>(type), 0));
+    if (!circuit) return nullptr;
+    circuit->graph = new AnalogCircuitGraph(std::move(sheet.graph));
+    circuit->labels = new std::vector<std::string>();
+    for (size_t node = 0; node < circuit->graph->getNodeCount(); node++) circuit->labels->push_back(sheet.label(node));
+    return reinterpret_cast<PyObject*>(circuit);
+}
+
+static PyObject* circuitGetNodeCount(CircuitObject* self, void*) {
+    if (!checkCircuit(self)) return nullptr;
+    return PyLong_FromSize_t(self->graph->getNodeCount());
+}
+
+static PyObject* circuitGetEdgeCount(CircuitObject* self, void*) {
+    if (!checkCircuit(self)) return nullptr;
+    return PyLong_FromSize_t(self->graph->getEdgeCount());
+}
+
+static PyObject* circuitGetLabels(CircuitObject* self, void*) {
+    if (!self->labels) Py_RETURN_NONE;
+    PyObject* list = PyList_New(static_cast<Py_ssize_t>(self->labels->size()));
+    if (!list) return nullptr;
+    for (size_t i = 0; i < self->labels->size(); i++) {
+        PyObject* label = PyUnicode_FromStringAndSize((*self->labels)[i].data(),
+                                                      static_cast<Py_ssize_t>((*self->labels)[i].size()));
+        if (!label) {
+            Py_DECREF(list);
+            return nullptr;
+        }
+        PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i), label);
+    }
+    return list;
+}
+
+static PyMethodDef circuitMethods[] = {
+    {"connect", pyCallback<PyCFunction>(circuitConnect),
+     METH_VARARGS | METH_KEYWORDS, "connect(source, target, weight=1.0): algebraic edge"},
+    {"connect_delayed", pyCallback<PyCFunction>(circuitConnectDelayed),
+     METH_VARARGS | METH_KEYWORDS, "connect_delayed(source, target, weight=1.0): edge read one step late"},
+    {"set_control", pyCallback<PyCFunction>(circuitSetControl), METH_VARARGS,
+     "set_control(node, control): node mode, as processSignal's control_signal"},
+    {"set_external_input", pyCallback<PyCFunction>(circuitSetExternalInput), METH_VARARGS,
+     "set_external_input(node, gain=1.0): share of the external input fed to node"},
+    {"load_sheet", circuitLoadSheet, METH_VARARGS | METH_CLASS,
+     "load_sheet(path): Circuit from a UI spreadsheet export (engine_input.json)"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyGetSetDef circuitGetSet[] = {
+    {"node_count", pyCallback<getter>(circuitGetNodeCount), nullptr, "Nodes in the netlist", nullptr},
+    {"edge_count", pyCallback<getter>(circuitGetEdgeCount), nullptr, "Edges in the netlist", nullptr},
+    {"labels", pyCallback<getter>(circuitGetLabels), nullptr, "Cell ID of every node (sheets only, else None)",
+     nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+static PyType_Slot circuitSlots[] = {
+    {Py_tp_doc, const_cast<char*>("Circuit(nodes): netlist builder for Engine.set_circuit and Ensemble")},
+    {Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew)},
+    {Py_tp_init, reinterpret_cast<void*>(circuitInit)},
+    {Py_tp_dealloc, reinterpret_cast<void*>(circuitDealloc)},
+    {Py_tp_methods, circuitMethods},
+    {Py_tp_getset, circuitGetSet},
+    {0, nullptr}
+};
+
+static PyType_Spec circuitSpec = {"dase.Circuit", sizeof(CircuitObject), 0, Py_TPFLAGS_DEFAULT, circuitSlots};
+
+// ---- Engine ----
+
+struct EngineObject {
+    PyObject_HEAD
+    // Exactly one is set once initialized
+    AnalogCellularEngine* f64;
+    AnalogCellularEngineF32* f32;
+    AnalogCellularEngineMixed* mixed;
+    Py_ssize_t exports;      // Live buffer views of the state arrays
+    bool busy;               // A call is running with the GIL released
+};
+
+template <typename Fn>
+static auto withEngine(EngineObject* self, Fn&& fn) {
+    if (self->f64) return fn(*self->f64);
+    if (self->f32) return fn(*self->f32);
+    return fn(*self->mixed);
+}
+
+static bool engineReady(EngineObject* self) {
+    if (self->f64 || self->f32 || self->mixed) return true;
+    PyErr_SetString(PyExc_RuntimeError, "Engine is not initialized");
+    return false;
+}
+
+// Ready and not inside another thread's call
+static bool checkEngine(EngineObject* self) {
+    if (!engineReady(self)) return false;
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "Engine is running a call in another thread");
+        return false;
+    }
+    return true;
+}
+
+// Holds an engine or ensemble busy from its checks to the end of the call. Buffer
+// exports and array allocation can run Python code, so the GIL may change hands
+// well before the engine itself is released; another thread's __init__ then
+// sees busy instead of deleting the object in use.
+struct BusyScope {
+    bool& flag;
+    explicit BusyScope(bool& busy) : flag(busy) { flag = true; }
+    ~BusyScope() { flag = false; }
+    BusyScope(const BusyScope&) = delete;
+    BusyScope& operator=(const BusyScope&) = delete;
+};
+
+static void releaseEngine(EngineObject* self) {
+    delete self->f64;
+    delete self->f32;
+    delete self->mixed;
+    self->f64 = nullptr;
+    self->f32 = nullptr;
+    self->mixed = nullptr;
+}
+
+static int engineInit(EngineObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"nodes", "precision", "threads", nullptr};
+    Py_ssize_t nodes = 100;
+    const char* precision = "double";
+    Py_ssize_t threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|nsn", const_cast<char**>(kwlist), &nodes, &precision,
+                                     &threads)) {
+        return -1;
+    }
+    if (nodes <= 0 || threads < 0) {
+        PyErr_SetString(PyExc_ValueError, "nodes must be positive and threads non-negative");
+        return -1;
+    }
+    const std::string name = precision;
+    if (name != "double" && name != "float32" && name != "mixed") {
+        PyErr_Format(PyExc_ValueError, "precision must be 'double', 'float32' or 'mixed', not '%s'", precision);
+        return -1;
+    }
+    if (self->busy || self->exports) {
+        PyErr_SetString(PyExc_RuntimeError, "Engine is in use");
+        return -1;
+    }
+    BusyScope busy(self->busy);
+    releaseEngine(self);
+    AnalogEngineConfig config;
+    config.num_threads = static_cast<size_t>(threads);
+    const size_t count = static_cast<size_t>(nodes);
+    Py_BEGIN_ALLOW_THREADS
+    if (name == "double") {
+        self->f64 = new AnalogCellularEngine(count, config);
+    } else if (name == "float32") {
+        self->f32 = new AnalogCellularEngineF32(count, config);
+    } else {
+        self->mixed = new AnalogCellularEngineMixed(count, config);
+    }
+    Py_END_ALLOW_THREADS
+    return 0;
+}
+
+static void engineDealloc(EngineObject* self) {
+    releaseEngine(self);
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+// Runs fn(engine) with the GIL released; the caller holds a BusyScope
+template <typename Fn>
+static void runUnlocked(EngineObject* self, Fn&& fn) {
+    Py_BEGIN_ALLOW_THREADS
+    withEngine(self, fn);
+    Py_END_ALLOW_THREADS
+}
+
+static PyObject* engineProcessSignalWave(EngineObject* self, PyObject* args) {
+    double input = 0.0, control = 0.0;
+    if (!PyArg_ParseTuple(args, "d|d", &input, &control) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    double result = 0.0;
+    runUnlocked(self, [&](auto& engine) { result = engine.processSignalWave(input, control); });
+    return PyFloat_FromDouble(result);
+}
+
+static PyObject* engineProcessSignalBlock(EngineObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"inputs", "controls", "out", nullptr};
+    PyObject* inputs_object = nullptr;
+    PyObject* controls_object = Py_None;
+    PyObject* out_object = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OO", const_cast<char**>(kwlist), &inputs_object,
+                                     &controls_object, &out_object) ||
+        !checkEngine(self)) {
+        return nullptr;
+    }
+    BusyScope busy(self->busy);
+    Py_buffer inputs, controls, out;
+    controls.obj = nullptr;
+    if (!getDoubleBuffer(inputs_object, &inputs, false, "inputs")) return nullptr;
+    const size_t n = doubleCount(inputs);
+    if (controls_object != Py_None) {
+        if (!getDoubleBuffer(controls_object, &controls, false, "controls")) {
+            PyBuffer_Release(&inputs);
+            return nullptr;
+        }
+        if (doubleCount(controls) != n) {
+            PyBuffer_Release(&inputs);
+            PyBuffer_Release(&controls);
+            PyErr_SetString(PyExc_ValueError, "controls must have as many entries as inputs");
+            return nullptr;
+        }
+    }
+    double* outputs = nullptr;
+    PyObject* result = outputArray(out_object, n, &out, &outputs);
+    // The block clears its outputs before reading any input, so they must not alias
+    if (result && (buffersOverlap(out, inputs) || buffersOverlap(out, controls))) {
+        PyErr_SetString(PyExc_ValueError, "out must not overlap inputs or controls");
+        releaseBuffer(&out);
+        Py_CLEAR(result);
+    }
+    if (result) {
+        const double* input_data = static_cast<const double*>(inputs.buf);
+        const double* control_data = controls.obj ? static_cast<const double*>(controls.buf) : nullptr;
+        runUnlocked(self, [&](auto& engine) { engine.processSignalBlock(input_data, control_data, n, outputs); });
+        releaseBuffer(&out);
+    }
+    PyBuffer_Release(&inputs);
+    releaseBuffer(&controls);
+    return result;
+}
+
+static PyObject* enginePerformSignalSweep(EngineObject* self, PyObject* args) {
+    double base_frequency = 0.0;
+    if (!PyArg_ParseTuple(args, "d", &base_frequency) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    runUnlocked(self, [&](auto& engine) { engine.performSignalSweep(base_frequency); });
+    Py_RETURN_NONE;
+}
+
+// perform_signal_sweep_block and run_steps: same arguments, one output per step
+template <bool kFused>
+static PyObject* engineSweepSteps(EngineObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"base_frequency", "steps", "out", nullptr};
+    double base_frequency = 0.0;
+    Py_ssize_t steps = 0;
+    PyObject* out_object = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "dn|O", const_cast<char**>(kwlist), &base_frequency, &steps,
+                                     &out_object) ||
+        !checkEngine(self)) {
+        return nullptr;
+    }
+    BusyScope busy(self->busy);
+    if (steps < 0) {
+        PyErr_SetString(PyExc_ValueError, "steps must be non-negative");
+        return nullptr;
+    }
+    const size_t count = static_cast<size_t>(steps);
+    Py_buffer out;
+    double* outputs = nullptr;
+    PyObject* result = outputArray(out_object, count, &out, &outputs);
+    if (!result) return nullptr;
+    runUnlocked(self, [&](auto& engine) {
+        if (kFused) {
+            engine.runSteps(count, base_frequency, outputs);
+        } else {
+            engine.performSignalSweepBlock(base_frequency, count, outputs);
+        }
+    });
+    releaseBuffer(&out);
+    return result;
+}
+
+static PyObject* engineSetCircuit(EngineObject* self, PyObject* args) {
+    PyObject* object = nullptr;
+    if (!PyArg_ParseTuple(args, "O!", CircuitType, &object) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    CircuitObject* circuit = reinterpret_cast<CircuitObject*>(object);
+    if (!checkCircuit(circuit)) return nullptr;
+    AnalogCircuitGraph graph = *circuit->graph;
+    bool applied = false;
+    runUnlocked(self, [&](auto& engine) { applied = engine.setCircuit(std::move(graph)); });
+    if (!applied) {
+        PyErr_SetString(PyExc_ValueError, "circuit node count does not match the engine");
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* engineClearCircuit(EngineObject* self, PyObject*) {
+    if (!checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    withEngine(self, [](auto& engine) { engine.clearCircuit(); });
+    Py_RETURN_NONE;
+}
+
+static PyObject* engineProcessCircuitStep(EngineObject* self, PyObject* args) {
+    double input = 0.0;
+    if (!PyArg_ParseTuple(args, "d", &input) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    bool has_circuit = false;
+    withEngine(self, [&](auto& engine) { has_circuit = engine.hasCircuit(); });
+    if (!has_circuit) {
+        PyErr_SetString(PyExc_RuntimeError, "no circuit set");
+        return nullptr;
+    }
+    double result = 0.0;
+    runUnlocked(self, [&](auto& engine) { result = engine.processCircuitStep(input); });
+    return PyFloat_FromDouble(result);
+}
+
+static PyObject* engineSetEventDriven(EngineObject* self, PyObject* args) {
+    int enabled = 0;
+    double tolerance = 1.0e-9;
+    if (!PyArg_ParseTuple(args, "p|d", &enabled, &tolerance) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    withEngine(self, [&](auto& engine) { engine.setEventDriven(enabled != 0, tolerance); });
+    Py_RETURN_NONE;
+}
+
+static PyObject* engineSetSystemFeedback(EngineObject* self, PyObject* args) {
+    double level = 0.0;
+    if (!PyArg_ParseTuple(args, "d", &level) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    withEngine(self, [&](auto& engine) { engine.setSystemFeedback(level); });
+    Py_RETURN_NONE;
+}
+
+static PyObject* engineSetNoise(EngineObject* self, PyObject* args) {
+    double level = 0.0;
+    unsigned long long seed = 0;
+    if (!PyArg_ParseTuple(args, "d|K", &level, &seed) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    withEngine(self, [&](auto& engine) { engine.setNoise(level, seed); });
+    Py_RETURN_NONE;
+}
+
+static PyObject* engineSetTimeStep(EngineObject* self, PyObject* args) {
+    double dt = 0.0;
+    if (!PyArg_ParseTuple(args, "d", &dt) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    withEngine(self, [&](auto& engine) { engine.setTimeStep(dt); });
+    Py_RETURN_NONE;
+}
+
+static PyObject* engineResetAllIntegrators(EngineObject* self, PyObject*) {
+    if (!checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    withEngine(self, [](auto& engine) { engine.resetAllIntegrators(); });
+    Py_RETURN_NONE;
+}
+
+static PyObject* engineSaveSnapshot(EngineObject* self, PyObject* args) {
+    const char* path = nullptr;
+    if (!PyArg_ParseTuple(args, "s", &path) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    bool saved = false;
+    runUnlocked(self, [&](auto& engine) { saved = engine.saveSnapshot(path); });
+    if (!saved) return PyErr_Format(PyExc_OSError, "cannot write snapshot %s", path);
+    Py_RETURN_NONE;
+}
+
+static PyObject* engineLoadSnapshot(EngineObject* self, PyObject* args) {
+    const char* path = nullptr;
+    if (!PyArg_ParseTuple(args, "s", &path) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    if (self->exports) {
+        PyErr_SetString(PyExc_BufferError, "cannot load a snapshot while state array views are alive");
+        return nullptr;
+    }
+    bool loaded = false;
+    runUnlocked(self, [&](auto& engine) { loaded = engine.loadSnapshot(path); });
+    if (!loaded) return PyErr_Format(PyExc_OSError, "cannot load snapshot %s for this engine", path);
+    Py_RETURN_NONE;
+}
+
+static PyObject* engineNodeSlot(EngineObject* self, PyObject* args) {
+    unsigned int node = 0;
+    if (!PyArg_ParseTuple(args, "I", &node) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    size_t count = 0;
+    withEngine(self, [&](auto& engine) { count = engine.getNodeCount(); });
+    if (node >= count) {
+        PyErr_SetString(PyExc_IndexError, "node ID out of range");
+        return nullptr;
+    }
+    uint32_t slot = 0;
+    withEngine(self, [&](auto& engine) { slot = engine.getNodeSlot(node); });
+    return PyLong_FromUnsignedLong(slot);
+}
+
+static PyObject* engineNodeId(EngineObject* self, PyObject* args) {
+    Py_ssize_t slot = 0;
+    if (!PyArg_ParseTuple(args, "n", &slot) || !checkEngine(self)) return nullptr;
+    BusyScope busy(self->busy);
+    size_t count = 0;
+    withEngine(self, [&](auto& engine) { count = engine.getNodeCount(); });
+    if (slot < 0 || static_cast<size_t>(slot) >= count) {
+        PyErr_SetString(PyExc_IndexError, "slot out of range");
+        return nullptr;
+    }
+    uint32_t node = 0;
+    withEngine(self, [&](auto& engine) { node = engine.getNodeId(static_cast<size_t>(slot)); });
+    return PyLong_FromUnsignedLong(node);
+}
+
+// ---- Engine state arrays ----
+
+enum class StateField : int { Outputs, IntegratorState, Gains, PreviousInput };
+
+// Exporter for one SoA array; memoryviews over it keep the engine alive
+struct StateArrayObject {
+    PyObject_HEAD
+    EngineObject* engine;
+    StateField field;
+    Py_ssize_t shape;
+    Py_ssize_t stride;
+};
+
+template <typename T>
+static const char* bufferFormat(const T*) { return sizeof(T) == sizeof(double) ? "d" : "f"; }
+
+template <typename Storage>
+static const void* stateFieldData(const Storage& storage, StateField field, const char** format, size_t* itemsize) {
+    switch (field) {
+    case StateField::IntegratorState:
+        *format = bufferFormat(storage.integrator_state);
+        *itemsize = sizeof(*storage.integrator_state);
+        return storage.integrator_state;
+    case StateField::Gains:
+        *format = bufferFormat(storage.feedback_gain);
+        *itemsize = sizeof(*storage.feedback_gain);
+        return storage.feedback_gain;
+    case StateField::PreviousInput:
+        *format = bufferFormat(storage.previous_input);
+        *itemsize = sizeof(*storage.previous_input);
+        return storage.previous_input;
+    case StateField::Outputs:
+    default:
+        *format = bufferFormat(storage.current_output);
+        *itemsize = sizeof(*storage.current_output);
+        return storage.current_output;
+    }
+}
+
+static int stateArrayGetBuffer(StateArrayObject* self, Py_buffer* view, int flags) {
+    if (flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "engine state arrays are read-only");
+        return -1;
+    }
+    // A running call may be moving the arrays (load_snapshot) or rebuilding the engine
+    if (!checkEngine(self->engine)) return -1;
+    // Pointers and shape are read per export: load_snapshot() or a second __init__
+    // may have moved or resized the arrays since
+    const char* format = nullptr;
+    size_t itemsize = 0;
+    const void* data = withEngine(self->engine, [&](auto& engine) {
+        self->shape = static_cast<Py_ssize_t>(engine.getNodeCount());
+        return stateFieldData(engine.getNodeStorage(), self->field, &format, &itemsize);
+    });
+    self->stride = static_cast<Py_ssize_t>(itemsize);
+    view->buf = const_cast<void*>(data);
+    view->obj = reinterpret_cast<PyObject*>(self);
+    Py_INCREF(self);
+    view->itemsize = static_cast<Py_ssize_t>(itemsize);
+    view->len = self->shape * self->stride;
+    view->readonly = 1;
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(format) : nullptr;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? &self->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &self->stride : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    self->engine->exports++;
+    return 0;
+}
+
+static void stateArrayReleaseBuffer(StateArrayObject* self, Py_buffer*) { self->engine->exports--; }
+
+static void stateArrayDealloc(StateArrayObject* self) {
+    Py_XDECREF(self->engine);
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+static PyType_Slot stateArraySlots[] = {
+    {Py_tp_doc, const_cast<char*>("Buffer exporter for one engine state array")},
+    {Py_tp_dealloc, reinterpret_cast<void*>(stateArrayDealloc)},
+    {Py_bf_getbuffer, reinterpret_cast<void*>(stateArrayGetBuffer)},
+    {Py_bf_releasebuffer, reinterpret_cast<void*>(stateArrayReleaseBuffer)},
+    {0, nullptr}
+};
+
+static PyType_Spec stateArraySpec = {"dase._StateArray", sizeof(StateArrayObject), 0, Py_TPFLAGS_DEFAULT,
+                                     stateArraySlots};
+
+static PyObject* engineStateView(EngineObject* self, StateField field) {
+    if (!engineReady(self)) return nullptr;
+    StateArrayObject* array = reinterpret_cast<StateArrayObject*>(PyType_GenericAlloc(StateArrayType, 0));
+    if (!array) return nullptr;
+    Py_INCREF(self);
+    array->engine = self;
+    array->field = field;
+    withEngine(self, [&](auto& engine) {
+        const char* format = nullptr;
+        size_t itemsize = 0;
+        stateFieldData(engine.getNodeStorage(), field, &format, &itemsize);
+        array->shape = static_cast<Py_ssize_t>(engine.getNodeCount());
+        array->stride = static_cast<Py_ssize_t>(itemsize);
+    });
+    PyObject* view = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(array));
+    Py_DECREF(array);
+    return view;
+}
+
+static PyObject* engineGetOutputs(EngineObject* self, void*) { return engineStateView(self, StateField::Outputs); }
+static PyObject* engineGetIntegratorState(EngineObject* self, void*) {
+    return engineStateView(self, StateField::IntegratorState);
+}
+static PyObject* engineGetGains(EngineObject* self, void*) { return engineStateView(self, StateField::Gains); }
+static PyObject* engineGetPreviousInput(EngineObject* self, void*) {
+    return engineStateView(self, StateField::PreviousInput);
+}
+
+static PyObject* engineGetNodeCount(EngineObject* self, void*) {
+    if (!engineReady(self)) return nullptr;
+    return PyLong_FromSize_t(withEngine(self, [](auto& engine) { return engine.getNodeCount(); }));
+}
+
+static PyObject* engineGetThreadCount(EngineObject* self, void*) {
+    if (!engineReady(self)) return nullptr;
+    return PyLong_FromSize_t(withEngine(self, [](auto& engine) { return engine.getThreadCount(); }));
+}
+
+static PyObject* engineGetPrecision(EngineObject* self, void*) {
+    if (!engineReady(self)) return nullptr;
+    return PyUnicode_FromString(self->f64 ? "double" : self->f32 ? "float32" : "mixed");
+}
+
+static PyObject* engineGetOperationCount(EngineObject* self, void*) {
+    if (!checkEngine(self)) return nullptr;
+    return PyLong_FromUnsignedLongLong(withEngine(self, [](auto& engine) { return engine.getOperationCount(); }));
+}
+
+static PyObject* engineGetTime(EngineObject* self, void*) {
+    if (!checkEngine(self)) return nullptr;
+    return PyFloat_FromDouble(withEngine(self, [](auto& engine) { return engine.getClock().now(); }));
+}
+
+static PyMethodDef engineMethods[] = {
+    {"process_signal_wave", pyCallback<PyCFunction>(engineProcessSignalWave), METH_VARARGS,
+     "process_signal_wave(input, control=0.0) -> mean node output"},
+    {"process_signal_block", pyCallback<PyCFunction>(engineProcessSignalBlock),
+     METH_VARARGS | METH_KEYWORDS,
+     "process_signal_block(inputs, controls=None, out=None) -> out\n"
+     "One wave per float64 input sample; controls, if given, has the same length.\n"
+     "out must not overlap inputs or controls (ValueError)"},
+    {"perform_signal_sweep", pyCallback<PyCFunction>(enginePerformSignalSweep), METH_VARARGS,
+     "perform_signal_sweep(base_frequency)"},
+    {"perform_signal_sweep_block", pyCallback<PyCFunction>(engineSweepSteps<false>),
+     METH_VARARGS | METH_KEYWORDS, "perform_signal_sweep_block(base_frequency, steps, out=None) -> out"},
+    {"run_steps", pyCallback<PyCFunction>(engineSweepSteps<true>),
+     METH_VARARGS | METH_KEYWORDS, "run_steps(base_frequency, steps, out=None) -> out (fused sweep steps)"},
+    {"set_circuit", pyCallback<PyCFunction>(engineSetCircuit), METH_VARARGS,
+     "set_circuit(circuit): patch a netlist with the engine's node count"},
+    {"clear_circuit", pyCallback<PyCFunction>(engineClearCircuit), METH_NOARGS, "clear_circuit()"},
+    {"process_circuit_step", pyCallback<PyCFunction>(engineProcessCircuitStep), METH_VARARGS,
+     "process_circuit_step(input) -> mean node output"},
+    {"set_event_driven", pyCallback<PyCFunction>(engineSetEventDriven), METH_VARARGS,
+     "set_event_driven(enabled, tolerance=1e-9)"},
+    {"set_system_feedback", pyCallback<PyCFunction>(engineSetSystemFeedback), METH_VARARGS,
+     "set_system_feedback(level)"},
+    {"set_noise", pyCallback<PyCFunction>(engineSetNoise), METH_VARARGS, "set_noise(level, seed=0)"},
+    {"set_time_step", pyCallback<PyCFunction>(engineSetTimeStep), METH_VARARGS, "set_time_step(dt)"},
+    {"reset_all_integrators", pyCallback<PyCFunction>(engineResetAllIntegrators), METH_NOARGS,
+     "reset_all_integrators()"},
+    {"save_snapshot", pyCallback<PyCFunction>(engineSaveSnapshot), METH_VARARGS, "save_snapshot(path)"},
+    {"load_snapshot", pyCallback<PyCFunction>(engineLoadSnapshot), METH_VARARGS,
+     "load_snapshot(path): refused while state array views are alive"},
+    {"node_slot", pyCallback<PyCFunction>(engineNodeSlot), METH_VARARGS,
+     "node_slot(node_id) -> index into the state arrays"},
+    {"node_id", pyCallback<PyCFunction>(engineNodeId), METH_VARARGS, "node_id(slot) -> node ID"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyGetSetDef engineGetSet[] = {
+    {"outputs", pyCallback<getter>(engineGetOutputs), nullptr, "Live node outputs (read-only, slot order)",
+     nullptr},
+    {"integrator_state", pyCallback<getter>(engineGetIntegratorState), nullptr,
+     "Live integrator state (read-only, slot order)", nullptr},
+    {"gains", pyCallback<getter>(engineGetGains), nullptr, "Live feedback gains (read-only, slot order)",
+     nullptr},
+    {"previous_input", pyCallback<getter>(engineGetPreviousInput), nullptr,
+     "Live differentiator history (read-only, slot order)", nullptr},
+    {"node_count", pyCallback<getter>(engineGetNodeCount), nullptr, "Nodes in the engine", nullptr},
+    {"thread_count", pyCallback<getter>(engineGetThreadCount), nullptr, "Engine worker threads", nullptr},
+    {"precision", pyCallback<getter>(engineGetPrecision), nullptr, "'double', 'float32' or 'mixed'", nullptr},
+    {"operation_count", pyCallback<getter>(engineGetOperationCount), nullptr, "Node evaluations so far",
+     nullptr},
+    {"time", pyCallback<getter>(engineGetTime), nullptr, "Simulation time", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+static PyType_Slot engineSlots[] = {
+    {Py_tp_doc, const_cast<char*>("Engine(nodes=100, precision='double', threads=0): AnalogCellularEngine")},
+    {Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew)},
+    {Py_tp_init, reinterpret_cast<void*>(engineInit)},
+    {Py_tp_dealloc, reinterpret_cast<void*>(engineDealloc)},
+    {Py_tp_methods, engineMethods},
+    {Py_tp_getset, engineGetSet},
+    {0, nullptr}
+};
+
+static PyType_Spec engineSpec = {"dase.Engine", sizeof(EngineObject), 0, Py_TPFLAGS_DEFAULT, engineSlots};
+
+// ---- Ensemble ----
+
+struct EnsembleObject {
+    PyObject_HEAD
+    EnsembleEngine* ensemble;
+    bool busy;
+};
+
+static bool checkEnsemble(EnsembleObject* self) {
+    if (!self->ensemble) {
+        PyErr_SetString(PyExc_RuntimeError, "Ensemble is not initialized");
+        return false;
+    }
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "Ensemble is running a call in another thread");
+        return false;
+    }
+    return true;
+}
+
+static bool parseObservable(const char* name, EnsembleObservable& observable) {
+    const std::string text = name;
+    if (text == "final") {
+        observable = EnsembleObservable::FinalOutput;
+    } else if (text == "mean") {
+        observable = EnsembleObservable::MeanOutput;
+    } else if (text == "peak") {
+        observable = EnsembleObservable::PeakOutput;
+    } else {
+        PyErr_Format(PyExc_ValueError, "observable must be 'final', 'mean' or 'peak', not '%s'", name);
+        return false;
+    }
+    return true;
+}
+
+static int ensembleInit(EnsembleObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"circuit", "instances", "threads", nullptr};
+    PyObject* object = nullptr;
+    Py_ssize_t instances = 0;
+    Py_ssize_t threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!n|n", const_cast<char**>(kwlist), CircuitType, &object,
+                                     &instances, &threads)) {
+        return -1;
+    }
+    CircuitObject* circuit = reinterpret_cast<CircuitObject*>(object);
+    if (!checkCircuit(circuit)) return -1;
+    if (instances <= 0 || threads < 0) {
+        PyErr_SetString(PyExc_ValueError, "instances must be positive and threads non-negative");
+        return -1;
+    }
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "Ensemble is in use");
+        return -1;
+    }
+    BusyScope busy(self->busy);
+    delete self->ensemble;
+    self->ensemble = nullptr;
+    AnalogEngineConfig config;
+    config.num_threads = static_cast<size_t>(threads);
+    const AnalogCircuitGraph graph = *circuit->graph;
+    EnsembleEngine* ensemble = nullptr;
+    Py_BEGIN_ALLOW_THREADS
+    ensemble = new EnsembleEngine(graph, static_cast<size_t>(instances), config);
+    Py_END_ALLOW_THREADS
+    self->ensemble = ensemble;
+    return 0;
+}
+
+// Runs fn(ensemble) with the GIL released; the caller holds a BusyScope
+template <typename Fn>
+static void runEnsembleUnlocked(EnsembleObject* self, Fn&& fn) {
+    EnsembleEngine& ensemble = *self->ensemble;
+    Py_BEGIN_ALLOW_THREADS
+    fn(ensemble);
+    Py_END_ALLOW_THREADS
+}
+
+static void ensembleDealloc(EnsembleObject* self) {
+    delete self->ensemble;
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+static PyObject* ensembleRun(EnsembleObject* self, PyObject* args) {
+    Py_ssize_t steps = 0;
+    double time_step = 0.001;
+    if (!PyArg_ParseTuple(args, "n|d", &steps, &time_step) || !checkEnsemble(self)) return nullptr;
+    BusyScope busy(self->busy);
+    if (steps < 0) {
+        PyErr_SetString(PyExc_ValueError, "steps must be non-negative");
+        return nullptr;
+    }
+    runEnsembleUnlocked(self, [&](EnsembleEngine& ensemble) { ensemble.run(static_cast<size_t>(steps), time_step); });
+    Py_RETURN_NONE;
+}
+
+static PyObject* ensembleSweepFeedback(EnsembleObject* self, PyObject* args) {
+    double first = 0.0, last = 0.0;
+    if (!PyArg_ParseTuple(args, "dd", &first, &last) || !checkEnsemble(self)) return nullptr;
+    BusyScope busy(self->busy);
+    self->ensemble->sweepFeedback(first, last);
+    Py_RETURN_NONE;
+}
+
+static PyObject* ensembleSweepFrequency(EnsembleObject* self, PyObject* args) {
+    double first = 0.0, last = 0.0;
+    if (!PyArg_ParseTuple(args, "dd", &first, &last) || !checkEnsemble(self)) return nullptr;
+    BusyScope busy(self->busy);
+    self->ensemble->sweepFrequency(first, last);
+    Py_RETURN_NONE;
+}
+
+static PyObject* ensembleRandomizeFeedback(EnsembleObject* self, PyObject* args) {
+    double center = 0.0, spread = 0.0;
+    unsigned long long seed = 0;
+    if (!PyArg_ParseTuple(args, "dd|K", &center, &spread, &seed) || !checkEnsemble(self)) return nullptr;
+    BusyScope busy(self->busy);
+    self->ensemble->randomizeFeedback(center, spread, seed);
+    Py_RETURN_NONE;
+}
+
+static PyObject* ensembleSetInstanceFeedback(EnsembleObject* self, PyObject* args) {
+    Py_ssize_t instance = 0;
+    double gain = 0.0;
+    if (!PyArg_ParseTuple(args, "nd", &instance, &gain) || !checkEnsemble(self)) return nullptr;
+    BusyScope busy(self->busy);
+    if (instance < 0 || !self->ensemble->setInstanceFeedback(static_cast<size_t>(instance), gain)) {
+        PyErr_SetString(PyExc_IndexError, "instance out of range");
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* ensembleSetInstanceFrequency(EnsembleObject* self, PyObject* args) {
+    Py_ssize_t instance = 0;
+    double frequency = 0.0;
+    if (!PyArg_ParseTuple(args, "nd", &instance, &frequency) || !checkEnsemble(self)) return nullptr;
+    BusyScope busy(self->busy);
+    if (instance < 0 || !self->ensemble->setInstanceFrequency(static_cast<size_t>(instance), frequency)) {
+        PyErr_SetString(PyExc_IndexError, "instance out of range");
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* ensembleSetObservedNode(EnsembleObject* self, PyObject* args) {
+    unsigned int node = 0;
+    if (!PyArg_ParseTuple(args, "I", &node) || !checkEnsemble(self)) return nullptr;
+    BusyScope busy(self->busy);
+    if (!self->ensemble->setObservedNode(node)) {
+        PyErr_SetString(PyExc_IndexError, "node out of range");
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* ensembleReset(EnsembleObject* self, PyObject*) {
+    if (!checkEnsemble(self)) return nullptr;
+    BusyScope busy(self->busy);
+    self->ensemble->reset();
+    Py_RETURN_NONE;
+}
+
+static PyObject* ensembleStatistics(EnsembleObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"observable", "bins", nullptr};
+    const char* name = "final";
+    Py_ssize_t bins = 32;
+    EnsembleObservable observable = EnsembleObservable::FinalOutput;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|sn", const_cast<char**>(kwlist), &name, &bins) ||
+        !parseObservable(name, observable) || !checkEnsemble(self)) {
+        return nullptr;
+    }
+    BusyScope busy(self->busy);
+    if (bins < 0) {
+        PyErr_SetString(PyExc_ValueError, "bins must be non-negative");
+        return nullptr;
+    }
+    EnsembleStats stats;
+    runEnsembleUnlocked(self, [&](EnsembleEngine& ensemble) {
+        stats = ensemble.getStatistics(observable, static_cast<size_t>(bins));
+    });
+    PyObject* histogram = PyList_New(static_cast<Py_ssize_t>(stats.histogram.size()));
+    if (!histogram) return nullptr;
+    for (size_t i = 0; i < stats.histogram.size(); i++) {
+        PyObject* count = PyLong_FromUnsignedLongLong(stats.histogram[i]);
+        if (!count) {
+            Py_DECREF(histogram);
+            return nullptr;
+        }
+        PyList_SET_ITEM(histogram, static_cast<Py_ssize_t>(i), count);
+    }
+    return Py_BuildValue("{s:n,s:n,s:d,s:d,s:d,s:d,s:N}", "instances", static_cast<Py_ssize_t>(stats.instances),
+                         "non_finite", static_cast<Py_ssize_t>(stats.non_finite), "mean", stats.mean, "variance",
+                         stats.variance, "min", stats.min, "max", stats.max, "histogram", histogram);
+}
+
+// values(observable="final", out=None): one float64 per instance
+static PyObject* ensembleValues(EnsembleObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"observable", "out", nullptr};
+    const char* name = "final";
+    PyObject* out_object = Py_None;
+    EnsembleObservable observable = EnsembleObservable::FinalOutput;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|sO", const_cast<char**>(kwlist), &name, &out_object) ||
+        !parseObservable(name, observable) || !checkEnsemble(self)) {
+        return nullptr;
+    }
+    BusyScope busy(self->busy);
+    const size_t count = self->ensemble->getInstanceCount();
+    Py_buffer out;
+    double* values = nullptr;
+    PyObject* result = outputArray(out_object, count, &out, &values);
+    if (!result) return nullptr;
+    runEnsembleUnlocked(self, [&](EnsembleEngine& ensemble) {
+        for (size_t i = 0; i < count; i++) values[i] = ensemble.getInstanceValue(observable, i);
+    });
+    releaseBuffer(&out);
+    return result;
+}
+
+static PyObject* ensembleGetInstanceCount(EnsembleObject* self, void*) {
+    if (!checkEnsemble(self)) return nullptr;
+    return PyLong_FromSize_t(self->ensemble->getInstanceCount());
+}
+
+static PyObject* ensembleGetNodeCount(EnsembleObject* self, void*) {
+    if (!checkEnsemble(self)) return nullptr;
+    return PyLong_FromSize_t(self->ensemble->getNodeCount());
+}
+
+static PyObject* ensembleGetThreadCount(EnsembleObject* self, void*) {
+    if (!checkEnsemble(self)) return nullptr;
+    return PyLong_FromSize_t(self->ensemble->getThreadCount());
+}
+
+static PyObject* ensembleGetTime(EnsembleObject* self, void*) {
+    if (!checkEnsemble(self)) return nullptr;
+    return PyFloat_FromDouble(self->ensemble->getTime());
+}
+
+static PyMethodDef ensembleMethods[] = {
+    {"run", pyCallback<PyCFunction>(ensembleRun), METH_VARARGS, "run(steps, time_step=0.001)"},
+    {"sweep_feedback", pyCallback<PyCFunction>(ensembleSweepFeedback), METH_VARARGS,
+     "sweep_feedback(first, last): linear across instances"},
+    {"sweep_frequency", pyCallback<PyCFunction>(ensembleSweepFrequency), METH_VARARGS,
+     "sweep_frequency(first, last): linear across instances"},
+    {"randomize_feedback", pyCallback<PyCFunction>(ensembleRandomizeFeedback), METH_VARARGS,
+     "randomize_feedback(center, spread, seed=0): uniform in [center - spread, center + spread]"},
+    {"set_instance_feedback", pyCallback<PyCFunction>(ensembleSetInstanceFeedback), METH_VARARGS,
+     "set_instance_feedback(instance, gain)"},
+    {"set_instance_frequency", pyCallback<PyCFunction>(ensembleSetInstanceFrequency), METH_VARARGS,
+     "set_instance_frequency(instance, frequency)"},
+    {"set_observed_node", pyCallback<PyCFunction>(ensembleSetObservedNode), METH_VARARGS,
+     "set_observed_node(node)"},
+    {"reset", pyCallback<PyCFunction>(ensembleReset), METH_NOARGS,
+     "reset(): clear node state, observables and time; parameters are kept"},
+    {"statistics", pyCallback<PyCFunction>(ensembleStatistics),
+     METH_VARARGS | METH_KEYWORDS, "statistics(observable='final', bins=32) -> dict"},
+    {"values", pyCallback<PyCFunction>(ensembleValues),
+     METH_VARARGS | METH_KEYWORDS, "values(observable='final', out=None) -> one float64 per instance"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyGetSetDef ensembleGetSet[] = {
+    {"instance_count", pyCallback<getter>(ensembleGetInstanceCount), nullptr, "Circuit instances", nullptr},
+    {"node_count", pyCallback<getter>(ensembleGetNodeCount), nullptr, "Nodes per instance", nullptr},
+    {"thread_count", pyCallback<getter>(ensembleGetThreadCount), nullptr, "Worker threads", nullptr},
+    {"time", pyCallback<getter>(ensembleGetTime), nullptr, "Drive time base", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+static PyType_Slot ensembleSlots[] = {
+    {Py_tp_doc, const_cast<char*>("Ensemble(circuit, instances, threads=0): EnsembleEngine")},
+    {Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew)},
+    {Py_tp_init, reinterpret_cast<void*>(ensembleInit)},
+    {Py_tp_dealloc, reinterpret_cast<void*>(ensembleDealloc)},
+    {Py_tp_methods, ensembleMethods},
+    {Py_tp_getset, ensembleGetSet},
+    {0, nullptr}
+};
+
+static PyType_Spec ensembleSpec = {"dase.Ensemble", sizeof(EnsembleObject), 0, Py_TPFLAGS_DEFAULT, ensembleSlots};
+
+// ---- Module ----
+
+static PyObject* moduleKernelIsa(PyObject*, PyObject*) { return PyUnicode_FromString(analogKernelIsa()); }
+
+static PyObject* moduleSelectKernelIsa(PyObject*, PyObject* args) {
+    const char* isa = nullptr;
+    if (!PyArg_ParseTuple(args, "s", &isa)) return nullptr;
+    return PyBool_FromLong(analogSelectKernelIsa(isa));
+}
+
+static PyMethodDef moduleMethods[] = {
+    {"kernel_isa", moduleKernelIsa, METH_NOARGS, "kernel_isa() -> instruction set of the wave kernels in use"},
+    {"select_kernel_isa", moduleSelectKernelIsa, METH_VARARGS,
+     "select_kernel_isa(name) -> False if this binary or CPU cannot run those kernels"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyModuleDef daseModule = {PyModuleDef_HEAD_INIT, "dase", "D-ASE analog engine bindings", -1, moduleMethods,
+                                 nullptr, nullptr, nullptr, nullptr};
+
+static bool addType(PyObject* module, PyType_Spec* spec, PyTypeObject** type, const char* name) {
+    *type = reinterpret_cast<PyTypeObject*>(PyType_FromSpec(spec));
+    if (!*type) return false;
+    if (!name) return true;
+    Py_INCREF(*type);
+    if (PyModule_AddObject(module, name, reinterpret_cast<PyObject*>(*type)) != 0) {
+        Py_DECREF(*type);
+        return false;
+    }
+    return true;
+}
+
+PyMODINIT_FUNC PyInit_dase(void) {
+    PyObject* module = PyModule_Create(&daseModule);
+    if (!module) return nullptr;
+    if (!addType(module, &circuitSpec, &CircuitType, "Circuit") ||
+        !addType(module, &engineSpec, &EngineType, "Engine") ||
+        !addType(module, &stateArraySpec, &StateArrayType, nullptr) ||
+        !addType(module, &ensembleSpec, &EnsembleType, "Ensemble")) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
@@ -0,0 +1,65 @@
+"""Behavioural checks of the dase extension module (run by ctest as PythonModule).
+
+Uses array.array and memoryview only, so it needs nothing beyond the module.
+"""
+import array
+import math
+import sys
+
+import dase
+
+
+def samples(n):
+    return array.array("d", (math.sin(0.01 * t) for t in range(n)))
+
+
+def check_block_matches_waves():
+    block = dase.Engine(nodes=64, threads=1)
+    waves = dase.Engine(nodes=64, threads=1)
+    x = samples(32)
+    out = block.process_signal_block(x)
+    expected = [waves.process_signal_wave(v) for v in x]
+    assert list(out) == expected, "process_signal_block differs from process_signal_wave"
+
+
+def check_out_buffer():
+    engine = dase.Engine(nodes=64, threads=1)
+    reference = dase.Engine(nodes=64, threads=1).process_signal_block(samples(32))
+    out = array.array("d", bytes(32 * 8))
+    assert engine.process_signal_block(samples(32), out=out) is out
+    assert list(out) == list(reference), "out= received different values"
+
+
+def check_aliased_out_rejected():
+    engine = dase.Engine(nodes=64, threads=1)
+    x = samples(32)
+    before = list(x)
+    view = memoryview(x)
+    controls = array.array("d", [0.1] * 32)
+    for out, extra in ((x, {}), (view, {}), (view[8:], None), (controls, {"controls": controls})):
+        try:
+            if extra is None:
+                # Partial overlap: out is the tail of the inputs buffer
+                engine.process_signal_block(view[:24], out=out)
+            else:
+                engine.process_signal_block(x, out=out, **extra)
+        except ValueError:
+            pass
+        else:
+            raise AssertionError("aliased out= was accepted")
+    assert list(x) == before, "a rejected call wrote to its inputs"
+    # The engine is still usable and no wave ran during the rejected calls
+    fresh = dase.Engine(nodes=64, threads=1).process_signal_block(x)
+    assert list(engine.process_signal_block(x)) == list(fresh)
+
+
+def main():
+    checks = [check_block_matches_waves, check_out_buffer, check_aliased_out_rejected]
+    for check in checks:
+        check()
+        print("ok", check.__name__)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
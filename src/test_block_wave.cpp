@@ -0,0 +1,63 @@
+// processSignalBlock must equal one processSignalWave per sample, bit for bit, in
+// every precision, with and without noise, across its internal chunk boundary.
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "analog_universal_node_engine.h"
+#include "test_support.h"
+
+namespace {
+
+template <typename Engine>
+int checkPrecision(const char* precision) {
+    struct Case {
+        size_t nodes;
+        size_t samples;
+        size_t threads;
+    };
+    // 5000 samples cross the 4096-sample chunk; 13 and 301 nodes leave partial lane blocks
+    const Case cases[] = {{1, 5000, 1}, {13, 300, 2}, {301, 40, 3}};
+    int failures = 0;
+    for (const Case& c : cases) {
+        for (double noise : {0.0, 0.04}) {
+            for (ReductionMode mode : {ReductionMode::Pairwise, ReductionMode::Kahan}) {
+                AnalogEngineConfig config = testConfig(c.threads);
+                config.reduction = mode;
+                Engine block(c.nodes, config), waves(c.nodes, config);
+                block.setNoise(noise, 11);
+                waves.setNoise(noise, 11);
+
+                std::vector<double> inputs(c.samples), controls(c.samples), expected(c.samples), actual(c.samples);
+                for (size_t t = 0; t < c.samples; t++) {
+                    inputs[t] = std::sin(0.013 * static_cast<double>(t)) * 1.5;
+                    controls[t] = std::cos(0.007 * static_cast<double>(t)) * 0.9;   // Crosses every mode
+                }
+                block.processSignalBlock(inputs.data(), controls.data(), c.samples, actual.data());
+                for (size_t t = 0; t < c.samples; t++) expected[t] = waves.processSignalWave(inputs[t], controls[t]);
+
+                const std::string what = std::string(precision) + " " + std::to_string(c.nodes) + " nodes x " +
+                                         std::to_string(c.samples) + " samples, noise " + std::to_string(noise) +
+                                         (mode == ReductionMode::Kahan ? ", Kahan" : ", pairwise");
+                expectSame(expected, actual, what + ": outputs", failures);
+                expectSame(nodeState(waves), nodeState(block), what + ": node state", failures);
+
+                // Null controls mean 0.0
+                std::vector<double> zeros(c.samples, 0.0);
+                block.processSignalBlock(inputs.data(), nullptr, c.samples, actual.data());
+                for (size_t t = 0; t < c.samples; t++) expected[t] = waves.processSignalWave(inputs[t], zeros[t]);
+                expectSame(expected, actual, what + ": null controls", failures);
+            }
+        }
+    }
+    return failures;
+}
+
+}  // namespace
+
+int main() {
+    int failures = checkPrecision<AnalogCellularEngine>("double");
+    failures += checkPrecision<AnalogCellularEngineF32>("float");
+    failures += checkPrecision<AnalogCellularEngineMixed>("mixed");
+    return testResult(failures, "block == wave: bit-identical");
+}
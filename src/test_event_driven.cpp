@@ -0,0 +1,79 @@
+// Event-driven circuit steps with tolerance 0 must equal full evaluation bit for
+// bit, while still skipping the quiescent part of the circuit.
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "analog_universal_node_engine.h"
+#include "test_support.h"
+
+namespace {
+
+// Chains of amplifiers and inverters fed by a held input, a few integrators and
+// differentiators, algebraic loops (demoted by compile()) and delayed feedback
+AnalogCircuitGraph testCircuit(size_t nodes) {
+    const double modes[] = {0.3, -0.2, 0.6, 0.1, -0.7, -0.4, 0.8, 0.2};
+    AnalogCircuitGraph graph(nodes);
+    for (uint32_t v = 0; v < nodes; v++) {
+        graph.setControl(v, v % 13 == 0 ? modes[v % 8] : modes[(v * 3) % 8] * 0.5);
+        if (v % 9 == 0) graph.setExternalInput(v, 0.4 + 0.05 * (v % 4));
+        if (v >= 1 && v % 9 != 0) graph.connect(v - 1, v, 0.7);
+        if (v >= 10 && v % 4 == 0) graph.connect(v - 10, v, -0.25);
+        if (v % 17 == 5) graph.connect(v, v > 20 ? v - 20 : 0, 0.1);   // Closes algebraic loops
+        if (v % 23 == 3) graph.connectDelayed(v, static_cast<uint32_t>((v * 5) % nodes), 0.3);
+    }
+    return graph;
+}
+
+template <typename Engine>
+int checkPrecision(const char* precision) {
+    int failures = 0;
+    for (size_t nodes : {40, 600}) {
+        for (NodeOrdering ordering : {NodeOrdering::RowMajor, NodeOrdering::Morton}) {
+            AnalogEngineConfig config = testConfig(2);
+            AnalogLatticeLayout layout;
+            layout.ordering = ordering;
+            Engine full(nodes, config, layout), events(nodes, config, layout);
+            full.setCircuit(testCircuit(nodes));
+            events.setCircuit(testCircuit(nodes));
+            events.setEventDriven(true, 0.0);
+
+            std::vector<double> expected, actual;
+            for (int step = 0; step < 120; step++) {
+                // Held for long stretches, so most of the circuit goes quiet between changes
+                const double input = step < 40 ? 1.0 : (step < 80 ? -0.5 : 0.25 * ((step / 10) % 3));
+                if (step == 60) {
+                    for (Engine* engine : {&full, &events}) engine->setSystemFeedback(1.5);
+                }
+                if (step == 90) {
+                    for (Engine* engine : {&full, &events}) engine->processSignalWave(0.3, 0.1);   // Another mode
+                }
+                expected.push_back(full.processCircuitStep(input));
+                actual.push_back(events.processCircuitStep(input));
+            }
+            const std::string what = std::string(precision) + " " + std::to_string(nodes) + " nodes" +
+                                     (ordering == NodeOrdering::Morton ? " Morton" : "");
+            expectSame(expected, actual, what + ": step results", failures);
+            expectSame(nodeState(full), nodeState(events), what + ": node state", failures);
+
+            // The comparison only means something if steps were actually skipped
+            const AnalogEventStats& stats = events.getEventStats();
+            if (stats.evaluated >= stats.steps * nodes) {
+                std::printf("FAIL %s: event-driven steps evaluated every node (%llu of %llu)\n", what.c_str(),
+                            static_cast<unsigned long long>(stats.evaluated),
+                            static_cast<unsigned long long>(stats.steps * nodes));
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+}  // namespace
+
+int main() {
+    int failures = checkPrecision<AnalogCellularEngine>("double");
+    failures += checkPrecision<AnalogCellularEngineF32>("float");
+    failures += checkPrecision<AnalogCellularEngineMixed>("mixed");
+    return testResult(failures, "event-driven (tolerance 0) == full evaluation: bit-identical");
+}
@@ -0,0 +1,75 @@
+// Every wave kernel build this binary carries and this CPU runs (avx512, avx2, the
+// sse2 / scalar baseline) must give bit-identical results to the others.
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "analog_simd_kernels.h"
+#include "analog_universal_node_engine.h"
+#include "test_support.h"
+
+namespace {
+
+// Waves, a block and a lattice step on the selected kernels, then the node state
+template <typename Engine>
+std::vector<double> runKernels(size_t nodes) {
+    AnalogEngineConfig config = testConfig(2);
+    Engine engine(nodes, config);
+    engine.setNoise(0.02, 3);
+    std::vector<double> results;
+    // Controls sweep through integrate, differentiate, amplify and invert
+    for (int wave = 0; wave < 12; wave++) {
+        results.push_back(engine.processSignalWave(std::sin(0.7 * wave) * 2.0, std::cos(0.45 * wave)));
+    }
+    std::vector<double> inputs(257), controls(257), outputs(257);
+    for (size_t t = 0; t < inputs.size(); t++) {
+        inputs[t] = std::sin(0.09 * static_cast<double>(t)) * 3.0;
+        controls[t] = std::sin(0.031 * static_cast<double>(t) + 1.0);
+    }
+    engine.processSignalBlock(inputs.data(), controls.data(), inputs.size(), outputs.data());
+    results.insert(results.end(), outputs.begin(), outputs.end());
+    engine.setLattice(AnalogLatticeConfig());
+    for (int step = 0; step < 3; step++) results.push_back(engine.processLatticeStep(0.5));
+
+    const auto state = nodeState(engine);
+    results.insert(results.end(), state.begin(), state.end());
+    return results;
+}
+
+template <typename Engine>
+int checkPrecision(const char* precision, const std::vector<const char*>& isas) {
+    int failures = 0;
+    // Node counts that leave partial lane blocks for both 8- and 16-lane builds
+    for (size_t nodes : {1, 13, 100, 517}) {
+        analogSelectKernelIsa(isas[0]);
+        const auto reference = runKernels<Engine>(nodes);
+        for (size_t i = 1; i < isas.size(); i++) {
+            analogSelectKernelIsa(isas[i]);
+            expectSame(reference, runKernels<Engine>(nodes),
+                       std::string(precision) + " " + std::to_string(nodes) + " nodes: " + isas[i] + " vs " + isas[0],
+                       failures);
+        }
+    }
+    return failures;
+}
+
+}  // namespace
+
+int main() {
+    std::vector<const char*> isas;
+    for (const char* isa : {"scalar", "sse2", "avx2", "avx512"}) {
+        if (analogSelectKernelIsa(isa)) isas.push_back(isa);
+    }
+    std::printf("kernel builds available:");
+    for (const char* isa : isas) std::printf(" %s", isa);
+    std::printf("\n");
+    if (isas.empty()) {
+        std::printf("FAIL no kernel build could be selected\n");
+        return 1;
+    }
+
+    int failures = checkPrecision<AnalogCellularEngine>("double", isas);
+    failures += checkPrecision<AnalogCellularEngineF32>("float", isas);
+    failures += checkPrecision<AnalogCellularEngineMixed>("mixed", isas);
+    return testResult(failures, "kernel builds: bit-identical");
+}
@@ -0,0 +1,78 @@
+// Lattice steps must not depend on the storage order: RowMajor, Morton and Hilbert
+// engines of one grid give bit-identical outputs for every node ID.
+#include <cstdio>
+#include <vector>
+#include "analog_universal_node_engine.h"
+#include "test_support.h"
+
+namespace {
+
+struct Grid {
+    uint32_t nx, ny, nz;
+    size_t nodes;
+};
+
+template <typename Engine>
+std::vector<double> runLattice(const Grid& grid, NodeOrdering ordering, const AnalogLatticeConfig& lattice, double noise) {
+    AnalogEngineConfig config = testConfig(2);
+    AnalogLatticeLayout layout;
+    layout.nx = grid.nx;
+    layout.ny = grid.ny;
+    layout.nz = grid.nz;
+    layout.ordering = ordering;
+    Engine engine(grid.nodes, config, layout);
+    engine.setNoise(noise, 7);
+
+    // A few waves first so every cell starts from a different output
+    for (int wave = 0; wave < 3; wave++) engine.processSignalWave(0.4 + 0.1 * wave, 0.2);
+    engine.setLattice(lattice);
+    for (int step = 0; step < 8; step++) engine.processLatticeStep(0.3 - 0.05 * step);
+
+    // Node state only: step means are summed in storage order
+    return nodeState(engine);
+}
+
+template <typename Engine>
+int checkPrecision(const char* precision) {
+    const Grid grids[] = {
+        {7, 6, 0, 200},    // Last plane partly filled
+        {8, 8, 4, 256},
+        {1, 3, 0, 12},     // Degenerate x axis: wrapped neighbours are the cell itself
+        {5, 1, 3, 15},
+    };
+    const LatticeNeighbourhood neighbourhoods[] = {LatticeNeighbourhood::Faces6, LatticeNeighbourhood::Full26};
+    int failures = 0;
+    for (const Grid& grid : grids) {
+        for (LatticeNeighbourhood neighbourhood : neighbourhoods) {
+            for (int periodic = 0; periodic < 2; periodic++) {
+                for (double noise : {0.0, 0.05}) {
+                    AnalogLatticeConfig lattice;
+                    lattice.neighbourhood = neighbourhood;
+                    lattice.coupling = 0.13;
+                    lattice.control = 0.25;
+                    lattice.periodic = periodic != 0;
+                    char what[128];
+                    std::snprintf(what, sizeof(what), "%s %ux%ux%u (%zu nodes) %s%s noise %g", precision, grid.nx,
+                                  grid.ny, grid.nz, grid.nodes,
+                                  neighbourhood == LatticeNeighbourhood::Full26 ? "Full26" : "Faces6",
+                                  periodic ? " periodic" : "", noise);
+                    const auto row_major = runLattice<Engine>(grid, NodeOrdering::RowMajor, lattice, noise);
+                    expectSame(row_major, runLattice<Engine>(grid, NodeOrdering::Morton, lattice, noise),
+                               std::string(what) + " Morton", failures);
+                    expectSame(row_major, runLattice<Engine>(grid, NodeOrdering::Hilbert, lattice, noise),
+                               std::string(what) + " Hilbert", failures);
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+}  // namespace
+
+int main() {
+    int failures = checkPrecision<AnalogCellularEngine>("double");
+    failures += checkPrecision<AnalogCellularEngineF32>("float");
+    failures += checkPrecision<AnalogCellularEngineMixed>("mixed");
+    return testResult(failures, "lattice layouts: all orderings bit-identical");
+}
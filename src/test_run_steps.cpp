@@ -0,0 +1,66 @@
+// runSteps(n) must equal n performSignalSweep calls: same per-step results, node
+// state, clock and applied commands, whatever the call lengths.
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "analog_universal_node_engine.h"
+#include "test_support.h"
+
+namespace {
+
+// performSignalSweep with its result exposed: the same clock step, drive and control
+template <typename Engine>
+double sweepStep(Engine& engine, double base_frequency) {
+    const double time = engine.advance(engine.getClock().getTimeStep());
+    return engine.processSignalWave(std::sin(base_frequency * time), std::sin(time * 0.1) * 0.5);
+}
+
+template <typename Engine>
+int checkPrecision(const char* precision) {
+    const double base_frequency = 3.7;
+    int failures = 0;
+    for (size_t nodes : {5, 200, 701}) {
+        for (size_t threads : {1, 3}) {
+            AnalogEngineConfig config = testConfig(threads);
+            Engine fused(nodes, config), stepped(nodes, config), swept(nodes, config);
+            for (Engine* engine : {&fused, &stepped, &swept}) engine->setNoise(0.02, 5);
+
+            const std::string what = std::string(precision) + " " + std::to_string(nodes) + " nodes, " +
+                                     std::to_string(threads) + " threads";
+            std::vector<double> expected, actual;
+            size_t call = 0;
+            for (size_t steps : {1, 7, 64, 3}) {
+                // A command posted before the run lands before its first step in both
+                EngineCommand command;
+                command.type = EngineCommandType::SetFeedback;
+                command.value = 1.0 + 0.25 * static_cast<double>(call++);
+                for (Engine* engine : {&fused, &stepped, &swept}) engine->postCommand(command);
+
+                std::vector<double> outputs(steps);
+                fused.runSteps(steps, base_frequency, outputs.data());
+                actual.insert(actual.end(), outputs.begin(), outputs.end());
+                for (size_t t = 0; t < steps; t++) {
+                    expected.push_back(sweepStep(stepped, base_frequency));
+                    swept.performSignalSweep(base_frequency);
+                }
+            }
+            expectSame(expected, actual, what + ": step results", failures);
+            expectSame(nodeState(stepped), nodeState(fused), what + ": node state vs waves", failures);
+            expectSame(nodeState(swept), nodeState(fused), what + ": node state vs performSignalSweep", failures);
+            expectSame({swept.getClock().now(), static_cast<double>(swept.getClock().getTicks())},
+                       {fused.getClock().now(), static_cast<double>(fused.getClock().getTicks())}, what + ": clock",
+                       failures);
+        }
+    }
+    return failures;
+}
+
+}  // namespace
+
+int main() {
+    int failures = checkPrecision<AnalogCellularEngine>("double");
+    failures += checkPrecision<AnalogCellularEngineF32>("float");
+    failures += checkPrecision<AnalogCellularEngineMixed>("mixed");
+    return testResult(failures, "runSteps == performSignalSweep: bit-identical");
+}
@@ -0,0 +1,103 @@
+// Snapshots must round-trip exactly: a restored engine carries on bit-identically
+// to the one that saved, engines restored from one file stay independent, and a
+// mismatched engine refuses the file.
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "analog_universal_node_engine.h"
+#include "test_support.h"
+
+namespace {
+
+template <typename Engine>
+std::vector<double> engineCounters(const Engine& engine) {
+    return {engine.getClock().now(), static_cast<double>(engine.getClock().getTicks()), engine.getClock().getTimeStep(),
+            engine.getNoiseLevel(), static_cast<double>(engine.getNoiseSeed()),
+            static_cast<double>(engine.getOperationCount())};
+}
+
+// Waves, a block and a sweep: results, then node state
+template <typename Engine>
+std::vector<double> continueRun(Engine& engine) {
+    std::vector<double> results;
+    for (int wave = 0; wave < 5; wave++) results.push_back(engine.processSignalWave(0.3 * wave, -0.6 + 0.3 * wave));
+    std::vector<double> inputs(100), outputs(100);
+    for (size_t t = 0; t < inputs.size(); t++) inputs[t] = std::sin(0.2 * static_cast<double>(t));
+    engine.processSignalBlock(inputs.data(), nullptr, inputs.size(), outputs.data());
+    results.insert(results.end(), outputs.begin(), outputs.end());
+    std::vector<double> steps(10);
+    engine.runSteps(steps.size(), 4.0, steps.data());
+    results.insert(results.end(), steps.begin(), steps.end());
+    const auto state = nodeState(engine);
+    results.insert(results.end(), state.begin(), state.end());
+    return results;
+}
+
+template <typename Engine>
+int checkPrecision(const char* precision) {
+    int failures = 0;
+    for (size_t nodes : {9, 700}) {
+        for (NodeOrdering ordering : {NodeOrdering::RowMajor, NodeOrdering::Hilbert}) {
+            const std::string what = std::string(precision) + " " + std::to_string(nodes) + " nodes" +
+                                     (ordering == NodeOrdering::Hilbert ? " Hilbert" : "");
+            const std::string path = "dase_test_snapshot_" + std::string(precision) + ".snap";
+            AnalogEngineConfig config = testConfig(2);
+            AnalogLatticeLayout layout;
+            layout.ordering = ordering;
+
+            Engine original(nodes, config, layout);
+            original.setNoise(0.05, 21);
+            original.setTimeStep(0.002);
+            for (int wave = 0; wave < 6; wave++) original.processSignalWave(std::sin(1.0 + wave), std::cos(0.6 * wave));
+            if (!original.saveSnapshot(path)) {
+                std::printf("FAIL %s: saveSnapshot\n", what.c_str());
+                failures++;
+                continue;
+            }
+            const auto saved_state = nodeState(original);
+
+            Engine restored(nodes, config, layout), second(nodes, config, layout);
+            if (!restored.loadSnapshot(path) || !second.loadSnapshot(path)) {
+                std::printf("FAIL %s: loadSnapshot\n", what.c_str());
+                failures++;
+                std::remove(path.c_str());
+                continue;
+            }
+            expectSame(saved_state, nodeState(restored), what + ": restored node state", failures);
+            expectSame(engineCounters(original), engineCounters(restored), what + ": clock, noise and counters", failures);
+
+            // Carrying on: restored == original, and the writes stay out of the file and the other engine
+            expectSame(continueRun(original), continueRun(restored), what + ": run after restore", failures);
+            expectSame(saved_state, nodeState(second), what + ": second restore after the first ran", failures);
+            Engine third(nodes, config, layout);
+            if (!third.loadSnapshot(path)) {
+                std::printf("FAIL %s: reload\n", what.c_str());
+                failures++;
+            }
+            expectSame(saved_state, nodeState(third), what + ": file unchanged by restored engines", failures);
+
+            // Another node count or layout must refuse the file and keep its own state
+            AnalogLatticeLayout other_layout = layout;
+            other_layout.ordering = ordering == NodeOrdering::RowMajor ? NodeOrdering::Morton : NodeOrdering::RowMajor;
+            Engine wrong_count(nodes + 1, config, layout), wrong_layout(nodes, config, other_layout);
+            const auto wrong_state = nodeState(wrong_count);
+            if (wrong_count.loadSnapshot(path) || wrong_layout.loadSnapshot(path)) {
+                std::printf("FAIL %s: a mismatched engine accepted the snapshot\n", what.c_str());
+                failures++;
+            }
+            expectSame(wrong_state, nodeState(wrong_count), what + ": refused load left the state alone", failures);
+            std::remove(path.c_str());
+        }
+    }
+    return failures;
+}
+
+}  // namespace
+
+int main() {
+    int failures = checkPrecision<AnalogCellularEngine>("double");
+    failures += checkPrecision<AnalogCellularEngineF32>("float");
+    failures += checkPrecision<AnalogCellularEngineMixed>("mixed");
+    return testResult(failures, "snapshots: exact round trip");
+}
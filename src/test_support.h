@@ -0,0 +1,66 @@
+#pragma once
+// Shared by the exactness tests (src/test_*.cpp): engine config, bitwise comparison
+// of result vectors and of engine node state, with one line per failed check.
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "engine_thread_pool.h"
+
+// Engine config for the tests: `threads` workers that park almost at once, since
+// the tests run several pools side by side and may oversubscribe small machines
+inline AnalogEngineConfig testConfig(size_t threads) {
+    AnalogEngineConfig config;
+    config.num_threads = threads;
+    config.spin_iterations = 64;
+    return config;
+}
+
+inline bool sameBits(const std::vector<double>& a, const std::vector<double>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0);
+}
+
+// Every hot state array of an engine, in node ID order (independent of the layout)
+template <typename Engine>
+std::vector<double> nodeState(const Engine& engine) {
+    const auto& storage = engine.getNodeStorage();
+    std::vector<double> values;
+    values.reserve(engine.getNodeCount() * 4);
+    for (size_t id = 0; id < engine.getNodeCount(); id++) {
+        const size_t slot = engine.getNodeSlot(static_cast<uint32_t>(id));
+        values.push_back(static_cast<double>(storage.integrator_state[slot]));
+        values.push_back(static_cast<double>(storage.previous_input[slot]));
+        values.push_back(static_cast<double>(storage.feedback_gain[slot]));
+        values.push_back(static_cast<double>(storage.current_output[slot]));
+    }
+    return values;
+}
+
+// Counts a failure and names it when `actual` differs from `expected` in any bit
+inline void expectSame(const std::vector<double>& expected, const std::vector<double>& actual, const std::string& what,
+                       int& failures) {
+    if (sameBits(expected, actual)) return;
+    size_t first = 0;
+    while (first < expected.size() && first < actual.size() &&
+           std::memcmp(&expected[first], &actual[first], sizeof(double)) == 0) {
+        first++;
+    }
+    if (first < expected.size() && first < actual.size()) {
+        std::printf("FAIL %s: entry %zu is %.17g, expected %.17g\n", what.c_str(), first, actual[first], expected[first]);
+    } else {
+        std::printf("FAIL %s: %zu entries, expected %zu\n", what.c_str(), actual.size(), expected.size());
+    }
+    failures++;
+}
+
+// main()'s exit status: prints `summary` when every check passed
+inline int testResult(int failures, const char* summary) {
+    if (failures) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("%s\n", summary);
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Reductions use fixed segments, so every mode's results must be bit-identical for
+// any thread count, schedule and reduction mode.
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "analog_universal_node_engine.h"
+#include "test_support.h"
+
+namespace {
+
+// Shallow (every level is a parallel region), wide levels, some delayed feedback
+AnalogCircuitGraph testCircuit(size_t nodes) {
+    AnalogCircuitGraph graph(nodes);
+    for (uint32_t v = 0; v < nodes; v++) {
+        graph.setControl(v, std::sin(0.37 * v) * 0.9);
+        if (v % 5 == 0) graph.setExternalInput(v, 0.5 + 0.01 * v);
+        if (v >= 3) graph.connect(v / 3, v, 0.3);
+        if (v >= 7) graph.connect(v / 2, v, -0.2);
+        if (v % 11 == 0) graph.connectDelayed(v, static_cast<uint32_t>((v * 7 + 1) % nodes), 0.4);
+    }
+    return graph;
+}
+
+// Means of every step kind, then the final node state
+template <typename Engine>
+std::vector<double> runAll(size_t nodes, const AnalogEngineConfig& config, NodeOrdering ordering) {
+    AnalogLatticeLayout layout;
+    layout.nx = 12;
+    layout.ny = 8;
+    layout.ordering = ordering;
+    Engine engine(nodes, config, layout);
+    engine.setNoise(0.03, 9);
+    std::vector<double> results;
+
+    for (int wave = 0; wave < 4; wave++) results.push_back(engine.processSignalWave(0.2 * wave - 0.3, 0.4));
+    std::vector<double> inputs(32), controls(32), outputs(32);
+    for (size_t t = 0; t < inputs.size(); t++) {
+        inputs[t] = std::sin(0.05 * static_cast<double>(t));
+        controls[t] = std::cos(0.02 * static_cast<double>(t)) * 0.8;
+    }
+    engine.processSignalBlock(inputs.data(), controls.data(), inputs.size(), outputs.data());
+    results.insert(results.end(), outputs.begin(), outputs.end());
+
+    std::vector<double> steps(10);
+    engine.runSteps(steps.size(), 2.5, steps.data());
+    results.insert(results.end(), steps.begin(), steps.end());
+    engine.performSignalSweepBlock(1.5, steps.size(), steps.data());
+    results.insert(results.end(), steps.begin(), steps.end());
+
+    AnalogLatticeConfig lattice;
+    lattice.neighbourhood = LatticeNeighbourhood::Full26;
+    lattice.periodic = true;
+    engine.setLattice(lattice);
+    for (int step = 0; step < 5; step++) results.push_back(engine.processLatticeStep(0.1 * step));
+    engine.clearLattice();
+
+    engine.setCircuit(testCircuit(nodes));
+    for (int step = 0; step < 10; step++) results.push_back(engine.processCircuitStep(std::sin(0.3 * step)));
+
+    const auto state = nodeState(engine);
+    results.insert(results.end(), state.begin(), state.end());
+    return results;
+}
+
+template <typename Engine>
+int checkPrecision(const char* precision) {
+    int failures = 0;
+    for (size_t nodes : {37, 701}) {
+        for (NodeOrdering ordering : {NodeOrdering::RowMajor, NodeOrdering::Hilbert}) {
+            for (ReductionMode mode : {ReductionMode::Pairwise, ReductionMode::Kahan}) {
+                AnalogEngineConfig reference_config = testConfig(1);
+                reference_config.reduction = mode;
+                const auto reference = runAll<Engine>(nodes, reference_config, ordering);
+                for (size_t threads : {2, 5}) {
+                    for (EngineSchedule schedule : {EngineSchedule::Dynamic, EngineSchedule::Static}) {
+                        AnalogEngineConfig config = reference_config;
+                        config.num_threads = threads;
+                        config.schedule = schedule;
+                        config.chunk = threads;
+                        const std::string what = std::string(precision) + " " + std::to_string(nodes) + " nodes" +
+                                                 (ordering == NodeOrdering::Hilbert ? " Hilbert" : "") +
+                                                 (mode == ReductionMode::Kahan ? " Kahan" : "") + ", " +
+                                                 std::to_string(threads) + " threads" +
+                                                 (schedule == EngineSchedule::Static ? " static" : " dynamic");
+                        expectSame(reference, runAll<Engine>(nodes, config, ordering), what, failures);
+                    }
+                }
+                // Everything on the calling thread
+                AnalogEngineConfig sequential = reference_config;
+                sequential.num_threads = 4;
+                sequential.sequential_below = nodes + 1;
+                expectSame(reference, runAll<Engine>(nodes, sequential, ordering),
+                           std::string(precision) + " " + std::to_string(nodes) + " nodes, sequential", failures);
+            }
+        }
+    }
+    return failures;
+}
+
+}  // namespace
+
+int main() {
+    int failures = checkPrecision<AnalogCellularEngine>("double");
+    failures += checkPrecision<AnalogCellularEngineF32>("float");
+    failures += checkPrecision<AnalogCellularEngineMixed>("mixed");
+    return testResult(failures, "thread count: bit-identical for every thread count and schedule");
+}
@@ -5,57 +5,1420 @@
 #include <memory>
 #include <map>
 #include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
 
-class AnalogModule {
-protected:
-    std::string name;
-    double output;
+#include "analog_universal_node_engine.h"
+#include "analog_circuit_graph.h"
+#include "analog_formula_program.h"
+#include "analog_sheet_loader.h"
+#include "engine_autotuner.h"
+#include "engine_results_channel.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using SocketHandle = SOCKET;
+static const SocketHandle kInvalidSocket = INVALID_SOCKET;
+static void closeSocket(SocketHandle s) { closesocket(s); }
+static void shutdownSocket(SocketHandle s) { shutdown(s, SD_BOTH); }
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using SocketHandle = int;
+static const SocketHandle kInvalidSocket = -1;
+static void closeSocket(SocketHandle s) { close(s); }
+static void shutdownSocket(SocketHandle s) { shutdown(s, SHUT_RDWR); }
+#endif
+
+// ============================================================================
+// FORMULA: Sheets the node netlist cannot express (arithmetic, SIN/COS, MIN/MAX,
+// nested calls) run as one compiled FormulaProgram instead of per-cell modules.
+// With a kernel cache set, a sheet that stays loaded is rebuilt as native code on
+// a background thread and swapped in between frames.
+// ============================================================================
+
+static std::string jsonEscape(const std::string& value);
+
+class ComputationEngine {
 public:
-    AnalogModule(std::string n) : name(n), output(0.0) {}
-    virtual ~AnalogModule() {}
-    virtual double processInput(double input) = 0;
-    double getOutput() { return output; }
-    std::string getName() { return name; }
-    virtual std::string getType() = 0;
-};
+    static const uint64_t kHotSteps = 4096;   // Steps before a native build starts
+
+    void setNativeCache(const std::string& dir) { native_cache = dir; }
+
+    void load(std::unique_ptr<FormulaProgram> next) {
+        program = std::move(next);
+        native_build.reset();                 // A build still running finishes into its own state
+        native_error.clear();
+        formula_cells.clear();
+        for (size_t i = 0; i < program->getCellCount(); i++) {
+            if (program->isFormula(i)) formula_cells.push_back(static_cast<uint32_t>(i));
+        }
+        operations = 0;
+        recalculated = 0;
+    }
+    void unload() {
+        program.reset();
+        native_build.reset();
+        native_error.clear();
+    }
+    bool isLoaded() const { return program != nullptr; }
+    FormulaProgram& getProgram() { return *program; }
+    bool isNative() const { return program && program->hasNative(); }
+    // Why the loaded sheet's native build or load failed; empty while none has
+    const std::string& getNativeError() const { return native_error; }
+
+    // Numeric cell edits; unknown and formula cells are ignored
+    void applyEdits(const std::vector<std::pair<std::string, double>>& edits) {
+        for (const auto& edit : edits) {
+            const int cell = program->findCell(edit.first);
+            if (cell >= 0) program->setValue(static_cast<size_t>(cell), edit.second);
+        }
+        recalculated += program->recalculate();
+    }
+
+    // Take over the numeric cells of `next` if it has the loaded sheet's layout
+    bool merge(const FormulaProgram& next) {
+        if (next.getLayoutHash() != program->getLayoutHash() || next.getCellCount() != program->getCellCount()) return false;
+        for (size_t i = 0; i < next.getCellCount(); i++) {
+            if (!next.isFormula(i)) program->setValue(i, next.getValue(i));
+        }
+        recalculated += program->recalculate();
+        return true;
+    }
+    uint64_t getRecalculatedCount() const { return recalculated; }
+    uint64_t getOperationCount() const { return operations; }
+
+    // One recalculation; returns the mean formula-cell value (the frame's sample)
+    double step(double dt, double input, double time) {
+        program->setInput(input);
+        program->setTime(time);
+        program->step(dt);
+        operations += program->getInstructions().size();
+        const double* values = program->getValues();
+        double total = 0.0;
+        for (uint32_t cell : formula_cells) total += values[cell];
+        return formula_cells.empty() ? 0.0 : total / static_cast<double>(formula_cells.size());
+    }
+
+    // Simulation thread, once per frame: start or finish the native build
+    void pollNative() {
+        if (!program || native_cache.empty() || program->hasNative()) return;
+        if (!native_build) {
+            if (program->getStepCount() < kHotSteps) return;
+            auto build = std::make_shared<NativeBuild>();
+            native_build = build;
+            std::thread([build, source = program->emitC(), dir = native_cache]() {
+                build->ok = FormulaProgram::buildNative(source, dir, build->library, &build->error);
+                build->done.store(true, std::memory_order_release);
+            }).detach();
+            return;
+        }
+        if (!native_build->done.load(std::memory_order_acquire) || native_build->handled) return;
+        native_build->handled = true;        // Reported once; keeps the build from being retried
+        std::string error = native_build->error;
+        if (native_build->ok && !native_build->library.empty() && program->loadNative(native_build->library, &error)) {
+            std::cout << "⚡ Formula sheet running native (" << program->getInstructions().size() << " instructions)" << std::endl;
+            return;
+        }
+        // Staying on the interpreter: say why, in the log and in every status frame
+        native_error = error.empty() ? "native build produced no library" : error;
+        std::cerr << "⚠️ Formula kernel: " << native_error << "; running interpreted" << std::endl;
+    }
+
+    std::string processCommand(std::string command) {
+        if(command == "GET_STATE") {
+            return "{\"cells\": " + std::to_string(program ? program->getCellCount() : 0) +
+                   ", \"instructions\": " + std::to_string(program ? program->getInstructions().size() : 0) +
+                   ", \"native\": " + (isNative() ? "true" : "false") +
+                   (native_error.empty() ? "" : ", \"native_error\": \"" + jsonEscape(native_error) + "\"") +
+                   ", \"status\": \"ready\"}";
+        }
+        return "{\"error\": \"unknown\"}";
+    }
 
-class Amplifier : public AnalogModule {
 private:
-    double gain;
+    struct NativeBuild {
+        std::atomic<bool> done{false};
+        bool ok = false;
+        bool handled = false;                 // Simulation thread: result already applied or reported
+        std::string library;
+        std::string error;
+    };
+
+    std::unique_ptr<FormulaProgram> program;
+    std::vector<uint32_t> formula_cells;
+    std::string native_cache;
+    std::shared_ptr<NativeBuild> native_build;
+    std::string native_error;
+    uint64_t operations = 0;
+    uint64_t recalculated = 0;                // Static instructions re-run by edits
+};
+
+// ============================================================================
+// JSON: Minimal DOM for request bodies (parameter updates and netlists are small)
+// ============================================================================
+
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object } type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* find(const std::string& key) const {
+        for (const auto& member : members) {
+            if (member.first == key) return &member.second;
+        }
+        return nullptr;
+    }
+    bool isNumber() const { return type == Type::Number; }
+};
+
+class JsonParser {
 public:
-    Amplifier(std::string n, double g) : AnalogModule(n), gain(g) {}
-    double processInput(double input) override {
-        output = input * gain;
-        return output;
+    explicit JsonParser(const std::string& source) : text(source) {}
+
+    // Returns false on malformed input or trailing garbage
+    bool parse(JsonValue& out) {
+        if (!parseValue(out, 0)) return false;
+        skipSpace();
+        return pos == text.size();
+    }
+
+private:
+    const std::string& text;
+    size_t pos = 0;
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+    }
+    bool literal(const char* word) {
+        const size_t len = std::strlen(word);
+        if (text.compare(pos, len, word) != 0) return false;
+        pos += len;
+        return true;
+    }
+    bool parseString(std::string& out) {
+        if (text[pos] != '"') return false;
+        pos++;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if (c == '\\') {
+                if (pos >= text.size()) return false;
+                const char e = text[pos++];
+                switch (e) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u':  // Keys and formulas are ASCII; non-ASCII escapes become '?'
+                        if (pos + 4 > text.size()) return false;
+                        pos += 4;
+                        c = '?';
+                        break;
+                    default: c = e; break;
+                }
+            }
+            out.push_back(c);
+        }
+        if (pos >= text.size()) return false;
+        pos++;
+        return true;
+    }
+    bool parseValue(JsonValue& out, int depth) {
+        if (depth > 32) return false;
+        skipSpace();
+        if (pos >= text.size()) return false;
+        const char c = text[pos];
+        if (c == '{') {
+            out.type = JsonValue::Type::Object;
+            pos++;
+            skipSpace();
+            if (pos < text.size() && text[pos] == '}') { pos++; return true; }
+            while (true) {
+                skipSpace();
+                std::string key;
+                if (pos >= text.size() || !parseString(key)) return false;
+                skipSpace();
+                if (pos >= text.size() || text[pos++] != ':') return false;
+                JsonValue value;
+                if (!parseValue(value, depth + 1)) return false;
+                out.members.emplace_back(std::move(key), std::move(value));
+                skipSpace();
+                if (pos >= text.size()) return false;
+                if (text[pos] == ',') { pos++; continue; }
+                if (text[pos] == '}') { pos++; return true; }
+                return false;
+            }
+        }
+        if (c == '[') {
+            out.type = JsonValue::Type::Array;
+            pos++;
+            skipSpace();
+            if (pos < text.size() && text[pos] == ']') { pos++; return true; }
+            while (true) {
+                JsonValue value;
+                if (!parseValue(value, depth + 1)) return false;
+                out.items.push_back(std::move(value));
+                skipSpace();
+                if (pos >= text.size()) return false;
+                if (text[pos] == ',') { pos++; continue; }
+                if (text[pos] == ']') { pos++; return true; }
+                return false;
+            }
+        }
+        if (c == '"') {
+            out.type = JsonValue::Type::String;
+            return parseString(out.text);
+        }
+        if (literal("true")) { out.type = JsonValue::Type::Bool; out.boolean = true; return true; }
+        if (literal("false")) { out.type = JsonValue::Type::Bool; return true; }
+        if (literal("null")) return true;
+        const char* begin = text.c_str() + pos;
+        char* end = nullptr;
+        out.number = std::strtod(begin, &end);
+        if (end == begin) return false;
+        out.type = JsonValue::Type::Number;
+        pos += static_cast<size_t>(end - begin);
+        return true;
     }
-    std::string getType() override { return "Amplifier"; }
 };
 
-class ComputationEngine {
+static std::string jsonEscape(const std::string& value) {
+    std::string out;
+    for (char c : value) {
+        if (c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if (c == '\n') out += "\\n";
+        else if (static_cast<unsigned char>(c) < 0x20) out += ' ';
+        else out += c;
+    }
+    return out;
+}
+
+// ============================================================================
+// WEBSOCKET: Handshake digest (RFC 6455 uses SHA-1 + base64 of key + GUID)
+// ============================================================================
+
+static std::string sha1Digest(const std::string& message) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    std::string data = message;
+    const uint64_t bit_length = static_cast<uint64_t>(message.size()) * 8;
+    data.push_back(static_cast<char>(0x80));
+    while (data.size() % 64 != 56) data.push_back('\0');
+    for (int k = 7; k >= 0; k--) data.push_back(static_cast<char>((bit_length >> (k * 8)) & 0xFF));
+
+    auto rotl = [](uint32_t v, int s) { return (v << s) | (v >> (32 - s)); };
+    for (size_t chunk = 0; chunk < data.size(); chunk += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++) {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data() + chunk + i * 4);
+            w[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+        }
+        for (int i = 16; i < 80; i++) w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; i++) {
+            uint32_t f, k;
+            if (i < 20) { f = (b & c) | (~b & d); k = 0x5A827999; }
+            else if (i < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+            else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+            const uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d; d = c; c = rotl(b, 30); b = a; a = temp;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+    }
+
+    std::string digest;
+    for (uint32_t word : h) {
+        for (int k = 3; k >= 0; k--) digest.push_back(static_cast<char>((word >> (k * 8)) & 0xFF));
+    }
+    return digest;
+}
+
+static std::string base64Encode(const std::string& bytes) {
+    static const char* table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    size_t i = 0;
+    for (; i + 2 < bytes.size(); i += 3) {
+        const uint32_t v = (uint32_t(uint8_t(bytes[i])) << 16) | (uint32_t(uint8_t(bytes[i + 1])) << 8) | uint8_t(bytes[i + 2]);
+        out += table[(v >> 18) & 63]; out += table[(v >> 12) & 63]; out += table[(v >> 6) & 63]; out += table[v & 63];
+    }
+    if (i + 1 == bytes.size()) {
+        const uint32_t v = uint32_t(uint8_t(bytes[i])) << 16;
+        out += table[(v >> 18) & 63]; out += table[(v >> 12) & 63]; out += "==";
+    } else if (i + 2 == bytes.size()) {
+        const uint32_t v = (uint32_t(uint8_t(bytes[i])) << 16) | (uint32_t(uint8_t(bytes[i + 1])) << 8);
+        out += table[(v >> 18) & 63]; out += table[(v >> 12) & 63]; out += table[(v >> 6) & 63]; out += '=';
+    }
+    return out;
+}
+
+static bool sendAll(SocketHandle socket, const char* data, size_t length) {
+    while (length > 0) {
+        const int chunk = static_cast<int>(std::min<size_t>(length, 1 << 20));
+#ifdef _WIN32
+        const int sent = send(socket, data, chunk, 0);
+#else
+        const ssize_t sent = send(socket, data, chunk, MSG_NOSIGNAL);
+#endif
+        if (sent <= 0) return false;
+        data += sent;
+        length -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+static bool recvExact(SocketHandle socket, char* data, size_t length) {
+    while (length > 0) {
+        const int got = static_cast<int>(recv(socket, data, static_cast<int>(length), 0));
+        if (got <= 0) return false;
+        data += got;
+        length -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+// Server-to-client frames are unmasked; FIN set, no fragmentation
+static std::string encodeWebSocketFrame(const std::string& payload, uint8_t opcode) {
+    std::string frame;
+    frame.push_back(static_cast<char>(0x80 | opcode));
+    const uint64_t length = payload.size();
+    if (length < 126) {
+        frame.push_back(static_cast<char>(length));
+    } else if (length <= 0xFFFF) {
+        frame.push_back(static_cast<char>(126));
+        frame.push_back(static_cast<char>((length >> 8) & 0xFF));
+        frame.push_back(static_cast<char>(length & 0xFF));
+    } else {
+        frame.push_back(static_cast<char>(127));
+        for (int k = 7; k >= 0; k--) frame.push_back(static_cast<char>((length >> (k * 8)) & 0xFF));
+    }
+    return frame + payload;
+}
+
+// One open WebSocket; the frame broadcaster and the client's reader both send.
+// The reader owns the socket: it detaches under send_mutex before the socket is
+// closed, so a broadcast can never write to a closed (or reused) descriptor.
+struct WebSocketClient {
+    SocketHandle socket = kInvalidSocket;
+    std::mutex send_mutex;
+    std::atomic<bool> open{true};
+
+    bool sendFrame(const std::string& payload, uint8_t opcode = 0x1) {
+        if (!open.load(std::memory_order_acquire)) return false;
+        const std::string frame = encodeWebSocketFrame(payload, opcode);
+        std::lock_guard<std::mutex> lock(send_mutex);
+        if (socket == kInvalidSocket) return false;
+        if (!sendAll(socket, frame.data(), frame.size())) {
+            open.store(false, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
+
+    void detach() {
+        std::lock_guard<std::mutex> lock(send_mutex);
+        open.store(false, std::memory_order_release);
+        socket = kInvalidSocket;
+    }
+};
+
+// ============================================================================
+// PERSISTENT ENGINE: One engine lives for the whole server run. HTTP and
+// WebSocket handlers only queue updates; the simulation thread applies them
+// between frames, so the engine itself is only ever touched by one thread.
+// ============================================================================
+
+struct EngineParameters {
+    double frequency = 1.0;         // Drive frequency in Hz
+    double amplitude = 5.0;         // Drive amplitude
+    double gain = 2.5;              // Node feedback gain (setSystemFeedback, clamped to [0.1, 10])
+    double noise = 0.0;             // Input noise standard deviation (setNoise), 0 = off
+    double time_step = 0.001;       // Simulated seconds per sample
+    double frame_rate = 30.0;       // Frames streamed per second
+    size_t steps_per_frame = 64;    // Samples simulated per frame
+    bool running = true;
+};
+
+// Netlist from the UI: either {"nodes", "controls", "inputs", "edges", "delayed"}
+// or the exportToEngine() sheet {"cells": {"A1": {"value": "=AMP(2.0,1.05)"}, ...}}
+struct CircuitRequest {
+    size_t node_count = 0;
+    AnalogCircuitGraph graph;
+    std::vector<std::string> labels;  // Node names reported back in frames (cells only)
+    std::unique_ptr<FormulaProgram> formula;  // Set instead of the netlist for formula sheets
+};
+
+static bool readTriples(const JsonValue* list, size_t width, std::vector<std::vector<double>>& out) {
+    if (!list) return true;
+    if (list->type != JsonValue::Type::Array) return false;
+    for (const JsonValue& entry : list->items) {
+        if (entry.type != JsonValue::Type::Array || entry.items.size() < width - 1 || entry.items.size() > width) return false;
+        std::vector<double> row;
+        for (const JsonValue& item : entry.items) {
+            if (!item.isNumber()) return false;
+            row.push_back(item.number);
+        }
+        if (row.size() < width) row.push_back(1.0);  // Default weight / gain
+        out.push_back(row);
+    }
+    return true;
+}
+
+// Largest netlist the server accepts
+constexpr size_t kMaxNetlistNodes = size_t(1) << 22;
+
+// Node index of a netlist row: a whole number in [0, limit)
+static bool netlistIndex(double value, size_t limit, uint32_t& index) {
+    if (!std::isfinite(value) || value < 0.0 || value >= static_cast<double>(limit) || value != std::floor(value)) {
+        return false;
+    }
+    index = static_cast<uint32_t>(value);
+    return true;
+}
+
+static bool buildNetlist(const JsonValue& body, CircuitRequest& request, std::string& error) {
+    std::vector<std::vector<double>> controls, inputs, edges, delayed;
+    if (!readTriples(body.find("controls"), 2, controls) || !readTriples(body.find("inputs"), 2, inputs) ||
+        !readTriples(body.find("edges"), 3, edges) || !readTriples(body.find("delayed"), 3, delayed)) {
+        error = "controls/inputs take [node, value] pairs, edges/delayed take [source, target, weight]";
+        return false;
+    }
+    const JsonValue* nodes = body.find("nodes");
+    if (nodes && nodes->isNumber()) {
+        uint32_t count = 0;
+        if (!netlistIndex(nodes->number, kMaxNetlistNodes + 1, count) || count == 0) {
+            error = "\"nodes\" must be a whole number in [1, 4194304]";
+            return false;
+        }
+        request.node_count = count;
+    } else {
+        // Implied by the highest index; rows are range-checked against it below
+        double highest = -1.0;
+        for (const auto* list : {&controls, &inputs}) {
+            for (const auto& row : *list) highest = std::max(highest, row[0]);
+        }
+        for (const auto* list : {&edges, &delayed}) {
+            for (const auto& row : *list) highest = std::max({highest, row[0], row[1]});
+        }
+        if (highest < 0.0 || highest >= static_cast<double>(kMaxNetlistNodes)) {
+            error = "node indices must lie in [0, nodes) with 0 < nodes <= 4194304";
+            return false;
+        }
+        request.node_count = static_cast<size_t>(highest) + 1;
+    }
+
+    // Every row: whole-number indices in [0, nodes), finite values, accepted by the graph
+    auto reject = [&](const char* list, size_t row, const char* problem) {
+        std::ostringstream message;
+        message << list << "[" << row << "]: " << problem << " (nodes = " << request.node_count << ")";
+        error = message.str();
+        return false;
+    };
+    request.graph = AnalogCircuitGraph(request.node_count);
+    const std::pair<const char*, const std::vector<std::vector<double>>*> settings[] = {{"controls", &controls},
+                                                                                       {"inputs", &inputs}};
+    for (const auto& list : settings) {
+        for (size_t i = 0; i < list.second->size(); i++) {
+            const auto& row = (*list.second)[i];
+            uint32_t node = 0;
+            if (!netlistIndex(row[0], request.node_count, node)) {
+                return reject(list.first, i, "node index must be a whole number in [0, nodes)");
+            }
+            if (!std::isfinite(row[1])) return reject(list.first, i, "value is not finite");
+            const bool applied = list.second == &controls ? request.graph.setControl(node, row[1])
+                                                          : request.graph.setExternalInput(node, row[1]);
+            if (!applied) return reject(list.first, i, "rejected by the netlist");
+        }
+    }
+    const std::pair<const char*, const std::vector<std::vector<double>>*> wiring[] = {{"edges", &edges},
+                                                                                     {"delayed", &delayed}};
+    for (const auto& list : wiring) {
+        for (size_t i = 0; i < list.second->size(); i++) {
+            const auto& row = (*list.second)[i];
+            uint32_t source = 0, target = 0;
+            if (!netlistIndex(row[0], request.node_count, source) || !netlistIndex(row[1], request.node_count, target)) {
+                return reject(list.first, i, "source and target must be whole numbers in [0, nodes)");
+            }
+            if (!std::isfinite(row[2])) return reject(list.first, i, "weight is not finite");
+            const bool applied = list.second == &edges ? request.graph.connect(source, target, row[2])
+                                                       : request.graph.connectDelayed(source, target, row[2]);
+            if (!applied) return reject(list.first, i, "rejected by the netlist");
+        }
+    }
+    return true;
+}
+
+// Compile {"A1": {"formula": "=..."} | {"value": ...} | "=..." | number, ...} as a formula sheet
+static bool buildFormulaSheet(const JsonValue& cells, CircuitRequest& request, std::string& error) {
+    if (cells.type != JsonValue::Type::Object) {
+        error = "\"cells\" must be an object";
+        return false;
+    }
+    std::vector<FormulaCell> sheet;
+    sheet.reserve(cells.members.size());
+    for (const auto& member : cells.members) {
+        const JsonValue* content = &member.second;
+        if (content->type == JsonValue::Type::Object) {
+            const JsonValue* formula = content->find("formula");
+            content = formula && formula->type == JsonValue::Type::String && !formula->text.empty() ? formula
+                                                                                                    : content->find("value");
+        }
+        FormulaCell cell{member.first, std::string()};
+        if (content && content->type == JsonValue::Type::String) {
+            cell.text = content->text;
+        } else if (content && content->isNumber()) {
+            std::ostringstream number;
+            number << std::setprecision(17) << content->number;
+            cell.text = number.str();
+        }
+        sheet.push_back(std::move(cell));
+    }
+    auto program = std::make_unique<FormulaProgram>();
+    if (!program->compile(sheet, &error)) return false;
+    request.node_count = 0;
+    request.labels.clear();
+    for (size_t i = 0; i < program->getCellCount(); i++) request.labels.push_back(program->getCellId(i));
+    request.formula = std::move(program);
+    return true;
+}
+
+class EngineSession {
+public:
+    EngineSession(size_t node_count, const AnalogEngineConfig& engine_config)
+        : config(engine_config), engine(std::make_unique<AnalogCellularEngine>(node_count, engine_config)) {
+        engine->setSystemFeedback(parameters.gain);
+        engine->setTimeStep(parameters.time_step);
+        engine->setNoise(parameters.noise);
+    }
+
+    // Merge the numeric / bool fields present in `body`; false if none were recognised
+    bool queueParameters(const JsonValue& body, std::string& error) {
+        if (body.type != JsonValue::Type::Object) {
+            error = "expected a JSON object";
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        EngineParameters next = parameters;
+        bool recognised = false;
+        auto number = [&](const char* key, double low, double high, double& target) {
+            const JsonValue* value = body.find(key);
+            if (!value) return;
+            double parsed = value->number;
+            if (value->type == JsonValue::Type::String) parsed = std::strtod(value->text.c_str(), nullptr);
+            else if (!value->isNumber()) return;
+            if (!std::isfinite(parsed)) return;
+            target = std::clamp(parsed, low, high);
+            recognised = true;
+        };
+        double steps = static_cast<double>(next.steps_per_frame);
+        number("frequency", 0.0, 1.0e6, next.frequency);
+        number("amplitude", -1.0e6, 1.0e6, next.amplitude);
+        number("gain", 0.1, 10.0, next.gain);
+        number("noise", 0.0, 10.0, next.noise);
+        number("time_step", 1.0e-9, 1.0, next.time_step);
+        number("fps", 1.0, 240.0, next.frame_rate);
+        number("frame_rate", 1.0, 240.0, next.frame_rate);
+        number("steps_per_frame", 1.0, 65536.0, steps);
+        next.steps_per_frame = static_cast<size_t>(steps);
+        if (const JsonValue* running = body.find("running")) {
+            if (running->type == JsonValue::Type::Bool) {
+                next.running = running->boolean;
+                recognised = true;
+            }
+        }
+        if (const JsonValue* reset = body.find("reset")) {
+            if (reset->type == JsonValue::Type::Bool && reset->boolean) {
+                pending_reset = true;
+                recognised = true;
+            }
+        }
+        if (!recognised) {
+            error = "no known parameter (frequency, amplitude, gain, noise, time_step, fps, steps_per_frame, running, reset)";
+            return false;
+        }
+        parameters = next;
+        parameters_dirty = true;
+        return true;
+    }
+
+    // `raw` is the request text: sheets are re-scanned by the streaming loader
+    bool queueCircuit(const JsonValue& body, const std::string& raw, std::string& error) {
+        if (body.type != JsonValue::Type::Object) {
+            error = "expected a JSON object";
+            return false;
+        }
+        auto request = std::make_unique<CircuitRequest>();
+        const JsonValue* clear = body.find("clear");
+        if (clear && clear->type == JsonValue::Type::Bool && clear->boolean) {
+            request->node_count = 0;  // Back to free-running sweep mode
+        } else if (const JsonValue* cells = body.find("cells")) {
+            // Analog netlist when every cell maps onto a node, otherwise a formula program
+            SheetCircuit sheet;
+            if (parseSheetCircuit(raw.data(), raw.size(), sheet, &error)) {
+                sheetRequest(sheet, *request);
+            } else if (!buildFormulaSheet(*cells, *request, error)) {
+                return false;
+            }
+        } else if (!buildNetlist(body, *request, error)) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        pending_circuit = std::move(request);
+        return true;
+    }
+
+    // Spreadsheet edits {"cells": {"B1": 2.5, ...}} for the loaded formula sheet: only
+    // the cells downstream of an edited value are recalculated
+    bool queueCellEdits(const JsonValue& body, std::string& error) {
+        const JsonValue* cells = body.find("cells");
+        if (!cells || cells->type != JsonValue::Type::Object) {
+            error = "expected {\"cells\": {\"A1\": number, ...}}";
+            return false;
+        }
+        std::vector<std::pair<std::string, double>> edits;
+        for (const auto& member : cells->members) {
+            const JsonValue* value = &member.second;
+            if (value->type == JsonValue::Type::Object) value = value->find("value");
+            double number = 0.0;
+            bool numeric = value && value->isNumber();
+            if (numeric) {
+                number = value->number;
+            } else if (value && value->type == JsonValue::Type::String) {
+                char* end = nullptr;
+                number = std::strtod(value->text.c_str(), &end);
+                numeric = end != value->text.c_str() && *end == '\0' && std::isfinite(number);
+            }
+            if (!numeric) {
+                error = "cell " + member.first + " is not a number (formula edits go to /api/circuit)";
+                return false;
+            }
+            edits.emplace_back(member.first, number);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        pending_edits.insert(pending_edits.end(), edits.begin(), edits.end());
+        return true;
+    }
+
+    // Startup circuit from an engine_input.json file (memory-mapped, streamed)
+    bool queueCircuitFile(const std::string& path, std::string& error) {
+        auto request = std::make_unique<CircuitRequest>();
+        SheetCircuit sheet;
+        if (loadSheetCircuit(path, sheet, &error)) {
+            sheetRequest(sheet, *request);
+        } else {
+            std::ifstream file(path, std::ios::binary);
+            const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            JsonValue body;
+            const JsonValue* cells = JsonParser(text).parse(body) ? body.find("cells") : nullptr;
+            if (!cells || !buildFormulaSheet(*cells, *request, error)) return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        pending_circuit = std::move(request);
+        return true;
+    }
+
+    EngineParameters getParameters() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return parameters;
+    }
+
+    // Optional binary sink: every frame's node outputs (ID order) for local readers
+    void setResultsChannel(ResultsChannelWriter* channel) { results = channel; }
+
+    // Native kernel cache for hot formula sheets (before the simulation thread starts)
+    void setFormulaCache(const std::string& dir) { sheet.setNativeCache(dir); }
+
+    // Event-driven circuit steps with this input tolerance; negative = evaluate every node
+    void setEventTolerance(double tolerance) { event_tolerance = tolerance; }
+
+    std::string getLastFrame() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return last_frame;
+    }
+
+    // Simulation thread: apply queued updates, advance one frame, return its JSON
+    std::string stepFrame() {
+        EngineParameters frame_parameters;
+        std::unique_ptr<CircuitRequest> circuit_request;
+        std::vector<std::pair<std::string, double>> edits;
+        bool apply_parameters = false, reset = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            frame_parameters = parameters;
+            apply_parameters = parameters_dirty;
+            reset = pending_reset;
+            circuit_request = std::move(pending_circuit);
+            edits.swap(pending_edits);
+            parameters_dirty = pending_reset = false;
+        }
+
+        if (circuit_request) applyCircuit(*circuit_request);
+        if (!edits.empty() && sheet.isLoaded()) sheet.applyEdits(edits);
+        if (apply_parameters || circuit_request) {
+            engine->setSystemFeedback(frame_parameters.gain);
+            engine->setNoise(frame_parameters.noise);
+            engine->setTimeStep(frame_parameters.time_step);
+        }
+        if (reset) {
+            engine->reset();
+            engine->resetAllIntegrators();
+            if (sheet.isLoaded()) sheet.getProgram().reset();
+        }
+
+        const size_t steps = frame_parameters.running ? frame_parameters.steps_per_frame : 0;
+        samples.resize(steps);
+        const auto start = std::chrono::steady_clock::now();
+        if (steps > 0) simulate(frame_parameters, steps);
+        const double compute_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        if (results) publishResults(compute_ns);
+        std::string frame = formatFrame(frame_parameters, steps, compute_ns);
+        std::lock_guard<std::mutex> lock(mutex);
+        last_frame = frame;
+        return frame;
+    }
+
 private:
-    std::map<std::string, std::unique_ptr<AnalogModule>> modules;
-    
+    std::mutex mutex;                        // Guards everything below up to `engine`
+    EngineParameters parameters;
+    bool parameters_dirty = false;
+    bool pending_reset = false;
+    std::unique_ptr<CircuitRequest> pending_circuit;
+    std::vector<std::pair<std::string, double>> pending_edits;
+    std::string last_frame = "{\"type\": \"frame\", \"frame\": 0}";
+
+    static void sheetRequest(SheetCircuit& sheet, CircuitRequest& request) {
+        request.node_count = sheet.getNodeCount();
+        request.graph = std::move(sheet.graph);
+        request.labels.reserve(request.node_count);
+        for (size_t v = 0; v < request.node_count; v++) request.labels.push_back(sheet.label(v));
+    }
+
+    // Simulation thread only
+    AnalogEngineConfig config;
+    double event_tolerance = -1.0;
+    std::unique_ptr<AnalogCellularEngine> engine;
+    std::vector<std::string> labels;
+    std::vector<double> inputs;
+    std::vector<double> controls;
+    std::vector<double> samples;
+    uint64_t frame_index = 0;
+    std::string circuit_message = "sweep";
+    ResultsChannelWriter* results = nullptr;
+    ComputationEngine sheet;                 // Formula mode when loaded
+
+    size_t outputCount() { return sheet.isLoaded() ? sheet.getProgram().getCellCount() : engine->getNodeCount(); }
+    double outputValue(size_t i) {
+        return sheet.isLoaded() ? sheet.getProgram().getValue(i) : engine->getNode(i).getOutput();
+    }
+
+    // ZERO-COPY: Node outputs are written straight into the mapped slot
+    void publishResults(double compute_ns) {
+        const size_t node_count = outputCount();
+        const size_t stored = std::min(node_count, results->capacity());
+        double* payload = static_cast<double*>(results->beginRecord());
+        if (sheet.isLoaded()) {
+            std::memcpy(payload, sheet.getProgram().getValues(), stored * sizeof(double));
+        } else {
+            const double* outputs = engine->getNodeStorage().current_output;
+            for (size_t i = 0; i < stored; i++) {
+                payload[i] = outputs[engine->getNodeSlot(static_cast<uint32_t>(i))];
+            }
+        }
+        ResultsRecordInfo info;
+        info.frame = frame_index + 1;
+        info.nodes_computed = node_count;
+        info.time = engine->getClock().now();
+        info.compute_ms = compute_ns / 1.0e6;
+        results->commitRecord(node_count, info);
+    }
+
+    void applyCircuit(CircuitRequest& request) {
+        // Same sheet with new numbers: keep the program, its state and kernel; recalc the edits
+        if (request.formula && sheet.isLoaded() && sheet.merge(*request.formula)) return;
+        sheet.unload();
+        if (request.formula) {
+            engine->clearCircuit();
+            sheet.load(std::move(request.formula));
+            labels = std::move(request.labels);
+            circuit_message = "formula";
+            return;
+        }
+        if (request.node_count == 0) {
+            engine->clearCircuit();
+            labels.clear();
+            circuit_message = "sweep";
+            return;
+        }
+        // The engine is rebuilt only when the netlist needs a different node count
+        if (request.node_count != engine->getNodeCount()) {
+            const double now = engine->getClock().now();
+            engine = std::make_unique<AnalogCellularEngine>(request.node_count, config);
+            engine->reset(now);
+        }
+        engine->resetAllIntegrators();
+        labels = std::move(request.labels);
+        circuit_message = engine->setCircuit(std::move(request.graph)) ? "circuit" : "sweep";
+        engine->setEventDriven(event_tolerance >= 0.0, event_tolerance);
+    }
+
+    void simulate(const EngineParameters& p, size_t steps) {
+        const double omega = 2.0 * M_PI * p.frequency;
+        if (sheet.isLoaded()) {
+            for (size_t t = 0; t < steps; t++) {
+                const double time = engine->advance(p.time_step);
+                samples[t] = sheet.step(p.time_step, p.amplitude * std::sin(omega * time), time);
+            }
+            sheet.pollNative();
+            return;
+        }
+        if (engine->hasCircuit()) {
+            for (size_t t = 0; t < steps; t++) {
+                const double time = engine->advance(p.time_step);
+                samples[t] = engine->processCircuitStep(p.amplitude * std::sin(omega * time));
+            }
+            return;
+        }
+        // Free-running mode: the sweep's drive and control pattern, one parallel region per frame
+        inputs.resize(steps);
+        controls.resize(steps);
+        for (size_t t = 0; t < steps; t++) {
+            const double time = engine->advance(p.time_step);
+            inputs[t] = p.amplitude * std::sin(omega * time);
+            controls[t] = std::sin(time * 0.1) * 0.5;
+        }
+        engine->processSignalBlock(inputs.data(), controls.data(), steps, samples.data());
+    }
+
+    std::string formatFrame(const EngineParameters& p, size_t steps, double compute_ns) {
+        const size_t node_count = outputCount();
+        const size_t shown = std::min<size_t>(node_count, 16);
+        std::ostringstream out;
+        out << std::setprecision(9);
+        out << "{\"type\": \"frame\", \"frame\": " << ++frame_index << ", \"time\": " << engine->getClock().now()
+            << ", \"mode\": \"" << circuit_message << "\", \"node_count\": " << node_count
+            << ", \"steps\": " << steps << ", \"compute_ns\": " << compute_ns
+            << ", \"ns_per_step\": " << (steps ? compute_ns / steps : 0.0)
+            << ", \"operations\": " << (sheet.isLoaded() ? sheet.getOperationCount() : engine->getOperationCount())
+            << ", \"parameters\": {\"frequency\": " << p.frequency << ", \"amplitude\": " << p.amplitude
+            << ", \"gain\": " << p.gain << ", \"noise\": " << p.noise << ", \"time_step\": " << p.time_step << ", \"fps\": " << p.frame_rate
+            << ", \"steps_per_frame\": " << p.steps_per_frame << ", \"running\": " << (p.running ? "true" : "false")
+            << "}, \"output\": " << (steps ? samples[steps - 1] : 0.0) << ", \"samples\": [";
+        for (size_t t = 0; t < steps; t++) out << (t ? ", " : "") << samples[t];
+        out << "], \"nodes\": [";
+        for (size_t i = 0; i < shown; i++) {
+            out << (i ? ", " : "") << outputValue(i);
+        }
+        out << "]";
+        if (!labels.empty()) {
+            // Formula sheets report computed cells only; numeric inputs stay the UI's
+            out << ", \"cells\": {";
+            bool first = true;
+            for (size_t i = 0; i < labels.size() && i < node_count; i++) {
+                if (sheet.isLoaded() && !sheet.getProgram().isFormula(i)) continue;
+                out << (first ? "" : ", ") << "\"" << jsonEscape(labels[i]) << "\": " << outputValue(i);
+                first = false;
+            }
+            out << "}";
+        }
+        if (sheet.isLoaded()) {
+            out << ", \"recalculated\": " << sheet.getRecalculatedCount()
+                << ", \"native\": " << (sheet.isNative() ? "true" : "false");
+            if (!sheet.getNativeError().empty()) {
+                out << ", \"native_error\": \"" << jsonEscape(sheet.getNativeError()) << "\"";
+            }
+        }
+        out << "}";
+        return out.str();
+    }
+};
+
+// ============================================================================
+// HTTP: One short-lived thread per connection; WebSocket upgrades stay open
+// ============================================================================
+
+struct ServerOptions {
+    uint16_t port = 8080;
+    std::string bind_address = "127.0.0.1";
+    std::string web_root = "web";
+    size_t nodes = 100;
+    size_t threads = 0;
+    double fps = 30.0;
+    size_t steps_per_frame = 64;
+    std::string results_channel;    // Empty = no binary results sink
+    size_t results_capacity = 65536;
+    std::string circuit_file;       // engine_input.json to load at startup
+    std::string formula_cache;      // Directory for native formula kernels; empty = interpreter only
+    std::string autotune_cache;     // Tuning CSV: benchmark thread count / schedule once per host and size
+    double event_tolerance = -1.0;  // >= 0: circuits re-evaluate only nodes whose input moved (setEventDriven)
+};
+
+struct HttpRequest {
+    std::string method;
+    std::string path;
+    std::map<std::string, std::string> headers;  // Lower-case names
+    std::string body;
+};
+
+static const size_t kMaxHeaderBytes = 64 * 1024;
+static const size_t kMaxBodyBytes = 16 * 1024 * 1024;
+
+static std::atomic<bool> g_running{true};
+
+class WebServer {
 public:
-    void addModule(std::string id, std::unique_ptr<AnalogModule> module) {
-        modules[id] = std::move(module);
+    WebServer(const ServerOptions& server_options, EngineSession& engine_session)
+        : options(server_options), session(engine_session) {}
+
+    bool start() {
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        if (listener == kInvalidSocket) return false;
+        int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(options.port);
+        if (inet_pton(AF_INET, options.bind_address.c_str(), &address.sin_addr) != 1 ||
+            bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 64) != 0) {
+            closeSocket(listener);
+            listener = kInvalidSocket;
+            return false;
+        }
+        return true;
     }
-    
-    std::string processCommand(std::string command) {
-        if(command == "GET_STATE") {
-            return "{\"modules\": 2, \"status\": \"ready\"}";
+
+    // Accept until g_running drops; the simulation thread streams frames meanwhile
+    void run() {
+        std::thread simulation([this] { simulationLoop(); });
+        while (g_running.load()) {
+            fd_set readable;
+            FD_ZERO(&readable);
+            FD_SET(listener, &readable);
+            timeval timeout = {0, 200000};
+            if (select(static_cast<int>(listener + 1), &readable, nullptr, nullptr, &timeout) <= 0) continue;
+            const SocketHandle client = accept(listener, nullptr, nullptr);
+            if (client == kInvalidSocket) continue;
+            int no_delay = 1;
+            setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&no_delay), sizeof(no_delay));
+            startConnection(client);
         }
-        else if(command.substr(0, 10) == "ADD_MODULE") {
-            return "{\"status\": \"success\"}";
+        simulation.join();
+        closeSocket(listener);
+        {
+            std::lock_guard<std::mutex> lock(clients_mutex);
+            for (auto& client : clients) {
+                client->sendFrame(std::string("\x03\xE8", 2), 0x8);  // Close, 1000 going away
+                client->open.store(false);
+            }
         }
-        return "{\"error\": \"unknown\"}";
+        // Handlers reference this server and the session: wake any blocked in recv
+        // and wait for all of them before the caller may destroy either
+        std::list<Connection> remaining;
+        {
+            std::lock_guard<std::mutex> lock(connections_mutex);
+            for (Connection& connection : connections) {
+                if (!connection.finished) shutdownSocket(connection.socket);
+            }
+            remaining.splice(remaining.end(), connections);  // Elements stay where the handlers see them
+        }
+        for (Connection& connection : remaining) connection.thread.join();
+    }
+
+private:
+    ServerOptions options;
+    EngineSession& session;
+    SocketHandle listener = kInvalidSocket;
+    std::mutex clients_mutex;
+    std::vector<std::shared_ptr<WebSocketClient>> clients;
+
+    // CONNECTIONS: One handler thread per accepted socket, joined by run(). The
+    // socket is closed under connections_mutex as the handler finishes, so run()
+    // only ever shuts down descriptors that are still open.
+    struct Connection {
+        std::thread thread;
+        SocketHandle socket = kInvalidSocket;
+        bool finished = false;
+    };
+    std::mutex connections_mutex;
+    std::list<Connection> connections;
+
+    void startConnection(SocketHandle socket) {
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        // Reap handlers that are done; they no longer need the lock to exit
+        for (auto it = connections.begin(); it != connections.end();) {
+            if (!it->finished) {
+                ++it;
+                continue;
+            }
+            it->thread.join();
+            it = connections.erase(it);
+        }
+        connections.emplace_back();
+        Connection& connection = connections.back();
+        connection.socket = socket;
+        connection.thread = std::thread([this, &connection] {
+            handleConnection(connection.socket);
+            std::lock_guard<std::mutex> finish_lock(connections_mutex);
+            closeSocket(connection.socket);
+            connection.finished = true;
+        });
+    }
+
+    // STREAMING: Fixed frame clock; a slow frame delays the next one instead of bursting
+    void simulationLoop() {
+        auto next_frame = std::chrono::steady_clock::now();
+        while (g_running.load()) {
+            const std::string frame = session.stepFrame();
+            broadcast(frame);
+            const double fps = session.getParameters().frame_rate;
+            next_frame += std::chrono::microseconds(static_cast<int64_t>(1.0e6 / fps));
+            const auto now = std::chrono::steady_clock::now();
+            if (next_frame < now) next_frame = now;
+            std::this_thread::sleep_until(next_frame);
+        }
+    }
+
+    void broadcast(const std::string& frame) {
+        std::vector<std::shared_ptr<WebSocketClient>> targets;
+        {
+            std::lock_guard<std::mutex> lock(clients_mutex);
+            clients.erase(std::remove_if(clients.begin(), clients.end(),
+                                         [](const std::shared_ptr<WebSocketClient>& c) { return !c->open.load(); }),
+                          clients.end());
+            targets = clients;
+        }
+        for (auto& client : targets) client->sendFrame(frame);
+    }
+
+    static bool readRequest(SocketHandle socket, HttpRequest& request) {
+        std::string buffer;
+        size_t header_end = std::string::npos;
+        char chunk[4096];
+        while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+            if (buffer.size() > kMaxHeaderBytes) return false;
+            const int got = static_cast<int>(recv(socket, chunk, sizeof(chunk), 0));
+            if (got <= 0) return false;
+            buffer.append(chunk, static_cast<size_t>(got));
+        }
+        std::istringstream head(buffer.substr(0, header_end));
+        std::string line;
+        std::getline(head, line);
+        std::istringstream request_line(line);
+        std::string version;
+        request_line >> request.method >> request.path >> version;
+        if (request.method.empty() || request.path.empty()) return false;
+        while (std::getline(head, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            const size_t colon = line.find(':');
+            if (colon == std::string::npos) continue;
+            std::string name = line.substr(0, colon);
+            std::transform(name.begin(), name.end(), name.begin(),
+                           [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+            size_t value_begin = colon + 1;
+            while (value_begin < line.size() && line[value_begin] == ' ') value_begin++;
+            request.headers[name] = line.substr(value_begin);
+        }
+        request.body = buffer.substr(header_end + 4);
+        const auto length = request.headers.find("content-length");
+        if (length != request.headers.end()) {
+            const size_t expected = static_cast<size_t>(std::strtoull(length->second.c_str(), nullptr, 10));
+            if (expected > kMaxBodyBytes) return false;
+            if (request.body.size() < expected) {
+                const size_t already = request.body.size();
+                request.body.resize(expected);
+                if (!recvExact(socket, &request.body[already], expected - already)) return false;
+            }
+            request.body.resize(expected);
+        }
+        return true;
+    }
+
+    static void respond(SocketHandle socket, int status, const std::string& content_type, const std::string& body) {
+        const char* reason = status == 200 ? "OK" : status == 204 ? "No Content" : status == 400 ? "Bad Request"
+                           : status == 404 ? "Not Found" : status == 405 ? "Method Not Allowed" : "Error";
+        std::ostringstream out;
+        out << "HTTP/1.1 " << status << " " << reason << "\r\n"
+            << "Content-Type: " << content_type << "\r\n"
+            << "Content-Length: " << body.size() << "\r\n"
+            << "Access-Control-Allow-Origin: *\r\n"
+            << "Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n"
+            << "Access-Control-Allow-Headers: Content-Type\r\n"
+            << "Cache-Control: no-store\r\n"
+            << "Connection: close\r\n\r\n"
+            << body;
+        const std::string response = out.str();
+        sendAll(socket, response.data(), response.size());
+    }
+
+    static void respondJson(SocketHandle socket, int status, const std::string& body) {
+        respond(socket, status, "application/json", body);
+    }
+
+    // "circuit", "cells" (numeric cell edits) or anything else for parameters
+    bool queueUpdate(const std::string& kind, const JsonValue& body, const std::string& raw, std::string& error) {
+        if (kind == "circuit") return session.queueCircuit(body, raw, error);
+        if (kind == "cells") return session.queueCellEdits(body, error);
+        return session.queueParameters(body, error);
+    }
+
+    static std::string errorJson(const std::string& message) {
+        return "{\"status\": \"error\", \"error\": \"" + jsonEscape(message) + "\"}";
+    }
+
+    // Serves one request or WebSocket session; startConnection() closes the socket
+    void handleConnection(SocketHandle socket) {
+        HttpRequest request;
+        if (!readRequest(socket, request)) return;
+        std::string path = request.path.substr(0, request.path.find('?'));
+
+        const auto upgrade = request.headers.find("upgrade");
+        if (path == "/ws" && upgrade != request.headers.end()) {
+            serveWebSocket(socket, request);
+            return;
+        }
+
+        if (request.method == "OPTIONS") {
+            respond(socket, 204, "text/plain", "");
+        } else if (path == "/api/state" || path == "/web_results.json") {
+            respondJson(socket, 200, session.getLastFrame());
+        } else if (path == "/api/params" || path == "/api/parameters" || path == "/api/circuit" || path == "/api/cells") {
+            if (request.method != "POST") {
+                respondJson(socket, 405, errorJson("POST a JSON body"));
+            } else {
+                JsonValue body;
+                std::string error;
+                JsonParser parser(request.body);
+                const bool ok = parser.parse(body) && queueUpdate(path.substr(5), body, request.body, error);
+                if (ok) respondJson(socket, 200, "{\"status\": \"queued\"}");
+                else respondJson(socket, 400, errorJson(error.empty() ? "malformed JSON" : error));
+            }
+        } else if (request.method == "GET") {
+            serveFile(socket, path == "/" ? "/index.html" : path);
+        } else {
+            respondJson(socket, 404, errorJson("unknown endpoint"));
+        }
+    }
+
+    void serveFile(SocketHandle socket, const std::string& path) {
+        if (path.find("..") != std::string::npos || path.find('\\') != std::string::npos) {
+            respondJson(socket, 404, errorJson("not found"));
+            return;
+        }
+        std::ifstream file(options.web_root + path, std::ios::binary);
+        if (!file) {
+            respondJson(socket, 404, errorJson("not found"));
+            return;
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        const size_t dot = path.rfind('.');
+        const std::string extension = dot == std::string::npos ? "" : path.substr(dot);
+        const std::string type = extension == ".html" ? "text/html; charset=utf-8"
+                               : extension == ".js" ? "application/javascript"
+                               : extension == ".css" ? "text/css"
+                               : extension == ".json" ? "application/json" : "application/octet-stream";
+        respond(socket, 200, type, contents.str());
+    }
+
+    void serveWebSocket(SocketHandle socket, const HttpRequest& request) {
+        const auto key = request.headers.find("sec-websocket-key");
+        if (key == request.headers.end()) {
+            respondJson(socket, 400, errorJson("missing Sec-WebSocket-Key"));
+            return;
+        }
+        const std::string accept = base64Encode(sha1Digest(key->second + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"));
+        const std::string handshake = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                      "Sec-WebSocket-Accept: " + accept + "\r\n\r\n";
+        if (!sendAll(socket, handshake.data(), handshake.size())) return;
+
+        auto client = std::make_shared<WebSocketClient>();
+        client->socket = socket;
+        client->sendFrame(session.getLastFrame());
+        {
+            std::lock_guard<std::mutex> lock(clients_mutex);
+            clients.push_back(client);
+        }
+
+        // Client messages: text frames are parameter or circuit updates ({"type": "circuit", ...})
+        std::string message;
+        while (client->open.load() && g_running.load()) {
+            unsigned char header[2];
+            if (!recvExact(socket, reinterpret_cast<char*>(header), 2)) break;
+            const bool fin = (header[0] & 0x80) != 0;
+            const uint8_t opcode = header[0] & 0x0F;
+            uint64_t length = header[1] & 0x7F;
+            if (length >= 126) {
+                unsigned char extended[8];
+                const size_t bytes = length == 126 ? 2 : 8;
+                if (!recvExact(socket, reinterpret_cast<char*>(extended), bytes)) break;
+                length = 0;
+                for (size_t k = 0; k < bytes; k++) length = (length << 8) | extended[k];
+            }
+            if (length > kMaxBodyBytes || message.size() + length > kMaxBodyBytes) break;
+            unsigned char mask[4] = {0, 0, 0, 0};
+            if ((header[1] & 0x80) && !recvExact(socket, reinterpret_cast<char*>(mask), 4)) break;
+            std::string payload(static_cast<size_t>(length), '\0');
+            if (length && !recvExact(socket, &payload[0], payload.size())) break;
+            for (size_t k = 0; k < payload.size(); k++) payload[k] = static_cast<char>(payload[k] ^ mask[k & 3]);
+
+            if (opcode == 0x8) {
+                client->sendFrame(payload.substr(0, 2), 0x8);
+                break;
+            }
+            if (opcode == 0x9) {
+                client->sendFrame(payload, 0xA);
+                continue;
+            }
+            if (opcode == 0xA) continue;
+            message += payload;
+            if (!fin) continue;
+
+            JsonValue body;
+            std::string error;
+            if (!JsonParser(message).parse(body)) {
+                message.clear();
+                client->sendFrame(errorJson("malformed JSON"));
+                continue;
+            }
+            const JsonValue* type = body.find("type");
+            const std::string kind = type && type->type == JsonValue::Type::String ? type->text : "params";
+            if (!queueUpdate(kind, body, message, error)) {
+                client->sendFrame(errorJson(error));
+            }
+            message.clear();
+        }
+        client->detach();
     }
 };
 
-int main() {
+static bool parseOptions(int argc, char** argv, ServerOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h") return false;
+        if (!value) return false;
+        if (arg == "--port") options.port = static_cast<uint16_t>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--bind") options.bind_address = value;
+        else if (arg == "--web-root") options.web_root = value;
+        else if (arg == "--nodes") options.nodes = std::max<size_t>(1, std::strtoull(value, nullptr, 10));
+        else if (arg == "--threads") options.threads = std::strtoull(value, nullptr, 10);
+        else if (arg == "--fps") options.fps = std::clamp(std::strtod(value, nullptr), 1.0, 240.0);
+        else if (arg == "--steps-per-frame") options.steps_per_frame = std::clamp<size_t>(std::strtoull(value, nullptr, 10), 1, 65536);
+        else if (arg == "--results-channel") options.results_channel = value;
+        else if (arg == "--circuit") options.circuit_file = value;
+        else if (arg == "--formula-cache") options.formula_cache = value;
+        else if (arg == "--autotune") options.autotune_cache = value;
+        else if (arg == "--event-tolerance") options.event_tolerance = std::strtod(value, nullptr);
+        else if (arg == "--results-capacity") options.results_capacity = std::max<size_t>(1, std::strtoull(value, nullptr, 10));
+        else return false;
+        i++;
+    }
+    return true;
+}
+
+static void handleSignal(int) { g_running.store(false); }
+
+int main(int argc, char** argv) {
+    ServerOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: webserver [--port 8080] [--bind 127.0.0.1] [--web-root web] [--nodes 100]\n"
+                     "                 [--threads 0] [--fps 30] [--steps-per-frame 64]\n"
+                     "                 [--results-channel web_results.bin] [--results-capacity 65536]\n"
+                     "                 [--circuit engine_input.json] [--formula-cache DIR]\n"
+                     "                 [--autotune tuning.csv] [--event-tolerance 1e-9]" << std::endl;
+        return 2;
+    }
+
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return 1;
+#endif
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    AnalogEngineConfig engine_config;
+    engine_config.num_threads = options.threads;
+    if (!options.autotune_cache.empty()) {
+        EngineAutotuneOptions tune_options;
+        tune_options.cache_path = options.autotune_cache;
+        const EngineTuning tuning = autotuneEngine<double>(options.nodes, engine_config, AnalogLatticeLayout(), tune_options);
+        tuning.apply(engine_config);
+        std::string choice = "sequential";
+        if (!tuning.sequential_below) {
+            choice = std::to_string(tuning.threads) + " threads, " +
+                     (tuning.schedule == EngineSchedule::Static ? "static" : "dynamic x" + std::to_string(tuning.chunk));
+        }
+        std::cout << "⚙️  Autotune: " << choice << ", " << tuning.wave_ns / 1000.0 << " us/wave"
+                  << (tuning.cached ? " (cached)" : "") << std::endl;
+    }
+    EngineSession session(options.nodes, engine_config);
+    JsonValue initial;
+    JsonParser("{\"fps\": " + std::to_string(options.fps) + ", \"steps_per_frame\": " +
+               std::to_string(options.steps_per_frame) + "}").parse(initial);
+    std::string error;
+    session.queueParameters(initial, error);
+    session.setFormulaCache(options.formula_cache);
+    session.setEventTolerance(options.event_tolerance);
+    if (!options.circuit_file.empty() && !session.queueCircuitFile(options.circuit_file, error)) {
+        std::cerr << "❌ Cannot load circuit " << options.circuit_file << ": " << error << std::endl;
+        return 1;
+    }
+
+    ResultsChannelWriter results;
+    if (!options.results_channel.empty()) {
+        if (!results.create(options.results_channel, options.results_capacity, 4, ResultsPrecision::Float64)) {
+            std::cerr << "❌ Cannot map results channel " << options.results_channel << std::endl;
+            return 1;
+        }
+        session.setResultsChannel(&results);
+    }
+
+    WebServer server(options, session);
+    if (!server.start()) {
+        std::cerr << "❌ Cannot listen on " << options.bind_address << ":" << options.port << std::endl;
+        return 1;
+    }
+
     std::cout << "D-ASE Web Interface Ready!" << std::endl;
-    
-    ComputationEngine engine;
-    std::cout << "Response: " << engine.processCommand("GET_STATE") << std::endl;
-    
+    std::cout << "  UI        http://" << options.bind_address << ":" << options.port << "/" << std::endl;
+    std::cout << "  Stream    ws://" << options.bind_address << ":" << options.port << "/ws ("
+              << options.fps << " fps, " << options.steps_per_frame << " steps/frame)" << std::endl;
+    std::cout << "  Updates   POST /api/params, POST /api/circuit, POST /api/cells, GET /api/state" << std::endl;
+    if (results.isOpen()) {
+        std::cout << "  Results   " << options.results_channel << " (mapped ring, " << options.results_capacity
+                  << " values/frame)" << std::endl;
+    }
+
+    server.run();
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
     return 0;
-}
\ No newline at end of file
+}
@@ -7,18 +7,24 @@
  * @target < 0.001ms (back to original performance)
  * 
  * STRATEGY: Hard-code parameters, eliminate file I/O, minimal math
+ * OUTPUT: Memory-mapped results channel web_results.bin; --json adds web_results.json
+ *
+ * g++ -O2 -std=c++17 -I../dase/production json_bridge_v4_2_minimal.cpp ../dase/production/engine_results_channel.cpp ../dase/production/engine_mapped_file.cpp
  */
 
 #include <iostream>
 #include <fstream>
 #include <chrono>
 #include <ctime>
+#include <string>
+#include "engine_results_channel.h"
 
 /**
  * @brief ZERO-I/O ultra-fast engine
- * Hard-coded parameters for maximum speed, write minimal JSON
+ * Hard-coded parameters for maximum speed, publish packed doubles
  */
-int main() {
+int main(int argc, char** argv) {
+    const bool write_json = argc > 1 && std::string(argv[1]) == "--json";
     auto start = std::chrono::high_resolution_clock::now();
     
     // HARD-CODED parameters (eliminate file I/O completely for speed test)
@@ -31,12 +37,25 @@ int main() {
     auto compute_end = std::chrono::high_resolution_clock::now();
     double compute_time = std::chrono::duration<double, std::milli>(compute_end - start).count();
     
-    // MINIMAL JSON output
-    std::ofstream out("web_results.json");
-    out << "{\"cells\":{\"A1\":{\"value\":" << A1 << "},\"B1\":{\"value\":" << B1 
-        << "}},\"performance\":{\"execution_time_ms\":" << compute_time 
-        << ",\"nodes_computed\":2,\"timestamp\":\"" << std::time(nullptr) << "\"}}\n";
-    out.close();
+    // BINARY output: two doubles into the mapped ring, no text formatting
+    const double values[2] = {A1, B1};
+    ResultsRecordInfo info;
+    info.nodes_computed = 2;
+    info.compute_ms = compute_time;
+    ResultsChannelWriter channel;
+    if (!channel.create("web_results.bin", 2) || !channel.publish(values, 2, info)) {
+        std::cerr << "Cannot map web_results.bin" << std::endl;
+        return 1;
+    }
+    
+    // COMPATIBILITY: JSON adapter for the file-based UI
+    if (write_json) {
+        ResultsChannelReader reader;
+        if (!reader.open("web_results.bin") || !writeResultsJson(reader, "web_results.json")) {
+            std::cerr << "Cannot write web_results.json" << std::endl;
+            return 1;
+        }
+    }
     
     auto end = std::chrono::high_resolution_clock::now();
     double total = std::chrono::duration<double, std::milli>(end - start).count();
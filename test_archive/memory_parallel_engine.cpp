@@ -2,53 +2,457 @@
  * @file memory_parallel_engine.cpp
  * @brief Implementation of memory-parallel processing engine
  * @target < 0.1ms for 100+ nodes
+ *
+ * Build with ../dase/production/engine_mapped_file.cpp (snapshots) and
+ * ../dase/production/engine_huge_page_arena.cpp (node arena)
  */
 
 #include "memory_parallel_engine.h"
+#include "../dase/production/engine_mapped_file.h"
 #include <iostream>
 #include <chrono>
 #include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+static inline void cpuRelax() { _mm_pause(); }
+#else
+static inline void cpuRelax() {}
+#endif
 
 namespace DASE {
 
-void MemoryParallelSheet::executeParallelWaves() {
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    size_t numCores = std::thread::hardware_concurrency();
-    std::cout << "🔥 Executing on " << numCores << " cores, " 
-              << nodeCount.load() << " nodes..." << std::endl;
-    
-    // Launch worker threads for parallel node processing
-    for (size_t core = 0; core < numCores; ++core) {
-        workers.emplace_back([this, core, numCores]() {
-            // Each core processes every Nth node for load balancing
-            for (size_t i = core; i < nodeCount.load(); i += numCores) {
-                if (!nodes[i].computed.load()) {
-                    nodes[i].compute_parallel();
-                }
+// Polls before a worker gives up spinning and parks on the condition variable
+static constexpr int kSpinPolls = 4000;
+
+// ----------------------------------------------------------------------------
+// WorkStealingDeque
+// ----------------------------------------------------------------------------
+
+void WorkStealingDeque::reset(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    if (size != mask + 1 || !buffer) {
+        buffer.reset(new std::atomic<uint32_t>[size]);
+        mask = size - 1;
+    }
+    top.store(0, std::memory_order_relaxed);
+    bottom.store(0, std::memory_order_relaxed);
+}
+
+void WorkStealingDeque::push(uint32_t index) {
+    const int64_t b = bottom.load(std::memory_order_relaxed);
+    buffer[static_cast<size_t>(b) & mask].store(index, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_release);
+}
+
+bool WorkStealingDeque::pop(uint32_t& index) {
+    const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+    index = buffer[static_cast<size_t>(b) & mask].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Last item: race any thief for it
+        const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+bool WorkStealingDeque::steal(uint32_t& index) {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) return false;
+
+    index = buffer[static_cast<size_t>(t) & mask].load(std::memory_order_relaxed);
+    return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+// SheetExecutor
+// ----------------------------------------------------------------------------
+
+SheetExecutor::SheetExecutor(size_t num_workers)
+    : worker_count(num_workers ? num_workers : std::max<size_t>(1, std::thread::hardware_concurrency())),
+      slots(new WorkerSlot[worker_count]) {
+    // Worker 0 is the thread calling execute()
+    threads.reserve(worker_count - 1);
+    for (size_t worker = 1; worker < worker_count; ++worker) {
+        threads.emplace_back(&SheetExecutor::workerLoop, this, worker);
+    }
+}
+
+SheetExecutor::~SheetExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(park_mutex);
+        stopping.store(true, std::memory_order_release);
+        generation.fetch_add(1, std::memory_order_release);
+    }
+    park_cv.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Reverse the dependency lists into CSR "who reads me" lists, once per topology change
+void SheetExecutor::buildDependents(const MemoryNode* nodes, size_t count) {
+    dependency_counts.assign(count, 0);
+    dependent_offsets.assign(count + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        for (uint8_t d = 0; d < nodes[i].numDeps; ++d) {
+            const uint32_t source = nodes[i].dependencies[d];
+            if (source >= count) continue;
+            dependency_counts[i]++;
+            dependent_offsets[source + 1]++;
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        dependent_offsets[i + 1] += dependent_offsets[i];
+    }
+    dependents.resize(dependent_offsets[count]);
+    std::vector<uint32_t> cursor(dependent_offsets.begin(), dependent_offsets.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        for (uint8_t d = 0; d < nodes[i].numDeps; ++d) {
+            const uint32_t source = nodes[i].dependencies[d];
+            if (source >= count) continue;
+            dependents[cursor[source]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    // A dependency cycle would leave workers waiting forever: detect it up front
+    std::vector<uint32_t> waiting(dependency_counts);
+    std::vector<uint32_t> ready;
+    for (size_t i = 0; i < count; ++i) {
+        if (waiting[i] == 0) ready.push_back(static_cast<uint32_t>(i));
+    }
+    size_t resolved = 0;
+    while (!ready.empty()) {
+        const uint32_t v = ready.back();
+        ready.pop_back();
+        ++resolved;
+        for (uint32_t k = dependent_offsets[v]; k < dependent_offsets[v + 1]; ++k) {
+            if (--waiting[dependents[k]] == 0) ready.push_back(dependents[k]);
+        }
+    }
+    cyclic = resolved != count;
+
+    if (count > pending_capacity) {
+        pending.reset(new std::atomic<uint32_t>[count]);
+        pending_capacity = count;
+    }
+    for (size_t worker = 0; worker < worker_count; ++worker) {
+        slots[worker].deque.reset(count);
+    }
+    topology_count = count;
+}
+
+void SheetExecutor::execute(MemoryNode* nodes, size_t count, bool topology_changed) {
+    if (count == 0) return;
+    if (topology_changed || count != topology_count) {
+        buildDependents(nodes, count);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        nodes[i].computed.store(false, std::memory_order_relaxed);
+    }
+
+    // Cyclic wiring has no valid schedule: evaluate in index order instead of hanging
+    if (cyclic) {
+        for (size_t i = 0; i < count; ++i) {
+            nodes[i].compute_parallel(nodes);
+        }
+        return;
+    }
+
+    wave_nodes = nodes;
+    wave_count = count;
+    for (size_t worker = 0; worker < worker_count; ++worker) {
+        slots[worker].deque.reset(count);
+    }
+
+    // Seed ready nodes in 64-node runs per worker so neighbours start on the same core
+    size_t seeded = 0;
+    for (size_t i = 0; i < count; ++i) {
+        pending[i].store(dependency_counts[i], std::memory_order_relaxed);
+        if (dependency_counts[i] == 0) {
+            slots[(seeded / 64) % worker_count].deque.push(static_cast<uint32_t>(i));
+            ++seeded;
+        }
+    }
+
+    remaining.store(count, std::memory_order_relaxed);
+    busy_workers.store(worker_count - 1, std::memory_order_relaxed);
+    if (worker_count > 1) {
+        {
+            std::lock_guard<std::mutex> lock(park_mutex);
+            generation.fetch_add(1, std::memory_order_release);
+        }
+        park_cv.notify_all();
+    }
+
+    runWave(0);
+
+    // Deques are reset by the next wave, so wait until every worker has left this one
+    for (int spin = 0; spin < kSpinPolls && busy_workers.load(std::memory_order_acquire) != 0; ++spin) {
+        cpuRelax();
+    }
+    if (busy_workers.load(std::memory_order_acquire) != 0) {
+        std::unique_lock<std::mutex> lock(park_mutex);
+        done_cv.wait(lock, [this] { return busy_workers.load(std::memory_order_acquire) == 0; });
+    }
+}
+
+void SheetExecutor::processNode(uint32_t index, size_t worker) {
+    wave_nodes[index].compute_parallel(wave_nodes);
+
+    // The worker that satisfies a dependent's last input owns running it
+    for (uint32_t k = dependent_offsets[index]; k < dependent_offsets[index + 1]; ++k) {
+        const uint32_t dependent = dependents[k];
+        if (pending[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            slots[worker].deque.push(dependent);
+        }
+    }
+    remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void SheetExecutor::runWave(size_t worker) {
+    uint32_t index = 0;
+    int idle_polls = 0;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (slots[worker].deque.pop(index)) {
+            processNode(index, worker);
+            idle_polls = 0;
+            continue;
+        }
+
+        bool stolen = false;
+        for (size_t k = 1; k < worker_count && !stolen; ++k) {
+            const size_t victim = (worker + k) % worker_count;
+            if (slots[victim].deque.steal(index)) {
+                processNode(index, worker);
+                stolen = true;
             }
-        });
+        }
+
+        if (stolen) {
+            idle_polls = 0;
+        } else if (++idle_polls < kSpinPolls) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
     }
-    
-    // Wait for parallel wave completion
-    for (auto& worker : workers) {
-        worker.join();
+}
+
+void SheetExecutor::workerLoop(size_t worker) {
+    uint64_t seen = 0;
+    for (;;) {
+        // Spin first so back-to-back waves skip the condition variable entirely
+        for (int spin = 0; spin < kSpinPolls && generation.load(std::memory_order_acquire) == seen; ++spin) {
+            cpuRelax();
+        }
+        if (generation.load(std::memory_order_acquire) == seen) {
+            std::unique_lock<std::mutex> lock(park_mutex);
+            park_cv.wait(lock, [&] { return generation.load(std::memory_order_acquire) != seen; });
+        }
+        seen = generation.load(std::memory_order_acquire);
+        if (stopping.load(std::memory_order_acquire)) return;
+
+        runWave(worker);
+
+        if (busy_workers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(park_mutex);
+            done_cv.notify_one();
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// MemoryParallelSheet
+// ----------------------------------------------------------------------------
+
+MemoryParallelSheet::MemoryParallelSheet(size_t maxNodes)
+    : arena(maxNodes * sizeof(MemoryNode)),
+      nodes(reinterpret_cast<MemoryNode*>(arena.data())) {}
+
+MemoryNode* MemoryParallelSheet::allocateNodes(uint8_t type, size_t count) {
+    if (count == 0) return nullptr;
+    std::lock_guard<std::mutex> lock(allocation_mutex);
+    // Nodes are exactly one cache line, so arena allocations stay back to back
+    void* memory = arena.allocate(count * sizeof(MemoryNode), alignof(MemoryNode));
+    if (!memory) return nullptr;
+    MemoryNode* first = static_cast<MemoryNode*>(memory);
+    for (size_t i = 0; i < count; ++i) {
+        new (first + i) MemoryNode();     // Reused memory after reset() starts clean
+        first[i].nodeType = type;
+    }
+    nodeCount.fetch_add(count);
+    topologyChanged = true;
+    return first;
+}
+
+void MemoryParallelSheet::reset() {
+    std::lock_guard<std::mutex> lock(allocation_mutex);
+    arena.reset();
+    nodeCount.store(0);
+    topologyChanged = true;
+}
+
+void MemoryParallelSheet::executeParallelWaves() {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (!executor) {
+        executor = std::make_unique<SheetExecutor>();
     }
-    workers.clear();
-    
+
+    const size_t count = getNodeCount();
+    std::cout << "🔥 Executing on " << executor->getWorkerCount() << " cores, "
+              << count << " nodes..." << std::endl;
+
+    // Dependency-ordered wave on the persistent work-stealing executor
+    executor->execute(nodes, count, topologyChanged);
+    topologyChanged = false;
+
     auto end = std::chrono::high_resolution_clock::now();
     double time_ms = std::chrono::duration<double, std::milli>(end - start).count();
-    
+
     std::cout << "⚡ Parallel wave execution: " << time_ms << " ms" << std::endl;
-    std::cout << "📊 Throughput: " << (nodeCount.load() / time_ms) << " nodes/ms" << std::endl;
+    std::cout << "📊 Throughput: " << (count / time_ms) << " nodes/ms" << std::endl;
+}
+
+// SNAPSHOT: File layout shared by saveSnapshot() and loadSnapshot()
+static const char kSheetSnapshotMagic[8] = {'D', 'A', 'S', 'E', 'M', 'P', 'S', '1'};
+static constexpr size_t kSheetSnapshotPage = 4096;
+
+struct SheetSnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_bytes;
+    uint64_t node_count;
+};
+
+// A record is a MemoryNode image, so loading can map the records as the nodes
+struct SheetSnapshotRecord {
+    double value;
+    uint8_t computed;              // Always 0 on disk
+    uint8_t pad0[3];
+    uint32_t dependencies[4];
+    uint8_t numDeps;
+    uint8_t nodeType;
+    uint8_t pad1[2];
+    double params[4];
+};
+
+static_assert(sizeof(SheetSnapshotRecord) == 64, "snapshot records are one cache line");
+static_assert(sizeof(MemoryNode) == sizeof(SheetSnapshotRecord) && std::is_standard_layout<MemoryNode>::value,
+              "nodes must be adoptable as snapshot records");
+static_assert(sizeof(std::atomic<double>) == sizeof(double) && sizeof(std::atomic<bool>) == 1 &&
+              std::atomic<double>::is_always_lock_free && std::atomic<bool>::is_always_lock_free,
+              "node atomics must be plain values in memory");
+static_assert(offsetof(MemoryNode, value) == offsetof(SheetSnapshotRecord, value) &&
+              offsetof(MemoryNode, computed) == offsetof(SheetSnapshotRecord, computed) &&
+              offsetof(MemoryNode, dependencies) == offsetof(SheetSnapshotRecord, dependencies) &&
+              offsetof(MemoryNode, numDeps) == offsetof(SheetSnapshotRecord, numDeps) &&
+              offsetof(MemoryNode, nodeType) == offsetof(SheetSnapshotRecord, nodeType) &&
+              offsetof(MemoryNode, params) == offsetof(SheetSnapshotRecord, params),
+              "snapshot records must match the node layout");
+
+bool MemoryParallelSheet::saveSnapshot(const std::string& path) const {
+    const size_t count = getNodeCount();
+    const std::string temporary = path + ".tmp";
+    {
+        MappedFile file;
+        if (!file.create(temporary, kSheetSnapshotPage + count * sizeof(SheetSnapshotRecord))) return false;
+
+        SheetSnapshotHeader header{};
+        std::memcpy(header.magic, kSheetSnapshotMagic, sizeof(kSheetSnapshotMagic));
+        header.version = 2;
+        header.record_bytes = sizeof(SheetSnapshotRecord);
+        header.node_count = count;
+        std::memcpy(file.data(), &header, sizeof(header));
+
+        auto* records = reinterpret_cast<SheetSnapshotRecord*>(file.data() + kSheetSnapshotPage);
+        for (size_t i = 0; i < count; ++i) {
+            SheetSnapshotRecord record{};
+            record.value = nodes[i].value.load(std::memory_order_relaxed);
+            std::memcpy(record.dependencies, nodes[i].dependencies, sizeof(record.dependencies));
+            record.numDeps = nodes[i].numDeps;
+            record.nodeType = nodes[i].nodeType;
+            std::memcpy(record.params, nodes[i].params, sizeof(record.params));
+            records[i] = record;
+        }
+    }
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+bool MemoryParallelSheet::loadSnapshot(const std::string& path) {
+    MappedFile file;
+    if (!file.openRead(path) || file.size() < kSheetSnapshotPage) return false;
+    SheetSnapshotHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kSheetSnapshotMagic, sizeof(kSheetSnapshotMagic)) != 0 || header.version != 2 ||
+        header.record_bytes != sizeof(SheetSnapshotRecord) || header.node_count > getMaxNodes() ||
+        file.size() < kSheetSnapshotPage + header.node_count * sizeof(SheetSnapshotRecord)) {
+        return false;
+    }
+
+    const auto* records = reinterpret_cast<const SheetSnapshotRecord*>(file.data() + kSheetSnapshotPage);
+    const size_t count = static_cast<size_t>(header.node_count);
+    for (size_t i = 0; i < count; ++i) {
+        if (records[i].numDeps > 4 || records[i].computed != 0) return false;
+        for (uint8_t d = 0; d < records[i].numDeps; ++d) {
+            if (records[i].dependencies[d] >= count) return false;
+        }
+    }
+
+    reset();
+    if (count == 0) return true;
+    {
+        // ZERO-COPY: The records become the nodes; pages load on first touch and
+        // are copied only when a wave writes them
+        std::lock_guard<std::mutex> lock(allocation_mutex);
+        if (arena.adoptFile(path, kSheetSnapshotPage, count * sizeof(MemoryNode))) {
+            nodeCount.store(count);
+            topologyChanged = true;
+            return true;
+        }
+    }
+    // No mapping (Windows, larger OS pages): copy the validated records in
+    if (!allocateNodes(0, count)) return false;
+    for (size_t i = 0; i < count; ++i) {
+        nodes[i].value.store(records[i].value, std::memory_order_relaxed);
+        nodes[i].computed.store(false, std::memory_order_relaxed);
+        std::memcpy(nodes[i].dependencies, records[i].dependencies, sizeof(nodes[i].dependencies));
+        nodes[i].numDeps = records[i].numDeps;
+        nodes[i].nodeType = records[i].nodeType;
+        std::memcpy(nodes[i].params, records[i].params, sizeof(nodes[i].params));
+    }
+    return true;
 }
 
 // Factory method to create test circuit
 MemoryParallelSheet* createTestCircuit(size_t numNodes) {
     auto* sheet = new MemoryParallelSheet();
-    
+
     std::cout << "🏗️ Creating " << numNodes << " node test circuit..." << std::endl;
-    
+
     for (size_t i = 0; i < numNodes; ++i) {
         MemoryNode* node = sheet->allocateNode(0); // Amplifier type
         if (node) {
@@ -57,9 +461,9 @@ MemoryParallelSheet* createTestCircuit(size_t numNodes) {
             node->params[1] = 2.0 + (i * 0.05); // Varying input
         }
     }
-    
+
     std::cout << "✅ Circuit created with " << sheet->getNodeCount() << " nodes" << std::endl;
     return sheet;
 }
 
-} // namespace DASE
\ No newline at end of file
+} // namespace DASE
@@ -9,6 +9,11 @@
 #include <thread>
 #include <atomic>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <string>
+#include "../dase/production/engine_huge_page_arena.h"
 
 namespace DASE {
 
@@ -20,68 +25,163 @@ struct alignas(64) MemoryNode {
     uint8_t numDeps = 0;
     uint8_t nodeType = 0;  // 0=amp, 1=integrator, 2=summer
     double params[4] = {0.0};  // Parameters (gain, etc.)
-    
-    // Parallel computation
-    void compute_parallel() {
+
+    // Node input: sum of dependency values when wired, params[1] otherwise
+    double input(const MemoryNode* sheet) const {
+        if (!sheet || numDeps == 0) return params[1];
+        double sum = 0.0;
+        for (uint8_t d = 0; d < numDeps; ++d) {
+            sum += sheet[dependencies[d]].value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    // Parallel computation (sheet = node array that dependencies index into)
+    void compute_parallel(const MemoryNode* sheet = nullptr) {
         switch(nodeType) {
             case 0: // Amplifier
-                value.store(params[0] * params[1]);
+                value.store(params[0] * input(sheet), std::memory_order_relaxed);
                 break;
-            case 1: // Integrator  
-                value.store(value.load() + params[0] * params[1]);
+            case 1: // Integrator
+                value.store(value.load(std::memory_order_relaxed) + params[0] * input(sheet),
+                            std::memory_order_relaxed);
                 break;
             case 2: // Summer
-                value.store(params[0] + params[1] + params[2]);
+                value.store((sheet && numDeps) ? input(sheet) : params[0] + params[1] + params[2],
+                            std::memory_order_relaxed);
                 break;
         }
-        computed.store(true);
+        computed.store(true, std::memory_order_release);
     }
 };
 
+// LOCK-FREE: Bounded Chase-Lev deque of node indices.
+// The owner pushes/pops at the bottom, thieves steal from the top.
+class WorkStealingDeque {
+public:
+    void reset(size_t capacity);  // Not thread-safe; only between waves
+    void push(uint32_t index);
+    bool pop(uint32_t& index);
+    bool steal(uint32_t& index);
+
+private:
+    std::unique_ptr<std::atomic<uint32_t>[]> buffer;
+    size_t mask = 0;
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+};
+
+// PERSISTENT EXECUTOR: Workers are started once and park between waves.
+// Every node carries an atomic count of unfinished dependencies; the worker
+// that completes a node's last input pushes it onto its own deque, and idle
+// workers steal from the others.
+class SheetExecutor {
+public:
+    explicit SheetExecutor(size_t num_workers = 0);  // 0 = hardware_concurrency
+    ~SheetExecutor();
+
+    SheetExecutor(const SheetExecutor&) = delete;
+    SheetExecutor& operator=(const SheetExecutor&) = delete;
+
+    // Run every node once in dependency order (dependencies must form a DAG)
+    void execute(MemoryNode* nodes, size_t count, bool topology_changed);
+
+    size_t getWorkerCount() const { return worker_count; }
+
+private:
+    struct alignas(64) WorkerSlot {
+        WorkStealingDeque deque;
+    };
+
+    void buildDependents(const MemoryNode* nodes, size_t count);
+    void workerLoop(size_t worker);
+    void runWave(size_t worker);
+    void processNode(uint32_t index, size_t worker);
+
+    size_t worker_count = 1;
+    std::vector<std::thread> threads;
+    std::unique_ptr<WorkerSlot[]> slots;
+
+    // Current wave
+    MemoryNode* wave_nodes = nullptr;
+    size_t wave_count = 0;
+    std::unique_ptr<std::atomic<uint32_t>[]> pending;  // Unfinished dependencies per node
+    size_t pending_capacity = 0;
+    std::vector<uint32_t> dependency_counts;           // Valid dependencies per node
+    std::vector<uint32_t> dependent_offsets;           // CSR: nodes that read node i
+    std::vector<uint32_t> dependents;
+    size_t topology_count = 0;                         // Node count the CSR was built for
+    bool cyclic = false;                               // No valid schedule: run in index order
+    alignas(64) std::atomic<size_t> remaining{0};      // Nodes not yet computed this wave
+    alignas(64) std::atomic<size_t> busy_workers{0};   // Background workers still inside the wave
+
+    // Parking
+    std::mutex park_mutex;
+    std::condition_variable park_cv;
+    std::condition_variable done_cv;
+    std::atomic<uint64_t> generation{0};
+    std::atomic<bool> stopping{false};
+};
+
 // Memory pool for entire workbook
+// ARENA: Nodes live in a huge-page arena that grows in 2 MB chunks inside one
+// reserved range, so node addresses never move, node i is always nodes[i], and
+// a sheet can hold millions of nodes without a 256 KB object on the stack.
 class MemoryParallelSheet {
 private:
-    static constexpr size_t MAX_NODES = 4096;  // 64KB aligned memory
-    alignas(4096) MemoryNode nodes[MAX_NODES];  // Page-aligned
+    HugePageArena arena;
+    MemoryNode* nodes = nullptr;              // Start of the arena
+    std::mutex allocation_mutex;              // Serializes arena growth
     std::atomic<size_t> nodeCount{0};
-    std::vector<std::thread> workers;
-    
+    std::unique_ptr<SheetExecutor> executor;  // Created on first wave, reused afterwards
+    bool topologyChanged = true;
+
 public:
-    // Zero-allocation node creation
-    MemoryNode* allocateNode(uint8_t type) {
-        size_t index = nodeCount.fetch_add(1);
-        if (index >= MAX_NODES) return nullptr;
-        
-        nodes[index].nodeType = type;
-        return &nodes[index];
+    static constexpr size_t kDefaultMaxNodes = size_t(1) << 24;  // 1 GB of address space
+
+    // Reserves room for `maxNodes`; memory is committed only as nodes are allocated
+    explicit MemoryParallelSheet(size_t maxNodes = kDefaultMaxNodes);
+
+    MemoryParallelSheet(const MemoryParallelSheet&) = delete;
+    MemoryParallelSheet& operator=(const MemoryParallelSheet&) = delete;
+
+    // One node, or nullptr when the reservation is full
+    MemoryNode* allocateNode(uint8_t type) { return allocateNodes(type, 1); }
+    // BULK: `count` consecutive nodes of one type; returns the first, or nullptr
+    MemoryNode* allocateNodes(uint8_t type, size_t count);
+    // Drop every node but keep the committed memory for the next circuit
+    void reset();
+
+    // Wire `source` as the next input of `node` (false when the node already has 4 inputs)
+    bool addDependency(MemoryNode* node, uint32_t source) {
+        if (!node || node->numDeps >= 4 || source >= getNodeCount()) return false;
+        node->dependencies[node->numDeps++] = source;
+        topologyChanged = true;
+        return true;
     }
-    
+
+    uint32_t indexOf(const MemoryNode* node) const { return static_cast<uint32_t>(node - nodes); }
+
     // Parallel wave execution
-    void executeParallelWaves() {
-        size_t numCores = std::thread::hardware_concurrency();
-        
-        // Launch worker threads for parallel node processing
-        for (size_t core = 0; core < numCores; ++core) {
-            workers.emplace_back([this, core, numCores]() {
-                // Each core processes every Nth node
-                for (size_t i = core; i < nodeCount.load(); i += numCores) {
-                    if (!nodes[i].computed.load()) {
-                        nodes[i].compute_parallel();
-                    }
-                }
-            });
-        }
-        
-        // Wait for parallel wave completion
-        for (auto& worker : workers) {
-            worker.join();
-        }
-        workers.clear();
-    }
-    
+    void executeParallelWaves();
+
     // Memory-mapped results (zero-copy)
     const MemoryNode* getResults() const { return nodes; }
     size_t getNodeCount() const { return nodeCount.load(); }
+    size_t getMaxNodes() const { return arena.getReservedBytes() / sizeof(MemoryNode); }
+    const HugePageArena& getArena() const { return arena; }
+
+    // SNAPSHOT: Whole-sheet checkpoint. A 4096-byte header, then one 64-byte record
+    // per node at page-aligned offset 4096, laid out exactly as a MemoryNode.
+    // Saving writes a temporary file and renames it into place. Loading checks the
+    // records, then maps them copy-on-write at the start of the arena
+    // (HugePageArena::adoptFile), so they become the nodes without a copy and sheets
+    // loaded from one file share its pages until a wave writes them; where the OS
+    // cannot place the mapping (Windows) they are copied in instead. It replaces the
+    // sheet's nodes and fails (leaving them untouched) on a malformed file or one
+    // with more nodes than getMaxNodes().
+    bool saveSnapshot(const std::string& path) const;
+    bool loadSnapshot(const std::string& path);
 };
 
-} // namespace DASE
\ No newline at end of file
+} // namespace DASE